@@ -0,0 +1,103 @@
+#include "Benchmark.h"
+
+#include <LinearAnimation.h>
+#include <TimelineAnimation.h>
+
+namespace HydraBenchmarks
+{
+    static const float Speed = 1920.f * 4.f;
+    static const float Distance = 1920.f * 3.f;
+    static const float FrameTime = 1.f / 60.f;
+    static const uint64_t FrameTimeNs = 16'666'667;
+
+    static void RunLinearAnimationBenchmarks(BenchmarkRunner& runner)
+    {
+        HydraCore::LinearAnimation animation;
+        animation.SetVelocity(Speed);
+        float total = 0.f;
+
+        runner.Run("Animation/Linear/Update", 10'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                if (!animation.IsAnimating())
+                {
+                    animation.SetTargetPosition(animation.GetCurrentPosition() == 0.f ? Distance : 0.f);
+                }
+
+                animation.Update(FrameTime);
+                total += animation.GetCurrentPosition();
+            }
+        });
+
+        DoNotOptimize(total);
+    }
+
+    static void RunTimelineAnimationBenchmarks(BenchmarkRunner& runner)
+    {
+        HydraCore::TimelineAnimation animation;
+        animation.SetVelocity(Speed);
+        float total = 0.f;
+        uint64_t time = 0;
+
+        runner.Run("Animation/Timeline/UpdateToTime", 10'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                if (!animation.IsAnimating())
+                {
+                    animation.SetTargetPosition(animation.GetCurrentPosition() == 0.f ? Distance : 0.f, time);
+                }
+
+                time += FrameTimeNs;
+                animation.UpdateToTime(time);
+                total += animation.GetCurrentPosition();
+            }
+        });
+
+        // Retarget every few frames so that every evaluation is blending out of an in-progress transition
+        runner.Run("Animation/Timeline/RetargetUpdateToTime", 10'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                if ((i & 7) == 0)
+                {
+                    animation.SetTargetPosition((i & 8) == 0 ? Distance : 0.f, time);
+                }
+
+                time += FrameTimeNs;
+                animation.UpdateToTime(time);
+                total += animation.GetCurrentPosition();
+            }
+        });
+
+        // Keep the queue full, the cost of an update must not depend on how many transitions are queued
+        runner.Run("Animation/Timeline/QueuedUpdateToTime", 10'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                animation.QueueTargetPosition((i & 1) == 0 ? Distance : 0.f);
+                time += FrameTimeNs;
+                animation.UpdateToTime(time);
+                total += animation.GetCurrentPosition();
+            }
+        });
+
+        // Retargeting after the end of a full queue has to make room without disturbing the transition which is running
+        float position = animation.GetCurrentPosition();
+        animation.SetTargetPosition(Distance * 2.f, time + 3'600'000'000'000);
+        animation.UpdateToTime(time);
+        if (animation.GetCurrentPosition() != position)
+        {
+            runner.Fail("Animation/Timeline/QueuedUpdateToTime", "Retargeting a full queue moved the running transition");
+        }
+
+        DoNotOptimize(total);
+    }
+
+    void RunAnimationBenchmarks(BenchmarkRunner& runner)
+    {
+        RunLinearAnimationBenchmarks(runner);
+        RunTimelineAnimationBenchmarks(runner);
+    }
+}
@@ -0,0 +1,61 @@
+#include "Benchmark.h"
+
+#include <stdio.h>
+
+namespace HydraBenchmarks
+{
+    BenchmarkRunner::BenchmarkRunner()
+    {
+        iterationScale = 1.0;
+    }
+
+    void BenchmarkRunner::AddResult(const std::string& name, uint64_t iterations, double nanosecondsPerIteration)
+    {
+        results.push_back({ name, iterations, nanosecondsPerIteration });
+        printf("%-56s %12.2f ns/op (%llu iterations)\n", name.c_str(), nanosecondsPerIteration, (unsigned long long)iterations);
+        fflush(stdout);
+    }
+
+    void BenchmarkRunner::Fail(const std::string& name, const std::string& message)
+    {
+        failures.push_back(name + ": " + message);
+        printf("%-56s FAILED: %s\n", name.c_str(), message.c_str());
+        fflush(stdout);
+    }
+
+    static void WriteJsonString(FILE* file, const std::string& value)
+    {
+        fputc('"', file);
+        for (char c : value)
+        {
+            if (c == '"' || c == '\\')
+            {
+                fputc('\\', file);
+            }
+            fputc(c, file);
+        }
+        fputc('"', file);
+    }
+
+    bool BenchmarkRunner::WriteJson(const char* filePath)
+    {
+        FILE* file = fopen(filePath, "w");
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        // One benchmark per line keeps diffs between runs readable
+        fprintf(file, "{\n  \"benchmarks\": [\n");
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const BenchmarkResult& result = results[i];
+            fprintf(file, "    { \"name\": ");
+            WriteJsonString(file, result.Name);
+            fprintf(file, ", \"iterations\": %llu, \"ns_per_op\": %.3f }%s\n", (unsigned long long)result.Iterations, result.NanosecondsPerIteration, i + 1 < results.size() ? "," : "");
+        }
+        fprintf(file, "  ]\n}\n");
+
+        return fclose(file) == 0;
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <chrono>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace HydraBenchmarks
+{
+    struct BenchmarkResult
+    {
+        std::string Name;
+        uint64_t Iterations;
+        double NanosecondsPerIteration;
+    };
+
+    // Prevents the compiler from optimizing away a value computed by a benchmark
+    template<class T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile char sink;
+        sink = *(const volatile char*)&value;
+#endif
+    }
+
+    class BenchmarkRunner
+    {
+    private:
+        static const int Repetitions = 5;
+
+        std::vector<BenchmarkResult> results;
+        std::vector<std::string> failures;
+        std::string filter;
+        double iterationScale;
+
+        void AddResult(const std::string& name, uint64_t iterations, double nanosecondsPerIteration);
+    public:
+        BenchmarkRunner();
+
+        // Only benchmarks with names containing the filter will be run
+        inline void SetFilter(const std::string& filter)
+        {
+            this->filter = filter;
+        }
+
+        // Scales the iteration count of every benchmark, useful for quick smoke runs
+        inline void SetIterationScale(double iterationScale)
+        {
+            this->iterationScale = iterationScale;
+        }
+
+        // Runs a benchmark body which performs the given number of iterations of the operation being measured.
+        // The body is repeated a few times and the fastest repetition is reported to filter out scheduling noise.
+        template<class TBody>
+        void Run(const std::string& name, uint64_t iterations, TBody body)
+        {
+            if (!filter.empty() && name.find(filter) == std::string::npos)
+            {
+                return;
+            }
+
+            iterations = (uint64_t)((double)iterations * iterationScale);
+            if (iterations == 0)
+            {
+                iterations = 1;
+            }
+
+            // Warm up caches and let the CPU clock up before measuring
+            body(iterations / 10 + 1);
+
+            double best = 0.0;
+            for (int i = 0; i < Repetitions; i++)
+            {
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                body(iterations);
+                std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+                double nanosecondsPerIteration = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / (double)iterations;
+                if (i == 0 || nanosecondsPerIteration < best)
+                {
+                    best = nanosecondsPerIteration;
+                }
+            }
+
+            AddResult(name, iterations, best);
+        }
+
+        inline const std::vector<BenchmarkResult>& GetResults()
+        {
+            return results;
+        }
+
+        // Records that a benchmark observed incorrect behavior (IE: a torn read), which makes the run fail once every benchmark has finished
+        void Fail(const std::string& name, const std::string& message);
+
+        inline const std::vector<std::string>& GetFailures()
+        {
+            return failures;
+        }
+
+        // Writes the results as JSON so they can be compared between commits, returns false if the file couldn't be written
+        bool WriteJson(const char* filePath);
+    };
+
+    void RunAnimationBenchmarks(BenchmarkRunner& runner);
+    void RunEventBenchmarks(BenchmarkRunner& runner);
+    void RunMonitorBenchmarks(BenchmarkRunner& runner);
+    void RunDeferredEventBenchmarks(BenchmarkRunner& runner);
+    void RunDisplayPlatformBenchmarks(BenchmarkRunner& runner);
+    void RunI3IpcBenchmarks(BenchmarkRunner& runner);
+    void RunSoftwareCompositorBenchmarks(BenchmarkRunner& runner);
+    void RunTrackerFeedBenchmarks(BenchmarkRunner& runner);
+}
@@ -0,0 +1,108 @@
+#include "Benchmark.h"
+
+#include <atomic>
+#include <chrono>
+#include <DeferredEvent.h>
+#include <thread>
+#include <vector>
+
+namespace HydraBenchmarks
+{
+    struct MonitorChange
+    {
+        void* Monitor;
+        uint64_t Timestamp;
+    };
+
+    typedef HydraCore::DeferredEvent<int, MonitorChange> MonitorChangeQueue;
+
+    static void RunSingleThreadedBenchmarks(BenchmarkRunner& runner)
+    {
+        MonitorChangeQueue queue;
+        uint64_t total = 0;
+
+        runner.Run("DeferredEvent/Dispatch/1Key", 10'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                queue.Dispatch(0, { nullptr, i });
+            }
+        });
+
+        runner.Run("DeferredEvent/Dispatch/4Keys", 10'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                queue.Dispatch((int)(i & 3), { nullptr, i });
+            }
+        });
+
+        runner.Run("DeferredEvent/DispatchDrain/1Key", 10'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                queue.Dispatch(0, { nullptr, i });
+                queue.Drain([&](int key, const MonitorChange& change, uint32_t mergedCount) { total += change.Timestamp + mergedCount; });
+            }
+        });
+
+        runner.Run("DeferredEvent/Drain/Empty", 10'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                queue.Drain([&](int key, const MonitorChange& change, uint32_t mergedCount) { total += change.Timestamp + mergedCount; });
+            }
+        });
+
+        DoNotOptimize(total);
+    }
+
+    // Measures dispatch cost from several producers while the consumer only drains once every few milliseconds and takes its time doing so.
+    static void RunSlowConsumerBenchmark(BenchmarkRunner& runner, int producerCount)
+    {
+        MonitorChangeQueue queue;
+
+        runner.Run("DeferredEvent/Dispatch/SlowConsumer/" + std::to_string(producerCount) + "Producers", 4'000'000, [&](uint64_t iterations)
+        {
+            std::atomic<bool> stop(false);
+            std::thread consumer([&]()
+            {
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    queue.Drain([](int key, const MonitorChange& change, uint32_t mergedCount)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    });
+                    std::this_thread::sleep_for(std::chrono::milliseconds(4));
+                }
+            });
+
+            std::vector<std::thread> producers;
+            for (int i = 0; i < producerCount; i++)
+            {
+                producers.emplace_back([&, i]()
+                {
+                    for (uint64_t j = 0; j < iterations / producerCount; j++)
+                    {
+                        queue.Dispatch(i & 1, { nullptr, j });
+                    }
+                });
+            }
+
+            for (std::thread& producer : producers)
+            {
+                producer.join();
+            }
+
+            stop.store(true, std::memory_order_relaxed);
+            consumer.join();
+        });
+    }
+
+    void RunDeferredEventBenchmarks(BenchmarkRunner& runner)
+    {
+        RunSingleThreadedBenchmarks(runner);
+        RunSlowConsumerBenchmark(runner, 1);
+        RunSlowConsumerBenchmark(runner, 4);
+    }
+}
@@ -0,0 +1,243 @@
+#include "Benchmark.h"
+
+#include <ActiveMonitorTracker.h>
+#include <CursorMonitorTracker.h>
+#include <DeferredEvent.h>
+#include <SimulatedDisplayPlatform.h>
+#include <string>
+#include <vector>
+
+namespace HydraBenchmarks
+{
+    static const int MonitorCounts[] = { 2, 4, 8 };
+
+    static std::vector<HydraCore::MonitorHandle> ConnectMonitors(HydraCore::SimulatedDisplayPlatform& platform, int count)
+    {
+        std::vector<HydraCore::MonitorHandle> ret;
+        for (int i = 0; i < count; i++)
+        {
+            HydraCore::Rectangle rectangle = { i * 1920, 0, 1920, 1080 };
+            ret.push_back(platform.ConnectMonitor(rectangle, "SIMULATED-" + std::to_string(i), i == 0));
+        }
+
+        return ret;
+    }
+
+    typedef HydraCore::DeferredEvent<int, HydraCore::ActiveMonitorChange, 1> BenchmarkDeferredEvent;
+
+    // Returns the latest change queued since the last drain, the monitor is null if there wasn't one
+    static HydraCore::ActiveMonitorChange DrainLastChange(BenchmarkDeferredEvent& deferredEvent)
+    {
+        HydraCore::ActiveMonitorChange ret = {};
+        deferredEvent.Drain([&](int key, const HydraCore::ActiveMonitorChange& change, uint32_t mergedCount)
+        {
+            ret = change;
+        });
+
+        return ret;
+    }
+
+    // Drags the focused window from the first monitor onto the second a few pixels per millisecond
+    // Returns how long after its center crossed onto the second monitor the switch was reported, or UINT64_MAX if it never was.
+    static uint64_t MeasureDragSwitchDelay(HydraCore::SimulatedDisplayPlatform& platform, BenchmarkDeferredEvent& deferredEvent, HydraCore::SimulatedWindow window, HydraCore::MonitorHandle secondMonitor)
+    {
+        platform.FocusWindow(window);
+        platform.MoveWindow(window, { 0, 0, 1280, 720 });
+        DrainLastChange(deferredEvent);
+
+        platform.BeginWindowDrag(window);
+        uint64_t crossTime = 0;
+        uint64_t ret = UINT64_MAX;
+        for (int32_t x = 32; x <= 1920 && ret == UINT64_MAX; x += 32)
+        {
+            platform.AdvanceTime(1'000'000);
+            platform.MoveWindow(window, { x, 0, 1280, 720 });
+
+            if (crossTime == 0 && x + 640 >= 1920)
+            {
+                crossTime = platform.GetTimestamp();
+            }
+
+            HydraCore::ActiveMonitorChange change = DrainLastChange(deferredEvent);
+            if (change.Monitor == secondMonitor)
+            {
+                ret = change.Timestamp - crossTime;
+            }
+        }
+
+        platform.EndWindowDrag();
+        DrainLastChange(deferredEvent);
+        return ret;
+    }
+
+    void RunDisplayPlatformBenchmarks(BenchmarkRunner& runner)
+    {
+        for (int monitorCount : MonitorCounts)
+        {
+            HydraCore::SimulatedDisplayPlatform platform;
+            std::vector<HydraCore::MonitorHandle> monitors = ConnectMonitors(platform, monitorCount);
+            std::string suffix = "/" + std::to_string(monitorCount);
+
+            // One maximized window per monitor, every other one belongs to a program which the filter benchmark ignores
+            std::vector<HydraCore::SimulatedWindow> windows;
+            for (int i = 0; i < monitorCount; i++)
+            {
+                windows.push_back(platform.AddWindow({ i * 1920, 0, 1920, 1080 }, i % 2 == 0 ? "game.exe" : "obs64.exe", "Window"));
+            }
+
+            // This is the full path a focus change takes to reach ActiveMonitorSource: platform event, tracker, then the source's deferred event
+            HydraCore::ActiveMonitorTracker tracker(&platform);
+            BenchmarkDeferredEvent deferredEvent;
+            HydraCore::EventSubscriptionHandle subscription = tracker.SubscribeActiveMonitorChangedDeferred(&deferredEvent, 0);
+            uint64_t total = 0;
+
+            runner.Run("DisplayPlatform/FocusChange" + suffix, 1'000'000, [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    platform.AdvanceTime(1'000'000);
+                    platform.FocusWindow(windows[i % windows.size()]);
+                    deferredEvent.Drain([&](int key, const HydraCore::ActiveMonitorChange& change, uint32_t mergedCount)
+                    {
+                        total += change.Timestamp;
+                    });
+                }
+            });
+
+            // Focusing the last window has to reach the source as a change to the last monitor
+            platform.FocusWindow(windows[0]);
+            DrainLastChange(deferredEvent);
+            platform.FocusWindow(windows.back());
+            if (DrainLastChange(deferredEvent).Monitor != monitors.back() || tracker.GetActiveMonitorHandle() != monitors.back())
+            {
+                runner.Fail("DisplayPlatform/FocusChange" + suffix, "The tracker didn't end on the focused window's monitor");
+            }
+
+            // After the first pass every window is cached, so this measures the hash lookup rather than resolving windows
+            tracker.SetIgnoredWindows({ "OBS64.exe" }, {});
+            runner.Run("DisplayPlatform/FilteredFocusChange" + suffix, 1'000'000, [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    platform.AdvanceTime(1'000'000);
+                    platform.FocusWindow(windows[i % windows.size()]);
+                    deferredEvent.Drain([&](int key, const HydraCore::ActiveMonitorChange& change, uint32_t mergedCount)
+                    {
+                        total += change.Timestamp;
+                    });
+                }
+            });
+
+            // OBS's windows are on the odd monitors, focusing one has to leave the tracker where it was
+            platform.FocusWindow(windows[0]);
+            DrainLastChange(deferredEvent);
+            platform.FocusWindow(windows[1]);
+            if (DrainLastChange(deferredEvent).Monitor != nullptr || tracker.GetActiveMonitorHandle() != monitors[0] || tracker.GetFilterStatistics().IgnoredCount == 0)
+            {
+                runner.Fail("DisplayPlatform/FilteredFocusChange" + suffix, "An ignored window changed the active monitor");
+            }
+            tracker.SetIgnoredWindows({}, {});
+
+            // Dragging the focused window within its monitor is the common case, the tracker filters out the unchanged monitor
+            runner.Run("DisplayPlatform/FocusedWindowMove" + suffix, 1'000'000, [&](uint64_t iterations)
+            {
+                platform.FocusWindow(windows[0]);
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    platform.MoveWindow(windows[0], { (int32_t)(i % 256), 0, 1280, 720 });
+                }
+            });
+
+            // The window never left the first monitor
+            if (DrainLastChange(deferredEvent).Monitor != nullptr || tracker.GetActiveMonitorHandle() != monitors[0])
+            {
+                runner.Fail("DisplayPlatform/FocusedWindowMove" + suffix, "Moving the window within its monitor changed the active monitor");
+            }
+
+            // A drag sweeps the focused window across every monitor with a location change per millisecond (a typical mouse report rate)
+            // This is run at 20 Hz and then with every location change sampled, which is what live dragging would cost without the throttle.
+            const uint64_t dragLength = 1'000;
+            for (uint64_t interval : { 50'000'000ull, 1ull })
+            {
+                platform.SetLiveDragInterval(interval);
+                std::string name = "DisplayPlatform/LiveDrag" + std::string(interval == 1 ? "Unthrottled" : "") + suffix;
+                runner.Run(name, 1'000'000, [&](uint64_t iterations)
+                {
+                    platform.FocusWindow(windows[0]);
+                    for (uint64_t i = 0; i < iterations; i++)
+                    {
+                        uint64_t step = i % dragLength;
+                        if (step == 0)
+                        {
+                            platform.BeginWindowDrag(windows[0]);
+                        }
+
+                        platform.AdvanceTime(1'000'000);
+                        platform.MoveWindow(windows[0], { (int32_t)(step * monitorCount * 1920 / dragLength), 0, 1280, 720 });
+                        deferredEvent.Drain([&](int key, const HydraCore::ActiveMonitorChange& change, uint32_t mergedCount)
+                        {
+                            total += change.Timestamp;
+                        });
+
+                        if (step == dragLength - 1)
+                        {
+                            platform.EndWindowDrag();
+                        }
+                    }
+
+                    platform.EndWindowDrag();
+                });
+
+                // Unthrottled, the switch is seen by the move which crossed over. Throttled, it waits for the next sample, which is at most an interval away.
+                uint64_t delay = MeasureDragSwitchDelay(platform, deferredEvent, windows[0], monitors[1]);
+                bool isDelayExpected = interval == 1 ? delay == 0 : delay > 0 && delay <= interval;
+                if (!isDelayExpected)
+                {
+                    runner.Fail(name, delay == UINT64_MAX ? "The drag never switched monitors" : "The switch was reported " + std::to_string(delay / 1'000'000) + " ms after the window crossed over");
+                }
+            }
+            platform.SetLiveDragInterval(0);
+
+            tracker.UnsubscribeActiveMonitorChanged(subscription);
+
+            // Every sample moves the cursor onto the next monitor, so each one has to locate it
+            HydraCore::CursorMonitorTracker cursorTracker(&platform, 0, 0, false);
+            runner.Run("DisplayPlatform/CursorSample" + suffix, 1'000'000, [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    platform.SetCursorPosition((int32_t)((i % monitorCount) * 1920 + 960), 540);
+                    cursorTracker.Sample();
+                }
+            });
+
+            BenchmarkDeferredEvent cursorEvent;
+            HydraCore::EventSubscriptionHandle cursorSubscription = cursorTracker.SubscribeCursorMonitorChangedDeferred(&cursorEvent, 0);
+            platform.SetCursorPosition(960, 540);
+            cursorTracker.Sample();
+            platform.SetCursorPosition((monitorCount - 1) * 1920 + 960, 540);
+            cursorTracker.Sample();
+            if (DrainLastChange(cursorEvent).Monitor != monitors.back())
+            {
+                runner.Fail("DisplayPlatform/CursorSample" + suffix, "The tracker didn't end on the monitor under the cursor");
+            }
+            cursorTracker.UnsubscribeCursorMonitorChanged(cursorSubscription);
+
+            runner.Run("DisplayPlatform/Hotplug" + suffix, 100'000, [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    HydraCore::MonitorHandle monitor = platform.ConnectMonitor({ monitorCount * 1920, 0, 1920, 1080 }, "HOTPLUG");
+                    platform.DisconnectMonitor(monitor);
+                }
+            });
+
+            if (platform.GetAllMonitors().size() != (size_t)monitorCount)
+            {
+                runner.Fail("DisplayPlatform/Hotplug" + suffix, "Monitors were left behind after being disconnected");
+            }
+
+            DoNotOptimize(total);
+        }
+    }
+}
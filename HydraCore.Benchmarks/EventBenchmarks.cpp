@@ -0,0 +1,146 @@
+#include "Benchmark.h"
+#include "LegacyEvent.h"
+
+#include <Event.h>
+#include <vector>
+
+namespace HydraBenchmarks
+{
+    // Stands in for the tracker's active monitor, which legacy subscribers had to query after being notified
+    static void* legacyActiveMonitor = (void*)0x1234;
+
+    struct Subscriber
+    {
+        uintptr_t Total = 0;
+
+        void OnChanged(void* newMonitor, uint64_t timestamp)
+        {
+            Total += (uintptr_t)newMonitor + (uintptr_t)timestamp;
+        }
+
+        void OnLegacyChanged()
+        {
+            Total += (uintptr_t)legacyActiveMonitor;
+        }
+    };
+
+    static const int SubscriberCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+    static const int MaxSubscriberCount = 64;
+
+    static void RunDispatchBenchmarks(BenchmarkRunner& runner)
+    {
+        for (int subscriberCount : SubscriberCounts)
+        {
+            std::vector<Subscriber> subscribers(subscriberCount);
+
+            Legacy::Event legacyEvent;
+            HydraCore::Event<void*, uint64_t> event;
+            for (Subscriber& subscriber : subscribers)
+            {
+                legacyEvent.Subscribe(&subscriber, &Subscriber::OnLegacyChanged);
+                event.Subscribe(&subscriber, &Subscriber::OnChanged);
+            }
+
+            runner.Run("Event/Dispatch/Legacy/" + std::to_string(subscriberCount), 1'000'000, [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    legacyEvent.Dispatch();
+                }
+            });
+
+            runner.Run("Event/Dispatch/" + std::to_string(subscriberCount), 1'000'000, [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    event.Dispatch((void*)0x1234, i);
+                }
+            });
+
+            for (Subscriber& subscriber : subscribers)
+            {
+                DoNotOptimize(subscriber.Total);
+            }
+        }
+    }
+
+    static void RunSubscriptionBenchmarks(BenchmarkRunner& runner)
+    {
+        Subscriber subscriber;
+
+        // Churn a single subscription against an event with a handful of long-lived subscribers
+        {
+            Legacy::Event legacyEvent;
+            HydraCore::Event<void*, uint64_t> event;
+            for (int i = 0; i < 8; i++)
+            {
+                legacyEvent.Subscribe(&subscriber, &Subscriber::OnLegacyChanged);
+                event.Subscribe(&subscriber, &Subscriber::OnChanged);
+            }
+
+            runner.Run("Event/SubscribeUnsubscribe/Legacy", 1'000'000, [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    legacyEvent.Unsubscribe(legacyEvent.Subscribe(&subscriber, &Subscriber::OnLegacyChanged));
+                }
+            });
+
+            runner.Run("Event/SubscribeUnsubscribe", 1'000'000, [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    event.Unsubscribe(event.Subscribe(&subscriber, &Subscriber::OnChanged));
+                }
+            });
+        }
+
+        // Fill an event up and drain it again (reported per subscribe/unsubscribe pair)
+        {
+            Legacy::Event legacyEvent;
+            HydraCore::Event<void*, uint64_t> event;
+            Legacy::EventSubscriptionHandle legacyHandles[MaxSubscriberCount];
+            HydraCore::EventSubscriptionHandle handles[MaxSubscriberCount];
+
+            runner.Run("Event/Subscribe64Unsubscribe64/Legacy", 1'000'000, [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i += MaxSubscriberCount)
+                {
+                    for (int j = 0; j < MaxSubscriberCount; j++)
+                    {
+                        legacyHandles[j] = legacyEvent.Subscribe(&subscriber, &Subscriber::OnLegacyChanged);
+                    }
+
+                    for (int j = 0; j < MaxSubscriberCount; j++)
+                    {
+                        legacyEvent.Unsubscribe(legacyHandles[j]);
+                    }
+                }
+            });
+
+            runner.Run("Event/Subscribe64Unsubscribe64", 1'000'000, [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i += MaxSubscriberCount)
+                {
+                    for (int j = 0; j < MaxSubscriberCount; j++)
+                    {
+                        handles[j] = event.Subscribe(&subscriber, &Subscriber::OnChanged);
+                    }
+
+                    for (int j = 0; j < MaxSubscriberCount; j++)
+                    {
+                        event.Unsubscribe(handles[j]);
+                    }
+                }
+            });
+        }
+
+        DoNotOptimize(subscriber.Total);
+    }
+
+    void RunEventBenchmarks(BenchmarkRunner& runner)
+    {
+        RunDispatchBenchmarks(runner);
+        RunSubscriptionBenchmarks(runner);
+    }
+}
@@ -0,0 +1,390 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <I3Ipc.h>
+#include <JsonScanner.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <atomic>
+#include <chrono>
+#include <DisplayPlatformI3.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#endif
+
+namespace HydraBenchmarks
+{
+    // Recorded from i3 4.22 and sway 1.8, trimmed to a single child node
+    static const char I3WindowFocusEvent[] = R"({"change":"focus","container":{"id":94113092114976,"type":"con","orientation":"none","scratchpad_state":"none","percent":0.5,"urgent":false,"marks":[],"focused":true,"output":null,"layout":"splith","workspace_layout":"default","last_split_layout":"splith","border":"normal","current_border_width":2,"rect":{"x":1920,"y":0,"width":960,"height":1080},"deco_rect":{"x":0,"y":0,"width":960,"height":23},"window_rect":{"x":2,"y":23,"width":956,"height":1055},"geometry":{"x":0,"y":0,"width":1280,"height":720},"name":"main.cpp - obs-hydra - Visual Studio Code","window":41943043,"window_icon_padding":-1,"window_type":"normal","window_properties":{"class":"Code","instance":"code","machine":"workstation","title":"main.cpp - obs-hydra - Visual Studio Code","transient_for":null},"nodes":[],"floating_nodes":[],"focus":[],"fullscreen_mode":0,"sticky":false,"floating":"auto_off","swallows":[]}})";
+    static const char SwayWindowFocusEvent[] = R"({"change":"focus","container":{"id":27,"type":"con","orientation":"none","percent":0.5,"urgent":false,"marks":[],"focused":true,"layout":"none","border":"pixel","current_border_width":2,"rect":{"x":1922,"y":2,"width":956,"height":1076},"deco_rect":{"x":0,"y":0,"width":0,"height":0},"window_rect":{"x":0,"y":0,"width":956,"height":1076},"geometry":{"x":0,"y":0,"width":956,"height":1076},"name":"~/obs-hydra","window":null,"nodes":[],"floating_nodes":[],"focus":[],"fullscreen_mode":0,"sticky":false,"pid":4242,"app_id":"foot","visible":true,"max_render_time":0,"shell":"xdg_shell","inhibit_idle":false,"idle_inhibitors":{"user":"none","application":"none"}}})";
+    static const char WorkspaceFocusEvent[] = R"({"change":"focus","current":{"id":94113091870176,"type":"workspace","orientation":"horizontal","scratchpad_state":"none","percent":null,"urgent":false,"marks":[],"focused":true,"output":"HDMI-1","layout":"splith","workspace_layout":"default","last_split_layout":"splith","border":"normal","current_border_width":-1,"rect":{"x":3840,"y":0,"width":1280,"height":1024},"deco_rect":{"x":0,"y":0,"width":0,"height":0},"window_rect":{"x":0,"y":0,"width":0,"height":0},"geometry":{"x":0,"y":0,"width":0,"height":0},"name":"3","window":null,"window_type":null,"nodes":[],"floating_nodes":[],"focus":[],"fullscreen_mode":1,"sticky":false,"floating":null,"swallows":[]},"old":{"id":94113091640832,"type":"workspace","name":"2","output":"DP-2","rect":{"x":1920,"y":0,"width":1920,"height":1080},"nodes":[{"id":94113092114976,"name":"main.cpp","nodes":[]}],"floating_nodes":[]}})";
+    static const char OutputsReply[] = R"([{"name":"xroot-0","active":false,"primary":false,"rect":{"x":0,"y":0,"width":5120,"height":1080},"current_workspace":null},{"name":"DP-1","active":true,"primary":true,"rect":{"x":0,"y":0,"width":1920,"height":1080},"current_workspace":"1"},{"name":"DP-2","active":true,"primary":false,"rect":{"x":1920,"y":0,"width":1920,"height":1080},"current_workspace":"2"},{"name":"HDMI-1","active":true,"primary":false,"rect":{"x":3840,"y":0,"width":1280,"height":1024},"current_workspace":"3"}])";
+    static const char WorkspacesReply[] = R"([{"num":1,"name":"1","visible":true,"focused":true,"rect":{"x":0,"y":0,"width":1920,"height":1080},"output":"DP-1","urgent":false}])";
+
+    static const char* const OutputNames[] = { "DP-1", "DP-2", "HDMI-1" };
+    static const int32_t OutputLefts[] = { 0, 1920, 3840 };
+    static const int OutputCount = 3;
+
+    // Every fourth event switches to an empty workspace (which is followed by its output's name), the rest focus windows (which are followed by their location)
+    static std::string MakeReplayEvent(uint64_t index, bool sway, int& outputIndex)
+    {
+        outputIndex = (int)(index % OutputCount);
+        std::string payload;
+        uint32_t type;
+
+        if (index % 4 == 3)
+        {
+            type = HydraCore::I3_IPC_EVENT_WORKSPACE;
+            payload = WorkspaceFocusEvent;
+            payload.replace(payload.find("HDMI-1"), strlen("HDMI-1"), OutputNames[outputIndex]);
+        }
+        else
+        {
+            type = HydraCore::I3_IPC_EVENT_WINDOW;
+            payload = sway ? SwayWindowFocusEvent : I3WindowFocusEvent;
+            const char* rectangle = sway ? "\"rect\":{\"x\":1922" : "\"rect\":{\"x\":1920";
+            payload.replace(payload.find(rectangle), strlen(rectangle), "\"rect\":{\"x\":" + std::to_string(OutputLefts[outputIndex] + (sway ? 2 : 0)));
+        }
+
+        std::string ret;
+        HydraCore::AppendI3IpcMessage(ret, type, payload.data(), payload.size());
+        return ret;
+    }
+
+    static void RunParseBenchmarks(BenchmarkRunner& runner)
+    {
+        HydraCore::I3WindowEvent windowEvent;
+        HydraCore::I3WorkspaceEvent workspaceEvent;
+        std::vector<HydraCore::I3Output> outputs;
+
+        // The parsers are checked against the recordings first so the benchmarks can't be measuring a parser that gives up early
+        if (!HydraCore::ParseI3WindowEvent(I3WindowFocusEvent, sizeof(I3WindowFocusEvent) - 1, windowEvent)
+            || windowEvent.Change != HydraCore::I3_WINDOW_CHANGE_FOCUS || windowEvent.X11Window != 41943043 || windowEvent.Bounds.Left != 1920 || windowEvent.Bounds.Width != 960
+            || !windowEvent.WindowClass.Equals("Code"))
+        {
+            runner.Fail("I3Ipc/ParseWindowEvent/i3", "The recorded event was parsed incorrectly");
+        }
+
+        if (!HydraCore::ParseI3WindowEvent(SwayWindowFocusEvent, sizeof(SwayWindowFocusEvent) - 1, windowEvent)
+            || windowEvent.X11Window != 0 || windowEvent.ContainerId != 27 || windowEvent.ProcessId != 4242 || windowEvent.Bounds.Top != 2 || !windowEvent.WindowClass.Equals("foot"))
+        {
+            runner.Fail("I3Ipc/ParseWindowEvent/sway", "The recorded event was parsed incorrectly");
+        }
+
+        if (!HydraCore::ParseI3WorkspaceEvent(WorkspaceFocusEvent, sizeof(WorkspaceFocusEvent) - 1, workspaceEvent)
+            || !workspaceEvent.IsFocusChange || !workspaceEvent.Output.Equals("HDMI-1") || workspaceEvent.Bounds.Left != 3840)
+        {
+            runner.Fail("I3Ipc/ParseWorkspaceEvent", "The recorded event was parsed incorrectly");
+        }
+
+        if (!HydraCore::ParseI3Outputs(OutputsReply, sizeof(OutputsReply) - 1, outputs) || outputs.size() != 4 || outputs[0].IsActive || !outputs[3].Name.Equals("HDMI-1") || outputs[3].Bounds.Height != 1024)
+        {
+            runner.Fail("I3Ipc/ParseOutputs", "The recorded reply was parsed incorrectly");
+        }
+
+        // The scanner on its own, the parse benchmarks below add picking out the values (and skipping the containers) they need
+        runner.Run("I3Ipc/ScanEveryToken/i3", 1'000'000, [&](uint64_t iterations)
+        {
+            uint64_t total = 0;
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                HydraCore::JsonScanner scanner(I3WindowFocusEvent, sizeof(I3WindowFocusEvent) - 1);
+                HydraCore::JsonToken token;
+                while (scanner.Next(token))
+                {
+                    total += token.Type;
+                }
+            }
+            DoNotOptimize(total);
+        });
+
+        runner.Run("I3Ipc/ParseWindowEvent/i3", 1'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                HydraCore::ParseI3WindowEvent(I3WindowFocusEvent, sizeof(I3WindowFocusEvent) - 1, windowEvent);
+                DoNotOptimize(windowEvent);
+            }
+        });
+
+        runner.Run("I3Ipc/ParseWindowEvent/sway", 1'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                HydraCore::ParseI3WindowEvent(SwayWindowFocusEvent, sizeof(SwayWindowFocusEvent) - 1, windowEvent);
+                DoNotOptimize(windowEvent);
+            }
+        });
+
+        runner.Run("I3Ipc/ParseWorkspaceEvent", 1'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                HydraCore::ParseI3WorkspaceEvent(WorkspaceFocusEvent, sizeof(WorkspaceFocusEvent) - 1, workspaceEvent);
+                DoNotOptimize(workspaceEvent);
+            }
+        });
+
+        // The stream is fed to the reader in socket-sized chunks which split messages at arbitrary points
+        std::string stream;
+        for (uint64_t i = 0; i < 256; i++)
+        {
+            int outputIndex;
+            stream += MakeReplayEvent(i, false, outputIndex);
+        }
+
+        HydraCore::I3IpcReader reader;
+        uint64_t messageCount = 0;
+        runner.Run("I3Ipc/ReadStream", 10'000, [&](uint64_t iterations)
+        {
+            const size_t chunkSize = 4096;
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                for (size_t offset = 0; offset < stream.size(); offset += chunkSize)
+                {
+                    size_t length = std::min(chunkSize, stream.size() - offset);
+                    memcpy(reader.GetWriteBuffer(length), stream.data() + offset, length);
+                    reader.CommitWrite(length);
+
+                    uint32_t type;
+                    const char* payload;
+                    uint32_t payloadLength;
+                    while (reader.NextMessage(type, payload, payloadLength))
+                    {
+                        messageCount++;
+                    }
+                }
+            }
+        });
+
+        if (messageCount % 256 != 0)
+        {
+            runner.Fail("I3Ipc/ReadStream", "Messages were lost or duplicated while reassembling the stream");
+        }
+    }
+
+#ifndef _WIN32
+    // Plays the part of i3 (or sway): answers the platform's initial requests, replays a stream of events as fast as the socket will take them, and then closes a sentinel window
+    class FakeI3Server
+    {
+    private:
+        std::string path;
+        int listenSocket;
+        std::thread thread;
+
+        static void SendAll(int client, const std::string& data)
+        {
+            const char* cursor = data.data();
+            size_t remaining = data.size();
+            while (remaining > 0)
+            {
+                ssize_t sent = send(client, cursor, remaining, MSG_NOSIGNAL);
+                if (sent <= 0)
+                {
+                    return;
+                }
+
+                cursor += sent;
+                remaining -= sent;
+            }
+        }
+
+        static void Reply(int client, uint32_t type, const char* payload)
+        {
+            std::string message;
+            HydraCore::AppendI3IpcMessage(message, type, payload, strlen(payload));
+            SendAll(client, message);
+        }
+
+        void Serve(const std::string& chunk, uint64_t chunkCount)
+        {
+            int client = accept(listenSocket, nullptr, nullptr);
+            if (client < 0)
+            {
+                return;
+            }
+
+            HydraCore::I3IpcReader reader;
+            bool subscribed = false;
+            while (!subscribed)
+            {
+                ssize_t received = read(client, reader.GetWriteBuffer(4096), 4096);
+                if (received <= 0)
+                {
+                    close(client);
+                    return;
+                }
+                reader.CommitWrite(received);
+
+                uint32_t type;
+                const char* payload;
+                uint32_t length;
+                while (reader.NextMessage(type, payload, length))
+                {
+                    switch (type)
+                    {
+                        case HydraCore::I3_IPC_GET_OUTPUTS: Reply(client, type, OutputsReply); break;
+                        case HydraCore::I3_IPC_GET_WORKSPACES: Reply(client, type, WorkspacesReply); break;
+                        case HydraCore::I3_IPC_SUBSCRIBE: Reply(client, type, "{\"success\":true}"); subscribed = true; break;
+                    }
+                }
+            }
+
+            for (uint64_t i = 0; i < chunkCount; i++)
+            {
+                SendAll(client, chunk);
+            }
+
+            Reply(client, HydraCore::I3_IPC_EVENT_WINDOW, R"({"change":"close","container":{"id":1,"window":null,"nodes":[]}})");
+
+            // The platform hangs up once it has seen the sentinel
+            char buffer[16];
+            while (read(client, buffer, sizeof(buffer)) > 0)
+            {
+            }
+            close(client);
+        }
+    public:
+        FakeI3Server(const std::string& chunk, uint64_t chunkCount)
+        {
+            path = "/tmp/hydra-fake-i3-" + std::to_string(getpid()) + ".sock";
+            unlink(path.c_str());
+
+            sockaddr_un address = {};
+            address.sun_family = AF_UNIX;
+            memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+            listenSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (listenSocket < 0 || bind(listenSocket, (sockaddr*)&address, sizeof(address)) != 0 || listen(listenSocket, 1) != 0)
+            {
+                if (listenSocket >= 0)
+                {
+                    close(listenSocket);
+                }
+                throw std::runtime_error("Failed to create the fake i3 IPC socket at " + path);
+            }
+
+            thread = std::thread(&FakeI3Server::Serve, this, chunk, chunkCount);
+        }
+
+        ~FakeI3Server()
+        {
+            thread.join();
+            close(listenSocket);
+            unlink(path.c_str());
+        }
+
+        inline const std::string& GetPath()
+        {
+            return path;
+        }
+    };
+
+    struct ReplayObserver
+    {
+        std::atomic<bool> SentinelClosed;
+        uint64_t DispatchCount;
+        HydraCore::MonitorHandle LastMonitor;
+
+        void ActiveMonitorChanged(HydraCore::WindowId window, HydraCore::MonitorHandle monitor, uint64_t timestamp)
+        {
+            DispatchCount++;
+            LastMonitor = monitor;
+        }
+
+        void WindowDestroyed(HydraCore::WindowId window)
+        {
+            if (window == 1)
+            {
+                SentinelClosed.store(true);
+            }
+        }
+    };
+
+    static void RunReplayBenchmarks(BenchmarkRunner& runner)
+    {
+        const uint64_t chunkEventCount = 240;
+
+        for (bool sway : { false, true })
+        {
+            std::string name = std::string("I3Ipc/ReplayFocusChanges/") + (sway ? "sway" : "i3");
+            std::string chunk;
+            int lastOutputIndex = 0;
+            for (uint64_t i = 0; i < chunkEventCount; i++)
+            {
+                chunk += MakeReplayEvent(i, sway, lastOutputIndex);
+            }
+
+            // The monitors come from the fake outputs, where xroot-0 is skipped since it's inactive
+            HydraCore::MonitorHandle expectedMonitor = (HydraCore::MonitorHandle)(uintptr_t)(lastOutputIndex + 1);
+            uint64_t totalDispatchCount = 0;
+            uint64_t totalEventCount = 0;
+
+            try
+            {
+                runner.Run(name, 200'000, [&](uint64_t iterations)
+                {
+                    uint64_t chunkCount = (iterations + chunkEventCount - 1) / chunkEventCount;
+                    FakeI3Server server(chunk, chunkCount);
+                    ReplayObserver observer;
+                    observer.SentinelClosed.store(false);
+                    observer.DispatchCount = 0;
+                    observer.LastMonitor = nullptr;
+
+                    HydraCore::DisplayPlatform* platform = HydraCore::CreateI3DisplayPlatform(server.GetPath(), nullptr);
+                    platform->SubscribeActiveMonitorChanged(&observer, &ReplayObserver::ActiveMonitorChanged);
+                    platform->SubscribeWindowDestroyed(&observer, &ReplayObserver::WindowDestroyed);
+                    platform->StartEvents();
+
+                    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+                    while (!observer.SentinelClosed.load() && std::chrono::steady_clock::now() < deadline)
+                    {
+                        std::this_thread::sleep_for(std::chrono::microseconds(100));
+                    }
+
+                    // The event thread finishes its batch (and dispatches the final change) before the platform is destroyed
+                    bool completed = observer.SentinelClosed.load();
+                    delete platform;
+
+                    if (!completed)
+                    {
+                        runner.Fail(name, "The replay didn't finish within 30 seconds");
+                    }
+                    else if (observer.LastMonitor != expectedMonitor)
+                    {
+                        runner.Fail(name, "The replay didn't end on the expected monitor");
+                    }
+
+                    totalDispatchCount += observer.DispatchCount;
+                    totalEventCount += chunkCount * chunkEventCount;
+                });
+            }
+            catch (const std::exception& exception)
+            {
+                runner.Fail(name, exception.what());
+                continue;
+            }
+
+            // Bursts which arrive together are dispatched once, so there's always at least one dispatch but never more than there were events
+            if (totalEventCount > 0 && (totalDispatchCount == 0 || totalDispatchCount > totalEventCount))
+            {
+                runner.Fail(name, std::to_string(totalDispatchCount) + " focus changes were dispatched for " + std::to_string(totalEventCount) + " events");
+            }
+        }
+    }
+#endif
+
+    void RunI3IpcBenchmarks(BenchmarkRunner& runner)
+    {
+        RunParseBenchmarks(runner);
+#ifndef _WIN32
+        RunReplayBenchmarks(runner);
+#endif
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <stdint.h>
+
+namespace HydraBenchmarks
+{
+    // The original heap-allocated, virtually-dispatched HydraCore::Event, kept as a baseline for the event benchmarks
+    // (Unlike the original, Unsubscribe frees the handler so that churn benchmarks don't measure a leak.)
+    namespace Legacy
+    {
+        typedef uintptr_t EventSubscriptionHandle;
+
+        class EventHandlerBase
+        {
+        public:
+            virtual ~EventHandlerBase()
+            {
+            }
+
+            virtual void Dispatch() = 0;
+        };
+
+        template<class TTarget>
+        class EventHandler : public EventHandlerBase
+        {
+        public:
+            typedef void (TTarget::*TargetMethodType)();
+        private:
+            TTarget* targetObject;
+            TargetMethodType targetMethod;
+        public:
+            EventHandler(TTarget* targetObject, TargetMethodType targetMethod)
+                : targetObject(targetObject), targetMethod(targetMethod)
+            {
+            }
+
+            virtual void Dispatch()
+            {
+                (targetObject->*targetMethod)();
+            }
+        };
+
+        class Event
+        {
+        private:
+            std::map<EventSubscriptionHandle, EventHandlerBase*> eventHandlers;
+            std::mutex eventHandlersMutex;
+            EventSubscriptionHandle nextHandle;
+        public:
+            inline Event()
+            {
+                nextHandle = 1;
+            }
+
+            ~Event()
+            {
+                for (const std::pair<const EventSubscriptionHandle, EventHandlerBase*>& eventHandler : eventHandlers)
+                {
+                    delete eventHandler.second;
+                }
+            }
+
+            template<class TTarget>
+            EventSubscriptionHandle Subscribe(TTarget* targetObject, typename EventHandler<TTarget>::TargetMethodType targetMethod)
+            {
+                std::lock_guard<std::mutex> lock(eventHandlersMutex);
+
+                EventSubscriptionHandle handle = nextHandle;
+                nextHandle++;
+                eventHandlers[handle] = new EventHandler<TTarget>(targetObject, targetMethod);
+                return handle;
+            }
+
+            void Unsubscribe(EventSubscriptionHandle subscriptionHandle)
+            {
+                std::lock_guard<std::mutex> lock(eventHandlersMutex);
+
+                auto eventHandler = eventHandlers.find(subscriptionHandle);
+                if (eventHandler != eventHandlers.end())
+                {
+                    delete eventHandler->second;
+                    eventHandlers.erase(eventHandler);
+                }
+            }
+
+            void Dispatch()
+            {
+                std::lock_guard<std::mutex> lock(eventHandlersMutex);
+
+                for (const std::pair<const EventSubscriptionHandle, EventHandlerBase*>& eventHandler : eventHandlers)
+                {
+                    eventHandler.second->Dispatch();
+                }
+            }
+        };
+    }
+}
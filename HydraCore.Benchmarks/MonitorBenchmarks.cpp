@@ -0,0 +1,69 @@
+#include "Benchmark.h"
+
+#include <Monitor.h>
+#include <vector>
+
+namespace HydraBenchmarks
+{
+    static const int MonitorCounts[] = { 1, 2, 4, 8, 16 };
+
+    static std::vector<HydraCore::Monitor> CreateMonitors(int count)
+    {
+        std::vector<HydraCore::Monitor> ret;
+        for (int i = 0; i < count; i++)
+        {
+            HydraCore::Rectangle rectangle = { i * 1920, 0, 1920, 1080 };
+            std::string name = "\\\\.\\DISPLAY" + std::to_string(i + 1);
+            std::string interfaceId = "\\\\?\\DISPLAY#BENCH" + std::to_string(i) + "#{e6f07b5f-ee97-4a90-b076-33f57bf4eaa7}";
+            ret.push_back(HydraCore::Monitor((uint32_t)i, (HydraCore::MonitorHandle)(uintptr_t)(0x10000 + i), rectangle, interfaceId, name, i == count / 2));
+        }
+
+        return ret;
+    }
+
+    void RunMonitorBenchmarks(BenchmarkRunner& runner)
+    {
+        for (int monitorCount : MonitorCounts)
+        {
+            std::vector<HydraCore::Monitor> monitors = CreateMonitors(monitorCount);
+            uintptr_t total = 0;
+
+            // This mirrors how ActiveMonitorSource finds the monitor for a handle from the tracker
+            runner.Run("Monitor/FindByHandle/" + std::to_string(monitorCount), 10'000'000, [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    HydraCore::MonitorHandle handle = (HydraCore::MonitorHandle)(uintptr_t)(0x10000 + (i % monitorCount));
+                    HydraCore::Monitor* found = nullptr;
+                    for (HydraCore::Monitor& monitor : monitors)
+                    {
+                        if (monitor.GetHandle() == handle)
+                        {
+                            found = &monitor;
+                        }
+                    }
+
+                    total += (uintptr_t)found;
+                }
+            });
+
+            runner.Run("Monitor/GetPrimaryMonitor/" + std::to_string(monitorCount), 1'000'000, [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    total += HydraCore::Monitor::GetPrimaryMonitor(monitors).GetId();
+                }
+            });
+
+            runner.Run("Monitor/GetTopologyFingerprint/" + std::to_string(monitorCount), 1'000'000, [&](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; i++)
+                {
+                    total += (uintptr_t)HydraCore::Monitor::GetTopologyFingerprint(monitors);
+                }
+            });
+
+            DoNotOptimize(total);
+        }
+    }
+}
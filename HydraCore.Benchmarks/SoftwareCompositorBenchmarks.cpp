@@ -0,0 +1,303 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <CompositeLayout.h>
+#include <math.h>
+#include <random>
+#include <RenderTransform.h>
+#include <SoftwareCompositor.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace HydraBenchmarks
+{
+    // Every kernel has to land within this many steps of the reference (they round in float rather than double)
+    static const int MaximumError = 1;
+
+    struct ScaleCase
+    {
+        uint32_t SourceWidth;
+        uint32_t SourceHeight;
+        uint32_t DestinationWidth;
+        uint32_t DestinationHeight;
+    };
+
+    static const ScaleCase CorrectnessCases[] =
+    {
+        { 1920, 1080, 480, 270 },
+        { 2560, 1440, 1366, 768 },
+        { 1280, 720, 1920, 1080 },
+        { 37, 23, 13, 7 },
+        { 13, 7, 37, 23 },
+        { 1, 1, 5, 3 },
+        { 3840, 2160, 1, 1 },
+    };
+
+    struct OwnedImage
+    {
+        std::vector<uint8_t> Buffer;
+        HydraCore::SoftwareImage Image;
+    };
+
+    static void CreateImage(OwnedImage& image, uint32_t width, uint32_t height, std::mt19937& random)
+    {
+        // Padded rows so that the stride is actually used
+        uint32_t stride = width * 4 + 64;
+        image.Buffer.resize((size_t)stride * height);
+        for (uint8_t& value : image.Buffer)
+        {
+            value = (uint8_t)random();
+        }
+
+        image.Image = { image.Buffer.data(), width, height, stride };
+    }
+
+    // A straightforward area-average scaler which shares nothing with the kernels: each destination pixel integrates the source over its footprint in double precision
+    static void ReferenceScale(const HydraCore::SoftwareImage& source, HydraCore::SoftwareImage& destination)
+    {
+        double scaleX = (double)source.Width / destination.Width;
+        double scaleY = (double)source.Height / destination.Height;
+
+        for (uint32_t y = 0; y < destination.Height; y++)
+        {
+            double top = y * scaleY;
+            double bottom = (y + 1) * scaleY;
+
+            for (uint32_t x = 0; x < destination.Width; x++)
+            {
+                double left = x * scaleX;
+                double right = (x + 1) * scaleX;
+                double sum[4] = {};
+
+                for (uint32_t sourceY = (uint32_t)top; sourceY < source.Height && sourceY < bottom; sourceY++)
+                {
+                    double coverageY = std::min(bottom, sourceY + 1.0) - std::max(top, (double)sourceY);
+                    for (uint32_t sourceX = (uint32_t)left; sourceX < source.Width && sourceX < right; sourceX++)
+                    {
+                        double coverage = coverageY * (std::min(right, sourceX + 1.0) - std::max(left, (double)sourceX));
+                        const uint8_t* pixel = source.Pixels + (size_t)sourceY * source.Stride + sourceX * 4;
+                        for (int channel = 0; channel < 4; channel++)
+                        {
+                            sum[channel] += coverage * pixel[channel];
+                        }
+                    }
+                }
+
+                for (int channel = 0; channel < 4; channel++)
+                {
+                    destination.Pixels[(size_t)y * destination.Stride + x * 4 + channel] = (uint8_t)std::min(255.0, floor(sum[channel] / (scaleX * scaleY) + 0.5));
+                }
+            }
+        }
+    }
+
+    static int GetMaximumDifference(const HydraCore::SoftwareImage& a, const HydraCore::SoftwareImage& b)
+    {
+        int ret = 0;
+        for (uint32_t y = 0; y < a.Height; y++)
+        {
+            for (uint32_t i = 0; i < a.Width * 4; i++)
+            {
+                ret = std::max(ret, abs((int)a.Pixels[(size_t)y * a.Stride + i] - (int)b.Pixels[(size_t)y * b.Stride + i]));
+            }
+        }
+
+        return ret;
+    }
+
+    static void Scale(const HydraCore::CompositorKernels& kernels, HydraCore::AreaScalePlan& plan, const HydraCore::SoftwareImage& source, HydraCore::SoftwareImage& destination, std::vector<float>& accumulator)
+    {
+        plan.Update(source.Width, source.Height, destination.Width, destination.Height);
+        accumulator.resize((size_t)source.Width * 4);
+        HydraCore::ScaleAreaRows(kernels, plan, source.Pixels, source.Stride, destination.Pixels, destination.Stride, 0, destination.Height, 0, destination.Width, accumulator.data());
+    }
+
+    static std::string GetCaseName(const ScaleCase& scaleCase)
+    {
+        char ret[64];
+        snprintf(ret, sizeof(ret), "%ux%u->%ux%u", scaleCase.SourceWidth, scaleCase.SourceHeight, scaleCase.DestinationWidth, scaleCase.DestinationHeight);
+        return ret;
+    }
+
+    static void ReportThroughput(BenchmarkRunner& runner, const std::string& name, double megapixelsPerIteration)
+    {
+        // Nothing was measured if the filter skipped the benchmark
+        const std::vector<BenchmarkResult>& results = runner.GetResults();
+        if (results.empty() || results.back().Name != name)
+        {
+            return;
+        }
+
+        printf("%-56s %12.1f MP/s\n", name.c_str(), megapixelsPerIteration * 1e9 / results.back().NanosecondsPerIteration);
+        fflush(stdout);
+    }
+
+    static void RunScaleCorrectnessChecks(BenchmarkRunner& runner)
+    {
+        std::mt19937 random(1234);
+        HydraCore::AreaScalePlan plan;
+        std::vector<float> accumulator;
+
+        for (const ScaleCase& scaleCase : CorrectnessCases)
+        {
+            OwnedImage source;
+            OwnedImage expected;
+            OwnedImage actual;
+            CreateImage(source, scaleCase.SourceWidth, scaleCase.SourceHeight, random);
+            CreateImage(expected, scaleCase.DestinationWidth, scaleCase.DestinationHeight, random);
+            CreateImage(actual, scaleCase.DestinationWidth, scaleCase.DestinationHeight, random);
+            ReferenceScale(source.Image, expected.Image);
+
+            for (int level = 0; level <= HydraCore::GetSupportedSimdLevel(); level++)
+            {
+                std::string name = "SoftwareCompositor/Correctness/" + GetCaseName(scaleCase) + "/" + HydraCore::GetSimdLevelName((HydraCore::SimdLevel)level);
+                Scale(HydraCore::GetCompositorKernels((HydraCore::SimdLevel)level), plan, source.Image, actual.Image, accumulator);
+
+                int difference = GetMaximumDifference(expected.Image, actual.Image);
+                if (difference > MaximumError)
+                {
+                    char message[128];
+                    snprintf(message, sizeof(message), "differs from the reference scaler by up to %d", difference);
+                    runner.Fail(name, message);
+                }
+            }
+        }
+
+        // The blend kernels have tails of up to 7 pixels, so odd widths are checked against the scalar kernel
+        for (int level = HydraCore::SIMD_LEVEL_SSE2; level <= HydraCore::GetSupportedSimdLevel(); level++)
+        {
+            const float color[4] = { 10.f, 80.f, 150.f, 200.f };
+            OwnedImage expected;
+            OwnedImage actual;
+            CreateImage(expected, 37, 3, random);
+            actual = expected;
+            actual.Image.Pixels = actual.Buffer.data();
+
+            for (uint32_t y = 0; y < expected.Image.Height; y++)
+            {
+                HydraCore::ScalarCompositorKernels.BlendSolid(expected.Image.Pixels + (size_t)y * expected.Image.Stride, expected.Image.Width, color);
+                HydraCore::GetCompositorKernels((HydraCore::SimdLevel)level).BlendSolid(actual.Image.Pixels + (size_t)y * actual.Image.Stride, actual.Image.Width, color);
+            }
+
+            int difference = GetMaximumDifference(expected.Image, actual.Image);
+            if (difference > MaximumError)
+            {
+                char message[128];
+                snprintf(message, sizeof(message), "differs from the scalar kernel by up to %d", difference);
+                runner.Fail(std::string("SoftwareCompositor/Correctness/BlendSolid/") + HydraCore::GetSimdLevelName((HydraCore::SimdLevel)level), message);
+            }
+        }
+    }
+
+    static void RunScaleBenchmarks(BenchmarkRunner& runner)
+    {
+        static const ScaleCase BenchmarkCases[] =
+        {
+            { 3840, 2160, 480, 270 },
+            { 1920, 1080, 640, 360 },
+            { 2560, 1440, 1366, 768 },
+        };
+
+        std::mt19937 random(5678);
+        HydraCore::AreaScalePlan plan;
+        std::vector<float> accumulator;
+
+        for (const ScaleCase& scaleCase : BenchmarkCases)
+        {
+            OwnedImage source;
+            OwnedImage destination;
+            CreateImage(source, scaleCase.SourceWidth, scaleCase.SourceHeight, random);
+            CreateImage(destination, scaleCase.DestinationWidth, scaleCase.DestinationHeight, random);
+
+            for (int level = 0; level <= HydraCore::GetSupportedSimdLevel(); level++)
+            {
+                const HydraCore::CompositorKernels& kernels = HydraCore::GetCompositorKernels((HydraCore::SimdLevel)level);
+                std::string name = "SoftwareCompositor/Scale/" + GetCaseName(scaleCase) + "/" + HydraCore::GetSimdLevelName((HydraCore::SimdLevel)level);
+
+                runner.Run(name, 30, [&](uint64_t iterations)
+                {
+                    for (uint64_t i = 0; i < iterations; i++)
+                    {
+                        Scale(kernels, plan, source.Image, destination.Image, accumulator);
+                    }
+                });
+
+                // Throughput is counted in source pixels since reading them is most of the work
+                ReportThroughput(runner, name, scaleCase.SourceWidth * scaleCase.SourceHeight / 1e6);
+            }
+        }
+    }
+
+    static void RunCompositeBenchmarks(BenchmarkRunner& runner)
+    {
+        // Four 1080p monitors in overview mode, each tile a quarter of the width of the 1080p output
+        static const uint32_t MonitorCount = 4;
+        static const uint32_t TileWidth = 480;
+        static const uint32_t TileHeight = 270;
+
+        std::mt19937 random(9012);
+        std::vector<OwnedImage> monitors(MonitorCount);
+        std::vector<HydraCore::SoftwareImage> children;
+        std::vector<HydraCore::RenderTransform> transforms;
+        for (OwnedImage& monitor : monitors)
+        {
+            CreateImage(monitor, 1920, 1080, random);
+            children.push_back(monitor.Image);
+            transforms.push_back(HydraCore::ComputeRenderTransform(1920, 1080, {}, TileWidth, TileHeight, HydraCore::SCALE_MODE_FIT));
+        }
+
+        HydraCore::CompositeLayout layout;
+        HydraCore::CompositeLayoutSettings settings = { TileWidth, TileHeight, true, true, 4 };
+        layout.Update(settings, std::vector<uint8_t>(MonitorCount, 1), 1, (float)TileWidth * 1.5f, true);
+
+        OwnedImage expected;
+        CreateImage(expected, TileWidth * MonitorCount, TileHeight, random);
+        HydraCore::SoftwareCompositor(HydraCore::SIMD_LEVEL_SCALAR, 1).Composite(expected.Image, layout, children, transforms, 0xc0ff386d);
+
+        uint32_t threadCounts[] = { 1, 0 };
+        for (int level = 0; level <= HydraCore::GetSupportedSimdLevel(); level++)
+        {
+            for (uint32_t threadCount : threadCounts)
+            {
+                HydraCore::SoftwareCompositor compositor((HydraCore::SimdLevel)level, threadCount);
+                if (threadCount == 0 && compositor.GetWorkerCount() == 1)
+                {
+                    continue;
+                }
+
+                OwnedImage target;
+                CreateImage(target, TileWidth * MonitorCount, TileHeight, random);
+
+                char name[128];
+                snprintf(name, sizeof(name), "SoftwareCompositor/Composite/4x1080p/%s/%u threads", HydraCore::GetSimdLevelName(compositor.GetSimdLevel()), compositor.GetWorkerCount());
+
+                // Banding and clipping mustn't change the image, only the kernels' rounding may
+                compositor.Composite(target.Image, layout, children, transforms, 0xc0ff386d);
+                int difference = GetMaximumDifference(expected.Image, target.Image);
+                if (difference > MaximumError)
+                {
+                    char message[128];
+                    snprintf(message, sizeof(message), "differs from the single-threaded scalar composite by up to %d", difference);
+                    runner.Fail(name, message);
+                }
+
+                runner.Run(name, 30, [&](uint64_t iterations)
+                {
+                    for (uint64_t i = 0; i < iterations; i++)
+                    {
+                        compositor.Composite(target.Image, layout, children, transforms, 0xc0ff386d);
+                    }
+                });
+
+                ReportThroughput(runner, name, MonitorCount * 1920 * 1080 / 1e6);
+            }
+        }
+    }
+
+    void RunSoftwareCompositorBenchmarks(BenchmarkRunner& runner)
+    {
+        RunScaleCorrectnessChecks(runner);
+        RunScaleBenchmarks(runner);
+        RunCompositeBenchmarks(runner);
+    }
+}
@@ -0,0 +1,158 @@
+#include "Benchmark.h"
+
+#include <ActiveMonitorTracker.h>
+#include <atomic>
+#include <new>
+#include <SharedMemory.h>
+#include <SimulatedDisplayPlatform.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <TrackerFeed.h>
+
+namespace HydraBenchmarks
+{
+    // Kept separate from the real feed so that running the benchmarks doesn't disturb (or get disturbed by) a running OBS
+    static const char* BenchmarkFeedName = "hydra-tracker-benchmark";
+
+    // Every field is derived from the counter, so a read which mixes two writes can be detected
+    static HydraCore::TrackerFeedState MakeStressState(uint64_t counter)
+    {
+        HydraCore::TrackerFeedState ret = {};
+        ret.Monitor = counter;
+        ret.MonitorIndex = (uint32_t)counter;
+        ret.Bounds = { (int32_t)counter, -(int32_t)counter, (uint32_t)counter * 3, (uint32_t)counter * 5 };
+        ret.ChangeTimestamp = counter;
+        ret.PublishTimestamp = ~counter;
+        return ret;
+    }
+
+    static bool IsStressStateConsistent(const HydraCore::TrackerFeedState& state)
+    {
+        HydraCore::TrackerFeedState expected = MakeStressState(state.Monitor);
+        return state.MonitorIndex == expected.MonitorIndex
+            && state.Bounds.Left == expected.Bounds.Left && state.Bounds.Top == expected.Bounds.Top
+            && state.Bounds.Width == expected.Bounds.Width && state.Bounds.Height == expected.Bounds.Height
+            && state.ChangeTimestamp == expected.ChangeTimestamp && state.PublishTimestamp == expected.PublishTimestamp;
+    }
+
+    static void RunSequenceLockBenchmarks(BenchmarkRunner& runner)
+    {
+        // Reads go through a second, read-only mapping of the block like they would in another process
+        HydraCore::SharedMemory* writerMemory = HydraCore::SharedMemory::Create(BenchmarkFeedName, sizeof(HydraCore::TrackerFeedBlock));
+        HydraCore::SharedMemory* readerMemory = HydraCore::SharedMemory::Open(BenchmarkFeedName, sizeof(HydraCore::TrackerFeedBlock), true);
+        HydraCore::TrackerFeedBlock* block = new (writerMemory->GetAddress()) HydraCore::TrackerFeedBlock();
+        const HydraCore::TrackerFeedBlock* readerBlock = (const HydraCore::TrackerFeedBlock*)readerMemory->GetAddress();
+        block->Write(MakeStressState(1));
+
+        uint64_t total = 0;
+        runner.Run("TrackerFeed/Read", 10'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                total += readerBlock->Read().Monitor;
+            }
+        });
+
+        runner.Run("TrackerFeed/Write", 10'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                block->Write(MakeStressState(i));
+            }
+        });
+
+        // A writer publishing as fast as it can is far more hostile than the tracker ever is, so any torn read would show up here
+        std::atomic<bool> stopWriter(false);
+        std::thread writer([&]()
+        {
+            for (uint64_t counter = 0; !stopWriter.load(std::memory_order_relaxed); counter++)
+            {
+                block->Write(MakeStressState(counter));
+            }
+        });
+
+        uint64_t tornReadCount = 0;
+        uint64_t readCount = 0;
+        runner.Run("TrackerFeed/ReadWhileWriting", 10'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                if (!IsStressStateConsistent(readerBlock->Read()))
+                {
+                    tornReadCount++;
+                }
+            }
+            readCount += iterations;
+        });
+
+        stopWriter = true;
+        writer.join();
+
+        if (tornReadCount > 0)
+        {
+            runner.Fail("TrackerFeed/ReadWhileWriting", std::to_string(tornReadCount) + " of " + std::to_string(readCount) + " reads were torn");
+        }
+
+        delete readerMemory;
+        delete writerMemory;
+        DoNotOptimize(total);
+    }
+
+    static void RunPublishBenchmarks(BenchmarkRunner& runner)
+    {
+        HydraCore::SimulatedDisplayPlatform platform;
+        platform.ConnectMonitor({ 0, 0, 1920, 1080 }, "SIMULATED-0", true);
+        platform.ConnectMonitor({ 1920, 0, 1920, 1080 }, "SIMULATED-1");
+        HydraCore::SimulatedWindow windows[] =
+        {
+            platform.AddWindow({ 0, 0, 1920, 1080 }),
+            platform.AddWindow({ 1920, 0, 1920, 1080 }),
+        };
+
+        HydraCore::ActiveMonitorTracker tracker(&platform);
+        HydraCore::TrackerFeed feed(&platform, &tracker, BenchmarkFeedName);
+        HydraCore::TrackerFeedReader reader(BenchmarkFeedName);
+
+        // Every focus change moves to the other monitor, so each one is published (the socket has no clients, so this is the cost of queuing the message)
+        runner.Run("TrackerFeed/PublishFocusChange", 100'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                platform.AdvanceTime(1'000'000);
+                platform.FocusWindow(windows[i % 2]);
+            }
+        });
+
+        // Polling the sequence is what a reader does every frame when nothing has changed
+        uint64_t total = 0;
+        runner.Run("TrackerFeed/PollSequence", 10'000'000, [&](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                total += reader.GetSequence();
+            }
+        });
+
+        HydraCore::TrackerFeedState state;
+        if (!reader.Read(state) || state.Bounds.Width != 1920 || state.Sequence != reader.GetSequence())
+        {
+            runner.Fail("TrackerFeed/PublishFocusChange", "The published state didn't match the active monitor");
+        }
+
+        DoNotOptimize(total);
+    }
+
+    void RunTrackerFeedBenchmarks(BenchmarkRunner& runner)
+    {
+        try
+        {
+            RunSequenceLockBenchmarks(runner);
+            RunPublishBenchmarks(runner);
+        }
+        catch (const std::exception& exception)
+        {
+            runner.Fail("TrackerFeed", exception.what());
+        }
+    }
+}
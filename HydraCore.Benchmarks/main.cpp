@@ -0,0 +1,63 @@
+#include "Benchmark.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void PrintUsage(const char* programName)
+{
+    printf("Usage: %s [--filter <text>] [--json <file>] [--quick]\n", programName);
+    printf("  --filter <text>  Only run benchmarks whose names contain <text>\n");
+    printf("  --json <file>    Write the results to <file> as JSON\n");
+    printf("  --quick          Run a tenth of the usual iterations\n");
+}
+
+int main(int argc, char* argv[])
+{
+    HydraBenchmarks::BenchmarkRunner runner;
+    const char* jsonFilePath = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            runner.SetFilter(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        {
+            jsonFilePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--quick") == 0)
+        {
+            runner.SetIterationScale(0.1);
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    HydraBenchmarks::RunEventBenchmarks(runner);
+    HydraBenchmarks::RunDeferredEventBenchmarks(runner);
+    HydraBenchmarks::RunAnimationBenchmarks(runner);
+    HydraBenchmarks::RunMonitorBenchmarks(runner);
+    HydraBenchmarks::RunDisplayPlatformBenchmarks(runner);
+    HydraBenchmarks::RunI3IpcBenchmarks(runner);
+    HydraBenchmarks::RunTrackerFeedBenchmarks(runner);
+    HydraBenchmarks::RunSoftwareCompositorBenchmarks(runner);
+
+    if (jsonFilePath != nullptr && !runner.WriteJson(jsonFilePath))
+    {
+        fprintf(stderr, "Failed to write benchmark results to '%s'\n", jsonFilePath);
+        return 1;
+    }
+
+    if (runner.GetFailures().size() > 0)
+    {
+        fprintf(stderr, "%zu benchmark(s) failed\n", runner.GetFailures().size());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,233 @@
+#include "Scenario.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace HydraSimulator
+{
+    struct PendingEvent
+    {
+        uint64_t Time;
+        ScenarioEventType Type;
+        std::string Monitor;
+        int Line;
+    };
+
+    static std::runtime_error MakeException(const std::string& sourceName, int line, const std::string& message)
+    {
+        return std::runtime_error(sourceName + ":" + std::to_string(line) + ": " + message);
+    }
+
+    static uint32_t FindMonitor(const std::vector<ScenarioMonitor>& monitors, const std::string& name, const std::string& sourceName, int line)
+    {
+        for (size_t i = 0; i < monitors.size(); i++)
+        {
+            if (monitors[i].Name == name)
+            {
+                return (uint32_t)i;
+            }
+        }
+
+        throw MakeException(sourceName, line, "Unknown monitor '" + name + "'.");
+    }
+
+    Scenario Scenario::Load(const std::string& filePath)
+    {
+        std::ifstream input(filePath);
+        if (!input)
+        {
+            throw std::runtime_error("Could not open '" + filePath + "'.");
+        }
+
+        return Parse(input, filePath);
+    }
+
+    Scenario Scenario::Parse(std::istream& input, const std::string& sourceName)
+    {
+        Scenario ret = {};
+        std::vector<PendingEvent> events;
+        std::string startMonitor;
+        int startLine = 0;
+
+        std::string text;
+        for (int line = 1; std::getline(input, text); line++)
+        {
+            size_t comment = text.find('#');
+            if (comment != std::string::npos)
+            {
+                text.resize(comment);
+            }
+
+            std::istringstream tokens(text);
+            std::string keyword;
+            if (!(tokens >> keyword))
+            {
+                continue;
+            }
+
+            if (keyword == "monitor")
+            {
+                ScenarioMonitor monitor = {};
+                monitor.IsEnabled = true;
+                if (!(tokens >> monitor.Name >> monitor.Rectangle.Left >> monitor.Rectangle.Top >> monitor.Rectangle.Width >> monitor.Rectangle.Height))
+                {
+                    throw MakeException(sourceName, line, "Expected: monitor <name> <left> <top> <width> <height>");
+                }
+
+                if (monitor.Rectangle.Width == 0 || monitor.Rectangle.Height == 0)
+                {
+                    throw MakeException(sourceName, line, "Monitors must have a non-zero size.");
+                }
+
+                std::string option;
+                while (tokens >> option)
+                {
+                    if (option == "primary")
+                    {
+                        monitor.IsPrimary = true;
+                    }
+                    else if (option == "disabled")
+                    {
+                        monitor.IsEnabled = false;
+                    }
+                    else if (option == "crop")
+                    {
+                        HydraCore::Margins& crop = monitor.Crop;
+                        if (!(tokens >> crop.Left >> crop.Top >> crop.Right >> crop.Bottom))
+                        {
+                            throw MakeException(sourceName, line, "Expected: crop <left> <top> <right> <bottom>");
+                        }
+                    }
+                    else
+                    {
+                        throw MakeException(sourceName, line, "Unknown monitor option '" + option + "'.");
+                    }
+                }
+
+                for (ScenarioMonitor& other : ret.Monitors)
+                {
+                    if (other.Name == monitor.Name)
+                    {
+                        throw MakeException(sourceName, line, "Monitor '" + monitor.Name + "' was already defined.");
+                    }
+                }
+
+                ret.Monitors.push_back(monitor);
+            }
+            else if (keyword == "start")
+            {
+                if (!(tokens >> startMonitor))
+                {
+                    throw MakeException(sourceName, line, "Expected: start <name>");
+                }
+                startLine = line;
+            }
+            else if (keyword == "cost")
+            {
+                ScenarioCostModel& costModel = ret.CostModel;
+                if (!(tokens >> costModel.Base >> costModel.Tile >> costModel.Capture) || costModel.Base < 0.0 || costModel.Tile < 0.0 || costModel.Capture < 0.0)
+                {
+                    throw MakeException(sourceName, line, "Expected: cost <base milliseconds> <tile milliseconds> <capture milliseconds>");
+                }
+                ret.HasCostModel = true;
+            }
+            else if (keyword == "at")
+            {
+                double milliseconds;
+                std::string type;
+                PendingEvent event = {};
+                event.Line = line;
+                if (!(tokens >> milliseconds >> type) || milliseconds < 0.0)
+                {
+                    throw MakeException(sourceName, line, "Expected: at <milliseconds> focus|cursor|load ...");
+                }
+
+                if (type == "load")
+                {
+                    double load;
+                    if (!(tokens >> load) || load < 0.0)
+                    {
+                        throw MakeException(sourceName, line, "Expected: at <milliseconds> load <milliseconds per frame>");
+                    }
+
+                    ret.Loads.push_back({ (uint64_t)(milliseconds * 1'000'000.0), load });
+                    continue;
+                }
+
+                if (!(tokens >> event.Monitor))
+                {
+                    throw MakeException(sourceName, line, "Expected: at <milliseconds> focus|cursor <name>");
+                }
+
+                if (type == "focus")
+                {
+                    event.Type = SCENARIO_EVENT_FOCUS;
+                }
+                else if (type == "cursor")
+                {
+                    event.Type = SCENARIO_EVENT_CURSOR;
+                }
+                else
+                {
+                    throw MakeException(sourceName, line, "Unknown event type '" + type + "', expected focus, cursor, or load.");
+                }
+
+                event.Time = (uint64_t)(milliseconds * 1'000'000.0);
+                events.push_back(event);
+            }
+            else
+            {
+                throw MakeException(sourceName, line, "Unknown keyword '" + keyword + "'.");
+            }
+        }
+
+        if (ret.Monitors.empty())
+        {
+            throw std::runtime_error(sourceName + ": The scenario doesn't define any monitors.");
+        }
+
+        // Events refer to monitors by name, so they're only resolved once the monitors are in their final order
+        std::stable_sort(ret.Monitors.begin(), ret.Monitors.end(), [](const ScenarioMonitor& a, const ScenarioMonitor& b) { return a.Rectangle.Left < b.Rectangle.Left; });
+        std::stable_sort(events.begin(), events.end(), [](const PendingEvent& a, const PendingEvent& b) { return a.Time < b.Time; });
+        std::stable_sort(ret.Loads.begin(), ret.Loads.end(), [](const ScenarioLoad& a, const ScenarioLoad& b) { return a.Time < b.Time; });
+
+        for (PendingEvent& event : events)
+        {
+            ret.Events.push_back({ event.Time, event.Type, FindMonitor(ret.Monitors, event.Monitor, sourceName, event.Line) });
+        }
+
+        if (startMonitor.empty())
+        {
+            ret.StartMonitor = (uint32_t)(&ret.GetPrimaryMonitor() - ret.Monitors.data());
+        }
+        else
+        {
+            ret.StartMonitor = FindMonitor(ret.Monitors, startMonitor, sourceName, startLine);
+        }
+
+        return ret;
+    }
+
+    uint64_t Scenario::GetEndTime() const
+    {
+        uint64_t eventTime = Events.empty() ? 0 : Events.back().Time;
+        uint64_t loadTime = Loads.empty() ? 0 : Loads.back().Time;
+        return std::max(eventTime, loadTime);
+    }
+
+    const ScenarioMonitor& Scenario::GetPrimaryMonitor() const
+    {
+        // Like Monitor::GetPrimaryMonitor, the first monitor stands in when none of them are marked as primary
+        for (const ScenarioMonitor& monitor : Monitors)
+        {
+            if (monitor.IsPrimary)
+            {
+                return monitor;
+            }
+        }
+
+        return Monitors[0];
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <istream>
+#include <Rectangle.h>
+#include <RenderTransform.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace HydraSimulator
+{
+    struct ScenarioMonitor
+    {
+        std::string Name;
+        HydraCore::Rectangle Rectangle;
+        HydraCore::Margins Crop;
+        bool IsPrimary;
+        bool IsEnabled;
+    };
+
+    enum ScenarioEventType
+    {
+        SCENARIO_EVENT_FOCUS,
+        SCENARIO_EVENT_CURSOR,
+    };
+
+    struct ScenarioEvent
+    {
+        // Nanoseconds since the start of the scenario
+        uint64_t Time;
+        ScenarioEventType Type;
+        // Index into Scenario::Monitors
+        uint32_t Monitor;
+    };
+
+    // Synthetic render timings for exercising adaptive quality, in milliseconds per frame
+    struct ScenarioCostModel
+    {
+        // Paid every frame no matter what is drawn
+        double Base;
+        // Paid for every tile which is redrawn (throttled overview tiles which show their last drawing are free)
+        double Tile;
+        // Paid for every capture which is kept running
+        double Capture;
+    };
+
+    // From Time onwards, the rest of the program needs this long per frame, a frame lags when that and our cost don't fit in the frame
+    struct ScenarioLoad
+    {
+        uint64_t Time;
+        double Milliseconds;
+    };
+
+    // A monitor layout and a scripted sequence of focus and cursor changes, loaded from a text file like this:
+    //
+    //   # Monitors are listed as: monitor <name> <left> <top> <width> <height> [primary] [disabled] [crop <left> <top> <right> <bottom>]
+    //   monitor LEFT 0 0 1920 1080 primary
+    //   monitor RIGHT 1920 0 2560 1440 crop 0 0 0 40
+    //   # The monitor shown when the scenario starts (the primary monitor if omitted)
+    //   start LEFT
+    //   # Events are listed as: at <milliseconds> focus|cursor <name>
+    //   at 500 focus RIGHT
+    //   at 1200 cursor LEFT
+    //   # Optional synthetic timings in milliseconds: cost <base> <per redrawn tile> <per running capture>
+    //   cost 0.2 0.5 0.3
+    //   # Load from everything else in the program: at <milliseconds> load <milliseconds per frame>
+    //   at 2000 load 15
+    struct Scenario
+    {
+        // Sorted left to right, which is the order the plugin lays them out in
+        std::vector<ScenarioMonitor> Monitors;
+        // Sorted by time
+        std::vector<ScenarioEvent> Events;
+        uint32_t StartMonitor;
+
+        // Render timings are only simulated when the scenario has a cost model
+        bool HasCostModel;
+        ScenarioCostModel CostModel;
+        // Sorted by time, there's no load before the first one
+        std::vector<ScenarioLoad> Loads;
+
+        // These throw std::runtime_error describing the offending line if the scenario is invalid
+        static Scenario Load(const std::string& filePath);
+        static Scenario Parse(std::istream& input, const std::string& sourceName);
+
+        // The time of the last event or load change, or 0 if there are none
+        uint64_t GetEndTime() const;
+
+        // The monitor which sets the composite's size when it isn't given explicitly
+        const ScenarioMonitor& GetPrimaryMonitor() const;
+    };
+}
@@ -0,0 +1,289 @@
+#include "Simulation.h"
+
+#include <algorithm>
+#include <stdint.h>
+#include <TimelineAnimation.h>
+
+namespace HydraSimulator
+{
+    // When no duration is given, a transition which still hasn't settled this long after the last event is assumed to never settle
+    static const uint64_t MaximumSettleWait = 60'000'000'000;
+
+    // Matches how often the source publishes its statistics and feeds them to the frame budget governor
+    static const uint64_t StatisticsWindow = 1'000'000'000;
+
+    // The draws don't depend on the outline's color, as long as it's the same for the replayed and the live draws
+    static const float OutlineColor[4] = { 1.f, 1.f, 1.f, 1.f };
+
+    // The simulated monitors don't exist, so their handles are just their (1-based) index
+    static HydraCore::MonitorHandle GetMonitorHandle(uint32_t index)
+    {
+        return (HydraCore::MonitorHandle)(uintptr_t)(index + 1);
+    }
+
+    static uint32_t GetMonitorIndex(HydraCore::MonitorHandle handle)
+    {
+        return (uint32_t)((uintptr_t)handle - 1);
+    }
+
+    SimulationSummary RunSimulation(const Scenario& scenario, const SimulationSettings& settings, FrameWriter* writer)
+    {
+        SimulationSummary summary = {};
+        uint32_t monitorCount = (uint32_t)scenario.Monitors.size();
+
+        HydraCore::CompositeLayoutSettings layoutSettings = settings.Layout;
+        if (layoutSettings.Width == 0 || layoutSettings.Height == 0)
+        {
+            const ScenarioMonitor& primaryMonitor = scenario.GetPrimaryMonitor();
+            layoutSettings.Width = primaryMonitor.Rectangle.Width;
+            layoutSettings.Height = primaryMonitor.Rectangle.Height;
+        }
+
+        // Everything which the source only recomputes in Update (or when a child's size changes) is computed once up front
+        // Like the source, disabled monitors keep a physical index of 0.
+        std::vector<uint8_t> enabledMonitors;
+        std::vector<uint32_t> physicalIndices;
+        std::vector<HydraCore::RenderTransform> transforms;
+        uint32_t enabledCount = 0;
+        for (const ScenarioMonitor& monitor : scenario.Monitors)
+        {
+            enabledMonitors.push_back(monitor.IsEnabled);
+            physicalIndices.push_back(monitor.IsEnabled ? enabledCount++ : 0);
+            transforms.push_back(HydraCore::ComputeRenderTransform(monitor.Rectangle.Width, monitor.Rectangle.Height, monitor.Crop, layoutSettings.Width, layoutSettings.Height, settings.ScaleMode));
+        }
+
+        HydraCore::MonitorTrackingPolicy policy;
+        policy.SetMode(settings.TrackingMode, settings.DwellTime);
+
+        HydraCore::TimelineAnimation animation;
+        animation.SetVelocity(settings.AnimationSpeed);
+
+        HydraCore::CompositeLayout layout;
+
+        // Like ActiveMonitorSource::VideoTick, the cached layout and draws are only updated when their inputs change
+        HydraCore::CompositeLayout cachedLayout;
+        HydraCore::RenderCommandList renderCommands;
+        std::vector<HydraCore::RenderCommand> liveCommands;
+
+        HydraCore::FrameBudgetSettings frameBudgetSettings = HydraCore::GetDefaultFrameBudgetSettings();
+        frameBudgetSettings.BudgetFraction = settings.RenderBudget;
+        HydraCore::FrameBudgetGovernor frameBudget;
+        frameBudget.SetSettings(frameBudgetSettings);
+        std::vector<uint8_t> warmMonitors;
+        double frameMilliseconds = 1'000.0 / (double)settings.FrameRate;
+        size_t nextLoad = 0;
+        double load = 0.0;
+        uint64_t statisticsWindowStart = 0;
+        HydraCore::FrameBudgetSample sample = {};
+        sample.FrameMilliseconds = frameMilliseconds;
+
+        // Matches ActiveMonitorSource::ActiveMonitorChanged, a disabled monitor never becomes active and an unchanged target doesn't retarget the animation
+        uint32_t activeMonitor = 0;
+        auto activeMonitorChanged = [&](HydraCore::MonitorHandle handle, uint64_t timestamp)
+        {
+            uint32_t index = GetMonitorIndex(handle);
+            if (index < monitorCount && enabledMonitors[index])
+            {
+                activeMonitor = index;
+            }
+
+            float targetPosition = (float)(physicalIndices[activeMonitor] * layoutSettings.Width);
+            if (settings.AnimationEnabled && targetPosition != animation.GetTargetPosition())
+            {
+                animation.SetTargetPosition(targetPosition, timestamp);
+            }
+        };
+
+        // The source starts on the monitor it was told about, then the cursor tracker (if any) reports where the cursor starts
+        activeMonitorChanged(GetMonitorHandle(scenario.StartMonitor), 0);
+        animation.JumpToPosition((float)(physicalIndices[activeMonitor] * layoutSettings.Width));
+        policy.FocusChanged(GetMonitorHandle(scenario.StartMonitor), 0);
+        if (settings.TrackingMode != HydraCore::MONITOR_TRACKING_MODE_FOCUS)
+        {
+            policy.CursorChanged(GetMonitorHandle(scenario.StartMonitor), 0);
+        }
+
+        uint64_t quietTime = scenario.GetEndTime();
+        if (settings.TrackingMode == HydraCore::MONITOR_TRACKING_MODE_CURSOR_AFTER_DWELL)
+        {
+            quietTime += settings.DwellTime;
+        }
+
+        size_t nextEvent = 0;
+        bool transitionPending = false;
+        uint64_t transitionChangeTime = 0;
+
+        SimulationFrame frame = {};
+        frame.Layout = &layout;
+        frame.Transforms = &transforms;
+
+        for (uint64_t index = 0;; index++)
+        {
+            uint64_t time = index * 1'000'000'000 / settings.FrameRate;
+            if (settings.Duration != 0 && time > settings.Duration)
+            {
+                break;
+            }
+
+            // Anything the trackers observed since the last frame is handed to the policy before it makes its decision, like VideoTick draining its deferred events
+            for (; nextEvent < scenario.Events.size() && scenario.Events[nextEvent].Time <= time; nextEvent++)
+            {
+                const ScenarioEvent& event = scenario.Events[nextEvent];
+                if (event.Type == SCENARIO_EVENT_FOCUS)
+                {
+                    policy.FocusChanged(GetMonitorHandle(event.Monitor), event.Time);
+                }
+                else
+                {
+                    policy.CursorChanged(GetMonitorHandle(event.Monitor), event.Time);
+                }
+            }
+
+            HydraCore::MonitorHandle newMonitor;
+            uint64_t changeTimestamp;
+            if (policy.Update(time, newMonitor, changeTimestamp))
+            {
+                uint32_t previousMonitor = activeMonitor;
+                activeMonitorChanged(newMonitor, changeTimestamp);
+
+                if (activeMonitor != previousMonitor)
+                {
+                    summary.TransitionCount++;
+                    if (transitionPending)
+                    {
+                        summary.InterruptedCount++;
+                    }
+
+                    transitionPending = true;
+                    transitionChangeTime = changeTimestamp;
+                }
+            }
+
+            animation.UpdateToTime(time);
+            layout.Update(layoutSettings, enabledMonitors, activeMonitor, animation.GetCurrentPosition(), animation.IsAnimating());
+
+            // The settings never change during a run, so their version doesn't either
+            HydraCore::RenderCommandInputs renderInputs = {};
+            renderInputs.ActiveChild = activeMonitor;
+            renderInputs.Position = animation.GetCurrentPosition();
+            renderInputs.IsAnimating = animation.IsAnimating();
+            renderInputs.TileRefreshDivisor = layoutSettings.OverviewMode ? frameBudget.GetCurrentLevel().TileRefreshDivisor : 1;
+
+            if (renderCommands.NeedsRecording(renderInputs))
+            {
+                cachedLayout.Update(layoutSettings, enabledMonitors, activeMonitor, animation.GetCurrentPosition(), animation.IsAnimating());
+                renderCommands.Record(cachedLayout, renderInputs, OutlineColor);
+                summary.RecordedFrameCount++;
+            }
+
+            liveCommands.clear();
+            HydraCore::RecordComposite(layout, renderInputs, OutlineColor, liveCommands);
+            if (!HydraCore::AreRenderCommandsEqual(liveCommands, renderCommands.GetCommands()))
+            {
+                summary.CommandMismatchCount++;
+            }
+
+            frame.Index = index;
+            frame.Time = time;
+            frame.ActiveMonitor = activeMonitor;
+            frame.Position = animation.GetCurrentPosition();
+            frame.IsAnimating = animation.IsAnimating();
+            frame.TransitionSettled = transitionPending && !frame.IsAnimating;
+            frame.SettleTime = 0;
+
+            if (frame.TransitionSettled)
+            {
+                transitionPending = false;
+                frame.SettleTime = time > transitionChangeTime ? time - transitionChangeTime : 0;
+                summary.SettledCount++;
+                summary.TotalSettleTime += frame.SettleTime;
+                if (frame.SettleTime > summary.MaximumSettleTime)
+                {
+                    summary.MaximumSettleTime = frame.SettleTime;
+                }
+            }
+
+            frame.QualityDecision = HydraCore::FRAME_BUDGET_HOLD;
+            frame.QualityReason = nullptr;
+            if (scenario.HasCostModel)
+            {
+                const HydraCore::FrameBudgetLevel& level = frameBudget.GetCurrentLevel();
+                frame.QualityLevel = frameBudget.GetLevel();
+
+                // Like ActiveMonitorSource::RenderTiles, only the overview's other tiles are throttled
+                uint32_t refreshDivisor = layoutSettings.OverviewMode ? level.TileRefreshDivisor : 1;
+                uint32_t redrawnTileCount = 0;
+                for (const HydraCore::CompositeTile& tile : layout.GetTiles())
+                {
+                    if (tile.Child == activeMonitor || HydraCore::IsTileRefreshFrame(index, tile.Child, refreshDivisor))
+                    {
+                        redrawnTileCount++;
+                    }
+                }
+
+                HydraCore::SelectWarmChildren(enabledMonitors, layout, activeMonitor, level.WarmNeighborCount, warmMonitors);
+                uint32_t runningCaptureCount = 0;
+                for (uint8_t isWarm : warmMonitors)
+                {
+                    runningCaptureCount += isWarm ? 1 : 0;
+                }
+
+                const ScenarioCostModel& costModel = scenario.CostModel;
+                frame.RenderMilliseconds = costModel.Base + costModel.Tile * redrawnTileCount + costModel.Capture * runningCaptureCount;
+
+                for (; nextLoad < scenario.Loads.size() && scenario.Loads[nextLoad].Time <= time; nextLoad++)
+                {
+                    load = scenario.Loads[nextLoad].Milliseconds;
+                }
+
+                frame.Lagged = frame.RenderMilliseconds + load > frameMilliseconds;
+                summary.TotalRenderMilliseconds += frame.RenderMilliseconds;
+                summary.LaggedFrameCount += frame.Lagged ? 1 : 0;
+
+                sample.FrameCount++;
+                sample.RenderMilliseconds += frame.RenderMilliseconds;
+                sample.LaggedFrameCount += frame.Lagged ? 1 : 0;
+
+                // Like ActiveMonitorSource::PublishStatistics, the window closes on the first frame at least a window after the last one closed
+                if (time - statisticsWindowStart >= StatisticsWindow)
+                {
+                    statisticsWindowStart = time;
+                    sample.RenderMilliseconds /= (double)sample.FrameCount;
+
+                    if (settings.AdaptiveQuality)
+                    {
+                        frame.QualityDecision = frameBudget.Update(sample);
+                        if (frame.QualityDecision != HydraCore::FRAME_BUDGET_HOLD)
+                        {
+                            frame.QualityReason = frameBudget.GetReason();
+                            summary.QualityChangeCount++;
+                            summary.MaximumQualityLevel = std::max(summary.MaximumQualityLevel, frameBudget.GetLevel());
+                        }
+                    }
+
+                    sample.FrameCount = 0;
+                    sample.RenderMilliseconds = 0.0;
+                    sample.LaggedFrameCount = 0;
+                }
+            }
+
+            summary.FrameCount++;
+            if (frame.IsAnimating)
+            {
+                summary.AnimatingFrameCount++;
+            }
+
+            if (writer != nullptr)
+            {
+                writer->WriteFrame(scenario, frame);
+            }
+
+            if (settings.Duration == 0 && time >= quietTime && (!frame.IsAnimating || time >= quietTime + MaximumSettleWait))
+            {
+                break;
+            }
+        }
+
+        return summary;
+    }
+}
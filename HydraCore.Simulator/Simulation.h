@@ -0,0 +1,113 @@
+#pragma once
+#include <CompositeLayout.h>
+#include <FrameBudgetGovernor.h>
+#include <MonitorTrackingPolicy.h>
+#include <RenderCommandList.h>
+#include <RenderTransform.h>
+#include <stdint.h>
+#include <vector>
+
+#include "Scenario.h"
+
+namespace HydraSimulator
+{
+    // Mirrors the Hydra source's settings which affect what it draws
+    struct SimulationSettings
+    {
+        uint32_t FrameRate;
+        HydraCore::MonitorTrackingMode TrackingMode;
+        // Nanoseconds, only used by MONITOR_TRACKING_MODE_CURSOR_AFTER_DWELL
+        uint64_t DwellTime;
+        bool AnimationEnabled;
+        float AnimationSpeed;
+        // A width or height of 0 uses the primary monitor's (like "Use primary monitor size")
+        HydraCore::CompositeLayoutSettings Layout;
+        HydraCore::ScaleMode ScaleMode;
+        // Nanoseconds, 0 runs until everything has settled after the last event
+        uint64_t Duration;
+        // Runs the frame budget governor against the scenario's synthetic timings (which are simulated either way)
+        bool AdaptiveQuality;
+        // The fraction of each frame the source may spend rendering
+        double RenderBudget;
+    };
+
+    struct SimulationFrame
+    {
+        uint64_t Index;
+        uint64_t Time;
+        uint32_t ActiveMonitor;
+        float Position;
+        bool IsAnimating;
+        // Set on the frame where the composite came to rest on a newly chosen monitor
+        bool TransitionSettled;
+        // Nanoseconds from when the change was observed to the end of this frame's transition (only valid if TransitionSettled is set)
+        uint64_t SettleTime;
+
+        const HydraCore::CompositeLayout* Layout;
+        // Each monitor's transform within its tile, indexed like Scenario::Monitors
+        const std::vector<HydraCore::RenderTransform>* Transforms;
+
+        // These are only valid if the scenario has a cost model
+        // The quality level the frame was drawn at, and the frame's synthetic render cost in milliseconds
+        uint32_t QualityLevel;
+        double RenderMilliseconds;
+        // The frame didn't fit in the frame time along with the scenario's load
+        bool Lagged;
+        // Set on the frame which ended a statistics window the governor changed the level after, the new level applies from the next frame
+        HydraCore::FrameBudgetDecision QualityDecision;
+        const char* QualityReason;
+    };
+
+    struct SimulationSummary
+    {
+        uint64_t FrameCount;
+        uint64_t AnimatingFrameCount;
+        // Every time the visible monitor changed
+        uint32_t TransitionCount;
+        // Transitions which were retargeted before they settled, these don't have a settle time of their own
+        uint32_t InterruptedCount;
+        uint32_t SettledCount;
+        uint64_t TotalSettleTime;
+        uint64_t MaximumSettleTime;
+        // Only counted if the scenario has a cost model
+        uint64_t LaggedFrameCount;
+        uint32_t QualityChangeCount;
+        uint32_t MaximumQualityLevel;
+        double TotalRenderMilliseconds;
+        // Frames where the source would have had to record its draws again, it replays them on every other frame
+        uint64_t RecordedFrameCount;
+        // Frames where the replayed draws differed from draws recorded from scratch, this should always be 0
+        uint64_t CommandMismatchCount;
+
+        inline double GetMeanSettleMilliseconds() const
+        {
+            return SettledCount == 0 ? 0.0 : (double)TotalSettleTime / (double)SettledCount / 1'000'000.0;
+        }
+
+        inline double GetMaximumSettleMilliseconds() const
+        {
+            return (double)MaximumSettleTime / 1'000'000.0;
+        }
+
+        inline double GetMeanRenderMilliseconds() const
+        {
+            return FrameCount == 0 ? 0.0 : TotalRenderMilliseconds / (double)FrameCount;
+        }
+    };
+
+    class FrameWriter
+    {
+    public:
+        virtual ~FrameWriter()
+        {
+        }
+
+        virtual void WriteFrame(const Scenario& scenario, const SimulationFrame& frame) = 0;
+    };
+
+    // Runs the tracking policy, the animation, and the layout over the scenario the same way the source does from VideoTick.
+    // With a cost model, the frame budget governor is also fed the synthetic timings once per second like the source feeds it its statistics.
+    // Every frame, the draws the source would replay are checked against draws recorded from scratch (see SimulationSummary::CommandMismatchCount.)
+    // Frames are passed to the writer (if any) as they're simulated, nothing is allocated per frame so large sweeps stay fast.
+    SimulationSummary RunSimulation(const Scenario& scenario, const SimulationSettings& settings, FrameWriter* writer);
+}
@@ -0,0 +1,121 @@
+#include "TimelineWriter.h"
+
+namespace HydraSimulator
+{
+    static double ToMilliseconds(uint64_t nanoseconds)
+    {
+        return (double)nanoseconds / 1'000'000.0;
+    }
+
+    CsvTimelineWriter::CsvTimelineWriter(FILE* file)
+    {
+        this->file = file;
+        fprintf(file, "frame,time_ms,active,position,animating,settle_ms,outline_x,child,x,y,width,height,source_x,source_y,source_width,source_height,scale_path,quality,render_ms,lagged\n");
+    }
+
+    void CsvTimelineWriter::WriteFrame(const Scenario& scenario, const SimulationFrame& frame)
+    {
+        // Empty cells mean the frame didn't settle a transition or has no outline
+        char settle[32] = "";
+        if (frame.TransitionSettled)
+        {
+            snprintf(settle, sizeof(settle), "%.3f", ToMilliseconds(frame.SettleTime));
+        }
+
+        char outline[32] = "";
+        if (frame.Layout->IsOutlineVisible())
+        {
+            snprintf(outline, sizeof(outline), "%.2f", frame.Layout->GetOutline().X);
+        }
+
+        // The quality columns are empty when the scenario has no cost model
+        char quality[64] = "";
+        if (scenario.HasCostModel)
+        {
+            snprintf(quality, sizeof(quality), "%u,%.3f,%d", frame.QualityLevel, frame.RenderMilliseconds, frame.Lagged ? 1 : 0);
+        }
+        else
+        {
+            snprintf(quality, sizeof(quality), ",,");
+        }
+
+        for (const HydraCore::CompositeTile& tile : frame.Layout->GetTiles())
+        {
+            const HydraCore::RenderTransform& transform = (*frame.Transforms)[tile.Child];
+            fprintf
+            (
+                file, "%llu,%.3f,%s,%.2f,%d,%s,%s,%s,%.2f,%.2f,%.2f,%.2f,%u,%u,%u,%u,%s,%s\n",
+                (unsigned long long)frame.Index, ToMilliseconds(frame.Time), scenario.Monitors[frame.ActiveMonitor].Name.c_str(), frame.Position, frame.IsAnimating ? 1 : 0, settle, outline,
+                scenario.Monitors[tile.Child].Name.c_str(), tile.X + transform.X, tile.Y + transform.Y, transform.Width, transform.Height,
+                transform.SourceX, transform.SourceY, transform.SourceWidth, transform.SourceHeight, HydraCore::GetScalePathName(transform.Path), quality
+            );
+        }
+    }
+
+    JsonTimelineWriter::JsonTimelineWriter(FILE* file)
+    {
+        this->file = file;
+    }
+
+    void JsonTimelineWriter::WriteFrame(const Scenario& scenario, const SimulationFrame& frame)
+    {
+        // Monitor names come from a whitespace-separated scenario file and are written as-is, so they're assumed not to need escaping
+        fprintf
+        (
+            file, "{\"frame\":%llu,\"time\":%.3f,\"active\":\"%s\",\"position\":%.2f,\"animating\":%s,",
+            (unsigned long long)frame.Index, ToMilliseconds(frame.Time), scenario.Monitors[frame.ActiveMonitor].Name.c_str(), frame.Position, frame.IsAnimating ? "true" : "false"
+        );
+
+        if (frame.TransitionSettled)
+        {
+            fprintf(file, "\"settle\":%.3f,", ToMilliseconds(frame.SettleTime));
+        }
+        else
+        {
+            fprintf(file, "\"settle\":null,");
+        }
+
+        if (frame.Layout->IsOutlineVisible())
+        {
+            const HydraCore::CompositeOutline& outline = frame.Layout->GetOutline();
+            fprintf(file, "\"outline\":{\"x\":%.2f,\"y\":%.2f,\"width\":%u,\"height\":%u,\"thickness\":%u},", outline.X, outline.Y, outline.Width, outline.Height, outline.Thickness);
+        }
+        else
+        {
+            fprintf(file, "\"outline\":null,");
+        }
+
+        // The governor's reasons are plain text without quotes or backslashes
+        if (scenario.HasCostModel)
+        {
+            fprintf(file, "\"quality\":{\"level\":%u,\"render\":%.3f,\"lagged\":%s,", frame.QualityLevel, frame.RenderMilliseconds, frame.Lagged ? "true" : "false");
+            if (frame.QualityDecision != HydraCore::FRAME_BUDGET_HOLD)
+            {
+                fprintf(file, "\"change\":\"%s\"},", frame.QualityReason);
+            }
+            else
+            {
+                fprintf(file, "\"change\":null},");
+            }
+        }
+        else
+        {
+            fprintf(file, "\"quality\":null,");
+        }
+
+        fprintf(file, "\"tiles\":[");
+        bool first = true;
+        for (const HydraCore::CompositeTile& tile : frame.Layout->GetTiles())
+        {
+            const HydraCore::RenderTransform& transform = (*frame.Transforms)[tile.Child];
+            fprintf
+            (
+                file, "%s{\"child\":\"%s\",\"x\":%.2f,\"y\":%.2f,\"width\":%.2f,\"height\":%.2f,\"source\":[%u,%u,%u,%u],\"path\":\"%s\"}",
+                first ? "" : ",", scenario.Monitors[tile.Child].Name.c_str(), tile.X + transform.X, tile.Y + transform.Y, transform.Width, transform.Height,
+                transform.SourceX, transform.SourceY, transform.SourceWidth, transform.SourceHeight, HydraCore::GetScalePathName(transform.Path)
+            );
+            first = false;
+        }
+        fprintf(file, "]}\n");
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <stdio.h>
+
+#include "Simulation.h"
+
+namespace HydraSimulator
+{
+    // One row per tile per frame, frame-level columns are repeated on each of the frame's rows
+    class CsvTimelineWriter : public FrameWriter
+    {
+    private:
+        FILE* file;
+    public:
+        CsvTimelineWriter(FILE* file);
+        void WriteFrame(const Scenario& scenario, const SimulationFrame& frame) override;
+    };
+
+    // One JSON object per frame, one frame per line
+    class JsonTimelineWriter : public FrameWriter
+    {
+    private:
+        FILE* file;
+    public:
+        JsonTimelineWriter(FILE* file);
+        void WriteFrame(const Scenario& scenario, const SimulationFrame& frame) override;
+    };
+}
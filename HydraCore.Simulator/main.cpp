@@ -0,0 +1,419 @@
+#include "Scenario.h"
+#include "Simulation.h"
+#include "TimelineWriter.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+using namespace HydraSimulator;
+
+static void PrintUsage(const char* programName)
+{
+    printf("Usage: %s <scenario> [options]\n", programName);
+    printf("  --fps <values>                Frame rate (default 60)\n");
+    printf("  --mode focus|cursor|dwell     What to follow, dwell lets the cursor win after resting (default focus)\n");
+    printf("  --dwell <values>              Cursor delay in milliseconds for the dwell mode (default 500)\n");
+    printf("  --speed <values>              Animation speed in pixels per second (default 7680)\n");
+    printf("  --no-animation                Switch monitors without sliding\n");
+    printf("  --overview                    Simulate overview mode\n");
+    printf("  --no-outline                  Hide the overview outline\n");
+    printf("  --outline-thickness <pixels>  Overview outline thickness (default 10)\n");
+    printf("  --width <pixels>              Size of the composite (default is the primary monitor's size)\n");
+    printf("  --height <pixels>\n");
+    printf("  --scale-mode stretch|fit|fill How monitors of other sizes are scaled (default stretch)\n");
+    printf("  --duration <milliseconds>     How long to simulate (default is until the last event has settled)\n");
+    printf("  --adaptive-quality            Run the frame budget governor against the scenario's cost model\n");
+    printf("  --budget <values>             Render budget in percent of the frame time (default 25)\n");
+    printf("  --format csv|json             Timeline format (default csv)\n");
+    printf("  --output <file>               Write to <file> instead of standard output\n");
+    printf("\n");
+    printf("<values> is a number, a comma-separated list (30,60), or a range (1000:20000:500).\n");
+    printf("Giving more than one value simulates every combination and writes a CSV summary row for each instead of a timeline.\n");
+}
+
+// Parses a single value, a list, or an inclusive range
+static bool ParseValues(const char* text, std::vector<double>& values)
+{
+    values.clear();
+
+    // Numbers are separated by commas in a list or colons in a range, but the two can't be mixed
+    char separator = '\0';
+    const char* cursor = text;
+    while (true)
+    {
+        char* valueEnd;
+        double value = strtod(cursor, &valueEnd);
+        if (valueEnd == cursor)
+        {
+            return false;
+        }
+
+        values.push_back(value);
+        if (*valueEnd == '\0')
+        {
+            break;
+        }
+
+        if ((*valueEnd != ',' && *valueEnd != ':') || (separator != '\0' && *valueEnd != separator))
+        {
+            return false;
+        }
+
+        separator = *valueEnd;
+        cursor = valueEnd + 1;
+    }
+
+    if (separator != ':')
+    {
+        return true;
+    }
+
+    if (values.size() != 3)
+    {
+        return false;
+    }
+
+    double start = values[0];
+    double end = values[1];
+    double step = values[2];
+    if (step <= 0.0 || end < start)
+    {
+        return false;
+    }
+
+    // The count is computed up front so floating point steps don't drop the last value
+    uint64_t count = (uint64_t)((end - start) / step + 1e-9) + 1;
+    values.clear();
+    for (uint64_t i = 0; i < count; i++)
+    {
+        values.push_back(start + step * (double)i);
+    }
+
+    return true;
+}
+
+static bool ParseUInt(const char* text, uint32_t& value)
+{
+    char* end;
+    unsigned long parsed = strtoul(text, &end, 10);
+    value = (uint32_t)parsed;
+    return end != text && *end == '\0';
+}
+
+// Passes frames through to another writer and reports the frame budget governor's decisions as they happen
+class QualityLogWriter : public FrameWriter
+{
+private:
+    FrameWriter* writer;
+public:
+    QualityLogWriter(FrameWriter* writer)
+    {
+        this->writer = writer;
+    }
+
+    void WriteFrame(const Scenario& scenario, const SimulationFrame& frame) override
+    {
+        if (frame.QualityDecision != HydraCore::FRAME_BUDGET_HOLD)
+        {
+            fprintf
+            (
+                stderr, "%.3f ms: %s quality to level %u: %s\n",
+                (double)frame.Time / 1'000'000.0, frame.QualityDecision == HydraCore::FRAME_BUDGET_LOWER ? "Lowered" : "Raised",
+                frame.QualityLevel + (frame.QualityDecision == HydraCore::FRAME_BUDGET_LOWER ? 1 : -1), frame.QualityReason
+            );
+        }
+
+        writer->WriteFrame(scenario, frame);
+    }
+};
+
+static void WriteSummaryHeader(FILE* file)
+{
+    fprintf(file, "fps,speed,dwell_ms,budget_percent,frames,animating_frames,transitions,interrupted,settled,mean_settle_ms,max_settle_ms,mean_render_ms,lagged_frames,quality_changes,max_quality\n");
+}
+
+static void WriteSummary(FILE* file, const SimulationSettings& settings, const SimulationSummary& summary)
+{
+    fprintf
+    (
+        file, "%u,%.1f,%.1f,%.1f,%llu,%llu,%u,%u,%u,%.3f,%.3f,%.3f,%llu,%u,%u\n",
+        settings.FrameRate, settings.AnimationSpeed, (double)settings.DwellTime / 1'000'000.0, settings.RenderBudget * 100.0,
+        (unsigned long long)summary.FrameCount, (unsigned long long)summary.AnimatingFrameCount,
+        summary.TransitionCount, summary.InterruptedCount, summary.SettledCount, summary.GetMeanSettleMilliseconds(), summary.GetMaximumSettleMilliseconds(),
+        summary.GetMeanRenderMilliseconds(), (unsigned long long)summary.LaggedFrameCount, summary.QualityChangeCount, summary.MaximumQualityLevel
+    );
+}
+
+// Replaying the recorded draws has to give exactly what recording them every frame would
+static void CheckRenderCommands(const SimulationSummary& summary)
+{
+    if (summary.CommandMismatchCount > 0)
+    {
+        throw std::runtime_error("The replayed draws differed from the live ones on " + std::to_string(summary.CommandMismatchCount) + " frames.");
+    }
+}
+
+static int Run(int argc, char* argv[])
+{
+    const char* scenarioPath = nullptr;
+    const char* outputPath = nullptr;
+    bool json = false;
+
+    std::vector<double> frameRates = { 60.0 };
+    std::vector<double> speeds = { 1920.0 * 4.0 };
+    std::vector<double> dwellTimes = { 500.0 };
+    std::vector<double> budgets = { 25.0 };
+
+    SimulationSettings settings = {};
+    settings.TrackingMode = HydraCore::MONITOR_TRACKING_MODE_FOCUS;
+    settings.AnimationEnabled = true;
+    settings.Layout.OutlineEnabled = true;
+    settings.Layout.OutlineThickness = 10;
+    settings.ScaleMode = HydraCore::SCALE_MODE_STRETCH;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* argument = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool valid = true;
+
+        if (strcmp(argument, "--no-animation") == 0)
+        {
+            settings.AnimationEnabled = false;
+            continue;
+        }
+        else if (strcmp(argument, "--overview") == 0)
+        {
+            settings.Layout.OverviewMode = true;
+            continue;
+        }
+        else if (strcmp(argument, "--no-outline") == 0)
+        {
+            settings.Layout.OutlineEnabled = false;
+            continue;
+        }
+        else if (strcmp(argument, "--adaptive-quality") == 0)
+        {
+            settings.AdaptiveQuality = true;
+            continue;
+        }
+        else if (strcmp(argument, "--help") == 0)
+        {
+            PrintUsage(argv[0]);
+            return 0;
+        }
+        else if (argument[0] != '-')
+        {
+            valid = scenarioPath == nullptr;
+            scenarioPath = argument;
+            value = nullptr;
+        }
+        else if (value == nullptr)
+        {
+            valid = false;
+        }
+        else if (strcmp(argument, "--fps") == 0)
+        {
+            valid = ParseValues(value, frameRates);
+        }
+        else if (strcmp(argument, "--speed") == 0)
+        {
+            valid = ParseValues(value, speeds);
+        }
+        else if (strcmp(argument, "--dwell") == 0)
+        {
+            valid = ParseValues(value, dwellTimes);
+        }
+        else if (strcmp(argument, "--budget") == 0)
+        {
+            valid = ParseValues(value, budgets);
+        }
+        else if (strcmp(argument, "--mode") == 0)
+        {
+            if (strcmp(value, "focus") == 0) { settings.TrackingMode = HydraCore::MONITOR_TRACKING_MODE_FOCUS; }
+            else if (strcmp(value, "cursor") == 0) { settings.TrackingMode = HydraCore::MONITOR_TRACKING_MODE_CURSOR; }
+            else if (strcmp(value, "dwell") == 0) { settings.TrackingMode = HydraCore::MONITOR_TRACKING_MODE_CURSOR_AFTER_DWELL; }
+            else { valid = false; }
+        }
+        else if (strcmp(argument, "--scale-mode") == 0)
+        {
+            if (strcmp(value, "stretch") == 0) { settings.ScaleMode = HydraCore::SCALE_MODE_STRETCH; }
+            else if (strcmp(value, "fit") == 0) { settings.ScaleMode = HydraCore::SCALE_MODE_FIT; }
+            else if (strcmp(value, "fill") == 0) { settings.ScaleMode = HydraCore::SCALE_MODE_FILL; }
+            else { valid = false; }
+        }
+        else if (strcmp(argument, "--outline-thickness") == 0)
+        {
+            valid = ParseUInt(value, settings.Layout.OutlineThickness);
+        }
+        else if (strcmp(argument, "--width") == 0)
+        {
+            valid = ParseUInt(value, settings.Layout.Width);
+        }
+        else if (strcmp(argument, "--height") == 0)
+        {
+            valid = ParseUInt(value, settings.Layout.Height);
+        }
+        else if (strcmp(argument, "--duration") == 0)
+        {
+            uint32_t milliseconds;
+            valid = ParseUInt(value, milliseconds);
+            settings.Duration = (uint64_t)milliseconds * 1'000'000;
+        }
+        else if (strcmp(argument, "--format") == 0)
+        {
+            json = strcmp(value, "json") == 0;
+            valid = json || strcmp(value, "csv") == 0;
+        }
+        else if (strcmp(argument, "--output") == 0)
+        {
+            outputPath = value;
+        }
+        else
+        {
+            valid = false;
+        }
+
+        if (!valid)
+        {
+            fprintf(stderr, "Invalid argument '%s'%s%s\n\n", argument, value != nullptr ? " " : "", value != nullptr ? value : "");
+            PrintUsage(argv[0]);
+            return 1;
+        }
+
+        if (value != nullptr)
+        {
+            i++;
+        }
+    }
+
+    if (scenarioPath == nullptr)
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    for (double frameRate : frameRates)
+    {
+        if (frameRate < 1.0)
+        {
+            throw std::runtime_error("Frame rates must be at least 1.");
+        }
+    }
+
+    for (double speed : speeds)
+    {
+        if (speed <= 0.0)
+        {
+            throw std::runtime_error("Animation speeds must be positive.");
+        }
+    }
+
+    for (double budget : budgets)
+    {
+        if (budget <= 0.0)
+        {
+            throw std::runtime_error("Render budgets must be positive.");
+        }
+    }
+
+    Scenario scenario = Scenario::Load(scenarioPath);
+
+    FILE* output = stdout;
+    if (outputPath != nullptr)
+    {
+        output = fopen(outputPath, "w");
+        if (output == nullptr)
+        {
+            throw std::runtime_error(std::string("Could not open '") + outputPath + "' for writing.");
+        }
+    }
+
+    // A single combination gets a full timeline, a sweep only gets a summary of each combination
+    size_t combinationCount = frameRates.size() * speeds.size() * dwellTimes.size() * budgets.size();
+    if (combinationCount == 1)
+    {
+        settings.FrameRate = (uint32_t)frameRates[0];
+        settings.AnimationSpeed = (float)speeds[0];
+        settings.DwellTime = (uint64_t)(dwellTimes[0] * 1'000'000.0);
+        settings.RenderBudget = budgets[0] / 100.0;
+
+        FrameWriter* writer = json ? (FrameWriter*)new JsonTimelineWriter(output) : (FrameWriter*)new CsvTimelineWriter(output);
+        QualityLogWriter qualityLogWriter(writer);
+        SimulationSummary summary = RunSimulation(scenario, settings, &qualityLogWriter);
+        delete writer;
+        CheckRenderCommands(summary);
+
+        fprintf
+        (
+            stderr, "%llu frames, %u transitions (%u interrupted), settled in %.3f ms on average and %.3f ms at most\n",
+            (unsigned long long)summary.FrameCount, summary.TransitionCount, summary.InterruptedCount, summary.GetMeanSettleMilliseconds(), summary.GetMaximumSettleMilliseconds()
+        );
+        fprintf(stderr, "Draws were recorded on %llu frames and replayed on the rest\n", (unsigned long long)summary.RecordedFrameCount);
+
+        if (scenario.HasCostModel)
+        {
+            fprintf
+            (
+                stderr, "Rendering took %.3f ms/frame on average, %llu frames lagged, quality changed %u times (level %u at worst)\n",
+                summary.GetMeanRenderMilliseconds(), (unsigned long long)summary.LaggedFrameCount, summary.QualityChangeCount, summary.MaximumQualityLevel
+            );
+        }
+    }
+    else
+    {
+        WriteSummaryHeader(output);
+        uint64_t frameCount = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (double frameRate : frameRates)
+        {
+            for (double speed : speeds)
+            {
+                for (double dwellTime : dwellTimes)
+                {
+                    for (double budget : budgets)
+                    {
+                        settings.FrameRate = (uint32_t)frameRate;
+                        settings.AnimationSpeed = (float)speed;
+                        settings.DwellTime = (uint64_t)(dwellTime * 1'000'000.0);
+                        settings.RenderBudget = budget / 100.0;
+
+                        SimulationSummary summary = RunSimulation(scenario, settings, nullptr);
+                        CheckRenderCommands(summary);
+                        WriteSummary(output, settings, summary);
+                        frameCount += summary.FrameCount;
+                    }
+                }
+            }
+        }
+
+        double milliseconds = (double)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1'000.0;
+        fprintf(stderr, "Simulated %zu combinations (%llu frames) in %.1f ms\n", combinationCount, (unsigned long long)frameCount, milliseconds);
+    }
+
+    if (output != stdout && fclose(output) != 0)
+    {
+        throw std::runtime_error(std::string("Failed to write '") + outputPath + "'.");
+    }
+
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        return Run(argc, argv);
+    }
+    catch (const std::exception& exception)
+    {
+        fprintf(stderr, "%s\n", exception.what());
+        return 1;
+    }
+}
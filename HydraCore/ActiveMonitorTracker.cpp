@@ -1,102 +1,69 @@
 #include "ActiveMonitorTracker.h"
-#include "Win32Exception.h"
 
 namespace HydraCore
 {
-    static ActiveMonitorTracker* instance = nullptr;
+    ActiveMonitorTracker* ActiveMonitorTracker::instance = nullptr;
 
-    ActiveMonitorTracker::ActiveMonitorTracker()
+    ActiveMonitorTracker::ActiveMonitorTracker(DisplayPlatform* platform)
+        : filter(platform)
     {
-        instance = this;
+        this->platform = platform;
 
         // Set the initially active monitor
-        HWND activeWindow = GetForegroundWindow();
-        if (activeWindow == NULL)
-        {
-            activeWindow = GetDesktopWindow();
-        }
-        UpdateActiveMonitor(activeWindow);
-
-        // Start the event processing thread
-        threadHandle = CreateThread(NULL, 0, ActiveMonitorTracker::MonitorThreadEntry, this, 0, NULL);
+        activeMonitor.store(platform->GetActiveMonitor(), std::memory_order_relaxed);
 
-        if (threadHandle == NULL)
-        {
-            throw Win32Exception();
-        }
+        // Follow the platform's events
+        platformSubscription = platform->SubscribeActiveMonitorChanged(this, &ActiveMonitorTracker::PlatformActiveMonitorChanged);
+        windowDestroyedSubscription = platform->SubscribeWindowDestroyed(this, &ActiveMonitorTracker::PlatformWindowDestroyed);
+        platform->StartEvents();
     }
 
-    DWORD WINAPI ActiveMonitorTracker::MonitorThreadEntry(LPVOID _this)
+    ActiveMonitorTracker::~ActiveMonitorTracker()
     {
-        ((ActiveMonitorTracker*)_this)->MonitorThreadEntry();
-        return 0;
+        platform->UnsubscribeActiveMonitorChanged(platformSubscription);
+        platform->UnsubscribeWindowDestroyed(windowDestroyedSubscription);
     }
 
-    void ActiveMonitorTracker::UpdateActiveMonitor(HWND activeWindow)
+    void ActiveMonitorTracker::PlatformActiveMonitorChanged(WindowId window, MonitorHandle newMonitor, uint64_t timestamp)
     {
-        // Get the active monitor from the active window
-        HMONITOR newMonitor = MonitorFromWindow(activeWindow, MONITOR_DEFAULTTONEAREST);
-
-        // Update the active monitor
-        ActiveMonitorTracker* tracker = ActiveMonitorTracker::GetInstance();
+        if (window != 0 && filter.ShouldIgnore(window))
+        {
+            return;
+        }
 
-        if (tracker->activeMonitor == newMonitor)
+        if (activeMonitor.exchange(newMonitor, std::memory_order_relaxed) == newMonitor)
         {
             return;
         }
 
-        tracker->activeMonitor = newMonitor;
-        tracker->activeMonitorChangedEvent.Dispatch();
+        activeMonitorChangedEvent.Dispatch(newMonitor, timestamp);
     }
 
-    void CALLBACK ActiveMonitorTracker::ProcessHookEvent(HWINEVENTHOOK eventHook, DWORD event, HWND activeWindow, LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime)
+    void ActiveMonitorTracker::PlatformWindowDestroyed(WindowId window)
     {
-        UpdateActiveMonitor(activeWindow);
+        filter.Forget(window);
     }
 
-    void ActiveMonitorTracker::MonitorThreadEntry()
+    void ActiveMonitorTracker::UnsubscribeActiveMonitorChanged(EventSubscriptionHandle subscriptionHandle)
     {
-        // Register for events
-        HWINEVENTHOOK forgroundWindowChangedEventHook = SetWinEventHook(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, NULL, ProcessHookEvent, 0, 0, WINEVENT_OUTOFCONTEXT);
-        if (forgroundWindowChangedEventHook == NULL)
-        {
-            throw Win32Exception();
-        }
-
-        HWINEVENTHOOK windowMovedEventHook = SetWinEventHook(EVENT_SYSTEM_MOVESIZEEND, EVENT_SYSTEM_MOVESIZEEND, NULL, ProcessHookEvent, 0, 0, WINEVENT_OUTOFCONTEXT);
-        if (windowMovedEventHook == NULL)
-        {
-            throw Win32Exception();
-        }
-
-        // Process events
-        MSG message;
-        while (GetMessage(&message, nullptr, 0, 0))
-        {
-            TranslateMessage(&message);
-            DispatchMessage(&message);
-        }
-
-        // Stop processing events
-        UnhookWinEvent(forgroundWindowChangedEventHook);
-        UnhookWinEvent(windowMovedEventHook);
+        activeMonitorChangedEvent.Unsubscribe(subscriptionHandle);
     }
 
-    void ActiveMonitorTracker::UnsubscribeActiveMonitorChanged(EventSubscriptionHandle subscriptionHandle)
+    MonitorHandle ActiveMonitorTracker::GetActiveMonitorHandle()
     {
-        activeMonitorChangedEvent.Unsubscribe(subscriptionHandle);
+        return activeMonitor.load(std::memory_order_relaxed);
     }
 
-    HMONITOR ActiveMonitorTracker::GetActiveMonitorHandle()
+    void ActiveMonitorTracker::RestoreActiveMonitor(MonitorHandle monitor)
     {
-        return activeMonitor;
+        activeMonitor.store(monitor, std::memory_order_relaxed);
     }
 
     ActiveMonitorTracker* ActiveMonitorTracker::GetInstance()
     {
         if (instance == nullptr)
         {
-            new ActiveMonitorTracker();
+            instance = new ActiveMonitorTracker(DisplayPlatform::GetCurrent());
         }
 
         return instance;
@@ -1,36 +1,98 @@
 #pragma once
-#include <Windows.h>
+#include <atomic>
 
+#include "DeferredEvent.h"
+#include "DisplayPlatform.h"
 #include "Event.h"
+#include "Monitor.h"
+#include "WindowFilter.h"
 
 namespace HydraCore
 {
+    struct ActiveMonitorChange
+    {
+        MonitorHandle Monitor;
+        uint64_t Timestamp;
+    };
+
     class ActiveMonitorTracker
     {
     private:
-        Event activeMonitorChangedEvent;
+        static ActiveMonitorTracker* instance;
 
-        HMONITOR activeMonitor;
-        HANDLE threadHandle;
+        DisplayPlatform* platform;
+        EventSubscriptionHandle platformSubscription;
+        EventSubscriptionHandle windowDestroyedSubscription;
+        WindowFilter filter;
 
-        ActiveMonitorTracker();
+        Event<MonitorHandle, uint64_t> activeMonitorChangedEvent;
 
-        static DWORD WINAPI MonitorThreadEntry(LPVOID _this);
-        void MonitorThreadEntry();
+        // Written by the platform's event thread, and by RestoreActiveMonitor on the caller's thread
+        std::atomic<MonitorHandle> activeMonitor;
 
-        static void UpdateActiveMonitor(HWND activeWindow);
-        static void CALLBACK ProcessHookEvent(HWINEVENTHOOK eventHook, DWORD event, HWND activeWindow, LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime);
+        // Records the new active monitor and notifies subscribers if it changed
+        void PlatformActiveMonitorChanged(WindowId window, MonitorHandle newMonitor, uint64_t timestamp);
+        void PlatformWindowDestroyed(WindowId window);
     public:
+        // The tracker starts the platform's events and follows them until it is destroyed
+        ActiveMonitorTracker(DisplayPlatform* platform);
+        ~ActiveMonitorTracker();
+
+        // Handlers receive the new active monitor and the timestamp (on the platform's clock) at which the change was observed
         template<class TTarget>
-        EventSubscriptionHandle SubscribeActiveMonitorChanged(TTarget* targetObject, typename EventHandler<TTarget>::TargetMethodType targetMethod)
+        EventSubscriptionHandle SubscribeActiveMonitorChanged(TTarget* targetObject, void (TTarget::*targetMethod)(MonitorHandle newMonitor, uint64_t timestamp))
         {
             return activeMonitorChangedEvent.Subscribe(targetObject, targetMethod);
         }
 
+        template<class TCallable>
+        EventSubscriptionHandle SubscribeActiveMonitorChanged(TCallable callable)
+        {
+            return activeMonitorChangedEvent.Subscribe(callable);
+        }
+
+        // Subscribes a deferred event to active monitor changes, the platform's event thread will only record the change under the given key
+        template<class TKey, size_t Capacity>
+        EventSubscriptionHandle SubscribeActiveMonitorChangedDeferred(DeferredEvent<TKey, ActiveMonitorChange, Capacity>* deferredEvent, TKey key)
+        {
+            return activeMonitorChangedEvent.Subscribe([deferredEvent, key](MonitorHandle newMonitor, uint64_t timestamp)
+            {
+                deferredEvent->Dispatch(key, { newMonitor, timestamp });
+            });
+        }
+
         void UnsubscribeActiveMonitorChanged(EventSubscriptionHandle subscriptionHandle);
 
-        HMONITOR GetActiveMonitorHandle();
+        MonitorHandle GetActiveMonitorHandle();
+
+        // Makes the tracker consider the given monitor active (IE: one a source restored when it was loaded) until the next focus change
+        // Focus changes are only dispatched when the monitor changes, so without this focusing a window on the real active monitor would be ignored.
+        void RestoreActiveMonitor(MonitorHandle monitor);
+
+        // Focusing (or moving) a window from one of these executables or with one of these window classes won't change the active monitor
+        // This applies to every subscriber of the tracker.
+        inline void SetIgnoredWindows(const std::vector<std::string>& ignoredExecutables, const std::vector<std::string>& ignoredWindowClasses)
+        {
+            filter.SetRules(ignoredExecutables, ignoredWindowClasses);
+        }
+
+        inline WindowFilterStatistics GetFilterStatistics()
+        {
+            return filter.GetStatistics();
+        }
+
+        // See DisplayPlatform::SetLiveDragInterval, this applies to every subscriber of the tracker.
+        inline void SetLiveDragInterval(uint64_t interval)
+        {
+            platform->SetLiveDragInterval(interval);
+        }
+
+        inline LiveDragStatistics GetLiveDragStatistics()
+        {
+            return platform->GetLiveDragStatistics();
+        }
 
+        // Gets the shared tracker for the current platform (see DisplayPlatform::GetCurrent), which lives for the rest of the process
         static ActiveMonitorTracker* GetInstance();
     };
 }
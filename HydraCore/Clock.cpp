@@ -0,0 +1,12 @@
+#include "Clock.h"
+
+#include <chrono>
+
+namespace HydraCore
+{
+    uint64_t GetTimestamp()
+    {
+        // steady_clock is QueryPerformanceCounter on Windows and CLOCK_MONOTONIC elsewhere, which is what OBS uses too
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include <stdint.h>
+
+namespace HydraCore
+{
+    // Gets a monotonic timestamp in nanoseconds
+    // This is based on the same clock as OBS's os_gettime_ns, so timestamps can be compared against OBS frame times.
+    uint64_t GetTimestamp();
+}
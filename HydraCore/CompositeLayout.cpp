@@ -0,0 +1,45 @@
+#include "CompositeLayout.h"
+
+namespace HydraCore
+{
+    CompositeLayout::CompositeLayout()
+    {
+        outline = {};
+        isOutlineVisible = false;
+    }
+
+    void CompositeLayout::Update(const CompositeLayoutSettings& settings, const std::vector<uint8_t>& enabledChildren, uint32_t activeChild, float position, bool isAnimating)
+    {
+        // The tiles are rebuilt in place every frame, so this doesn't allocate once the vector has grown to fit every child
+        tiles.clear();
+        isOutlineVisible = false;
+
+        // Outside of overview mode only the active monitor is visible unless we're sliding between monitors
+        // (The active monitor is drawn even if it was disabled after it became active, it stays visible until another monitor takes over.)
+        if (!settings.OverviewMode && !isAnimating)
+        {
+            tiles.push_back({ activeChild, 0.f, 0.f });
+            return;
+        }
+
+        // Enabled children are laid out in a row, the animation position scrolls that row in normal mode and moves the outline in overview mode
+        float offset = settings.OverviewMode ? 0.f : -position;
+        float x = 0.f;
+        for (uint32_t i = 0; i < (uint32_t)enabledChildren.size(); i++)
+        {
+            if (!enabledChildren[i])
+            {
+                continue;
+            }
+
+            tiles.push_back({ i, x + offset, 0.f });
+            x += (float)settings.Width;
+        }
+
+        if (settings.OverviewMode && settings.OutlineEnabled)
+        {
+            isOutlineVisible = true;
+            outline = { position, 0.f, settings.Width, settings.Height, settings.OutlineThickness };
+        }
+    }
+}
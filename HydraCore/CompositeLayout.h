@@ -0,0 +1,66 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+namespace HydraCore
+{
+    struct CompositeLayoutSettings
+    {
+        // The size of a single monitor's tile, the composite is this size (or a row of these in overview mode)
+        uint32_t Width;
+        uint32_t Height;
+        bool OverviewMode;
+        bool OutlineEnabled;
+        uint32_t OutlineThickness;
+    };
+
+    // A child drawn into the composite at the given offset, its scaling within the tile comes from its RenderTransform
+    struct CompositeTile
+    {
+        // Index into the list of children given to CompositeLayout::Update
+        uint32_t Child;
+        float X;
+        float Y;
+    };
+
+    // The overview outline is four bars of the given thickness around a tile-sized area
+    struct CompositeOutline
+    {
+        float X;
+        float Y;
+        uint32_t Width;
+        uint32_t Height;
+        uint32_t Thickness;
+    };
+
+    // Decides which children are drawn where for a frame.
+    // This is the part of rendering which doesn't need a graphics context, so the same logic drives the plugin and the simulator.
+    class CompositeLayout
+    {
+    private:
+        std::vector<CompositeTile> tiles;
+        CompositeOutline outline;
+        bool isOutlineVisible;
+    public:
+        CompositeLayout();
+
+        // enabledChildren is in left-to-right order, disabled children take up no space
+        // position is the animation's current position, which is in the same units as the composite's width.
+        void Update(const CompositeLayoutSettings& settings, const std::vector<uint8_t>& enabledChildren, uint32_t activeChild, float position, bool isAnimating);
+
+        inline const std::vector<CompositeTile>& GetTiles() const
+        {
+            return tiles;
+        }
+
+        inline bool IsOutlineVisible() const
+        {
+            return isOutlineVisible;
+        }
+
+        inline const CompositeOutline& GetOutline() const
+        {
+            return outline;
+        }
+    };
+}
@@ -0,0 +1,131 @@
+#include "CompositorKernels.h"
+
+#include <algorithm>
+
+#if defined(HYDRA_X86_KERNELS) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace HydraCore
+{
+    const char* GetSimdLevelName(SimdLevel level)
+    {
+        switch (level)
+        {
+            case SIMD_LEVEL_SCALAR: return "Scalar";
+            case SIMD_LEVEL_SSE2: return "SSE2";
+            case SIMD_LEVEL_AVX2: return "AVX2";
+            default: return "Unknown";
+        }
+    }
+
+    SimdLevel GetSupportedSimdLevel()
+    {
+#if defined(HYDRA_X86_KERNELS) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        int highestFunction = info[0];
+
+        __cpuid(info, 1);
+        bool hasSse2 = (info[3] & (1 << 26)) != 0;
+        // AVX registers are only usable if the OS saves them (OSXSAVE, then the XMM and YMM bits of XCR0)
+        bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+
+        bool hasAvx2 = false;
+        if (highestFunction >= 7 && osSavesAvx)
+        {
+            __cpuidex(info, 7, 0);
+            hasAvx2 = (info[1] & (1 << 5)) != 0;
+        }
+
+        return hasAvx2 ? SIMD_LEVEL_AVX2 : hasSse2 ? SIMD_LEVEL_SSE2 : SIMD_LEVEL_SCALAR;
+#elif defined(HYDRA_X86_KERNELS)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? SIMD_LEVEL_AVX2 : __builtin_cpu_supports("sse2") ? SIMD_LEVEL_SSE2 : SIMD_LEVEL_SCALAR;
+#else
+        return SIMD_LEVEL_SCALAR;
+#endif
+    }
+
+    const CompositorKernels& GetCompositorKernels(SimdLevel level)
+    {
+        level = std::min(level, GetSupportedSimdLevel());
+
+#ifdef HYDRA_X86_KERNELS
+        switch (level)
+        {
+            case SIMD_LEVEL_AVX2: return Avx2CompositorKernels;
+            case SIMD_LEVEL_SSE2: return Sse2CompositorKernels;
+            default: break;
+        }
+#endif
+
+        return ScalarCompositorKernels;
+    }
+
+    static inline uint8_t RoundToByte(float value)
+    {
+        return (uint8_t)std::min(std::max(value + 0.5f, 0.f), 255.f);
+    }
+
+    static void AccumulateRowScalar(float* accumulator, const uint8_t* source, uint32_t count, float weight, bool accumulate)
+    {
+        if (accumulate)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                accumulator[i] += weight * (float)source[i];
+            }
+        }
+        else
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                accumulator[i] = weight * (float)source[i];
+            }
+        }
+    }
+
+    static void ReduceColumnsScalar(uint8_t* destination, const float* accumulator, const AreaSpan* columns, const float* weights, uint32_t destinationCount, uint32_t accumulatorOffset)
+    {
+        for (uint32_t x = 0; x < destinationCount; x++)
+        {
+            const AreaSpan& column = columns[x];
+            const float* pixel = accumulator + (size_t)(column.First - accumulatorOffset) * 4;
+            const float* columnWeights = weights + column.WeightOffset;
+            float sum[4] = { 0.f, 0.f, 0.f, 0.f };
+
+            for (uint32_t i = 0; i < column.Count; i++, pixel += 4)
+            {
+                for (int channel = 0; channel < 4; channel++)
+                {
+                    sum[channel] += columnWeights[i] * pixel[channel];
+                }
+            }
+
+            for (int channel = 0; channel < 4; channel++)
+            {
+                destination[x * 4 + channel] = RoundToByte(sum[channel]);
+            }
+        }
+    }
+
+    static void BlendSolidScalar(uint8_t* destination, uint32_t pixelCount, const float* color)
+    {
+        float inverseAlpha = 1.f - color[3] / 255.f;
+        for (uint32_t i = 0; i < pixelCount * 4; i += 4)
+        {
+            for (int channel = 0; channel < 4; channel++)
+            {
+                destination[i + channel] = RoundToByte(color[channel] + (float)destination[i + channel] * inverseAlpha);
+            }
+        }
+    }
+
+    const CompositorKernels ScalarCompositorKernels =
+    {
+        AccumulateRowScalar,
+        ReduceColumnsScalar,
+        BlendSolidScalar,
+    };
+}
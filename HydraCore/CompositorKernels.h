@@ -0,0 +1,55 @@
+#pragma once
+#include <stdint.h>
+
+// The SSE2 and AVX2 kernels are only built for x86, everywhere else the scalar kernels are used
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define HYDRA_X86_KERNELS 1
+#endif
+
+namespace HydraCore
+{
+    enum SimdLevel
+    {
+        SIMD_LEVEL_SCALAR,
+        SIMD_LEVEL_SSE2,
+        SIMD_LEVEL_AVX2,
+        SIMD_LEVEL_COUNT,
+    };
+
+    const char* GetSimdLevelName(SimdLevel level);
+
+    // The best level this CPU (and OS) supports
+    SimdLevel GetSupportedSimdLevel();
+
+    // The source pixels which are averaged into one destination pixel along one axis, the weights sum to 1
+    struct AreaSpan
+    {
+        uint32_t First;
+        uint32_t Count;
+        // Index of the first weight in the scale plan's weights
+        uint32_t WeightOffset;
+    };
+
+    // The inner loops of the software compositor, every level produces the same image to within rounding.
+    // Pixels are 4 bytes (BGRA), the channels are treated alike so the order doesn't matter to the kernels.
+    struct CompositorKernels
+    {
+        // accumulator[i] = weight * source[i] for count bytes, or += when accumulate is true
+        void (*AccumulateRow)(float* accumulator, const uint8_t* source, uint32_t count, float weight, bool accumulate);
+
+        // Writes destinationCount pixels, each the weighted sum of the accumulator's pixels in its column span
+        // The accumulator holds the source pixels from accumulatorOffset onwards.
+        void (*ReduceColumns)(uint8_t* destination, const float* accumulator, const AreaSpan* columns, const float* weights, uint32_t destinationCount, uint32_t accumulatorOffset);
+
+        // Blends a premultiplied color (in pixel channel order, 0 to 255) over pixelCount pixels: destination = color + destination * (1 - alpha)
+        void (*BlendSolid)(uint8_t* destination, uint32_t pixelCount, const float* color);
+    };
+
+    const CompositorKernels& GetCompositorKernels(SimdLevel level);
+
+    extern const CompositorKernels ScalarCompositorKernels;
+#ifdef HYDRA_X86_KERNELS
+    extern const CompositorKernels Sse2CompositorKernels;
+    extern const CompositorKernels Avx2CompositorKernels;
+#endif
+}
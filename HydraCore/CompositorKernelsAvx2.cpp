@@ -0,0 +1,118 @@
+#include "CompositorKernels.h"
+
+// Built with AVX2 enabled (see CMakeLists.txt), nothing in here may run before GetSupportedSimdLevel has been checked
+#ifdef HYDRA_X86_KERNELS
+#include <immintrin.h>
+#include <string.h>
+
+namespace HydraCore
+{
+    static inline __m256 LoadBytesAvx2(const uint8_t* source)
+    {
+        return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)source)));
+    }
+
+    template<bool Accumulate>
+    static void AccumulateRowAvx2(float* accumulator, const uint8_t* source, uint32_t count, float weight)
+    {
+        __m256 weights = _mm256_set1_ps(weight);
+        uint32_t i = 0;
+
+        for (; i + 32 <= count; i += 32)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                float* target = accumulator + i + j * 8;
+                __m256 value = _mm256_mul_ps(weights, LoadBytesAvx2(source + i + j * 8));
+                _mm256_storeu_ps(target, Accumulate ? _mm256_add_ps(_mm256_loadu_ps(target), value) : value);
+            }
+        }
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 value = _mm256_mul_ps(weights, LoadBytesAvx2(source + i));
+            _mm256_storeu_ps(accumulator + i, Accumulate ? _mm256_add_ps(_mm256_loadu_ps(accumulator + i), value) : value);
+        }
+
+        for (; i < count; i++)
+        {
+            accumulator[i] = (Accumulate ? accumulator[i] : 0.f) + weight * (float)source[i];
+        }
+    }
+
+    static void AccumulateRowAvx2(float* accumulator, const uint8_t* source, uint32_t count, float weight, bool accumulate)
+    {
+        if (accumulate)
+        {
+            AccumulateRowAvx2<true>(accumulator, source, count, weight);
+        }
+        else
+        {
+            AccumulateRowAvx2<false>(accumulator, source, count, weight);
+        }
+    }
+
+    static void ReduceColumnsAvx2(uint8_t* destination, const float* accumulator, const AreaSpan* columns, const float* weights, uint32_t destinationCount, uint32_t accumulatorOffset)
+    {
+        for (uint32_t x = 0; x < destinationCount; x++)
+        {
+            const AreaSpan& column = columns[x];
+            const float* pixel = accumulator + (size_t)(column.First - accumulatorOffset) * 4;
+            const float* columnWeights = weights + column.WeightOffset;
+
+            // Two source pixels per step, the halves are added together at the end
+            __m256 sum = _mm256_setzero_ps();
+            uint32_t i = 0;
+            for (; i + 2 <= column.Count; i += 2)
+            {
+                __m256 pairWeights = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(columnWeights[i])), _mm_set1_ps(columnWeights[i + 1]), 1);
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(pairWeights, _mm256_loadu_ps(pixel + i * 4)));
+            }
+
+            __m128 total = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+            if (i < column.Count)
+            {
+                total = _mm_add_ps(total, _mm_mul_ps(_mm_set1_ps(columnWeights[i]), _mm_loadu_ps(pixel + i * 4)));
+            }
+
+            __m128i words = _mm_cvtps_epi32(total);
+            words = _mm_packs_epi32(words, words);
+            int32_t bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+            memcpy(destination + x * 4, &bytes, sizeof(bytes));
+        }
+    }
+
+    static void BlendSolidAvx2(uint8_t* destination, uint32_t pixelCount, const float* color)
+    {
+        // Two pixels per register
+        __m256 colorVector = _mm256_broadcast_ps((const __m128*)color);
+        __m256 inverseAlpha = _mm256_set1_ps(1.f - color[3] / 255.f);
+        // The lane-wise packs leave the pixels in the order 0 2 4 6 1 3 5 7
+        __m256i pixelOrder = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        uint32_t i = 0;
+
+        for (; i + 8 <= pixelCount; i += 8)
+        {
+            uint8_t* pixels = destination + i * 4;
+            __m256i values[4];
+            for (int j = 0; j < 4; j++)
+            {
+                values[j] = _mm256_cvtps_epi32(_mm256_add_ps(colorVector, _mm256_mul_ps(inverseAlpha, LoadBytesAvx2(pixels + j * 8))));
+            }
+
+            __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(values[0], values[1]), _mm256_packs_epi32(values[2], values[3]));
+            _mm256_storeu_si256((__m256i*)pixels, _mm256_permutevar8x32_epi32(packed, pixelOrder));
+        }
+
+        // The rest are left to the SSE2 kernel, which every AVX2 CPU has
+        Sse2CompositorKernels.BlendSolid(destination + i * 4, pixelCount - i, color);
+    }
+
+    const CompositorKernels Avx2CompositorKernels =
+    {
+        AccumulateRowAvx2,
+        ReduceColumnsAvx2,
+        BlendSolidAvx2,
+    };
+}
+#endif
@@ -0,0 +1,124 @@
+#include "CompositorKernels.h"
+
+#ifdef HYDRA_X86_KERNELS
+#include <emmintrin.h>
+#include <string.h>
+
+namespace HydraCore
+{
+    template<bool Accumulate>
+    static void AccumulateRowSse2(float* accumulator, const uint8_t* source, uint32_t count, float weight)
+    {
+        __m128i zero = _mm_setzero_si128();
+        __m128 weights = _mm_set1_ps(weight);
+        uint32_t i = 0;
+
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i bytes = _mm_loadu_si128((const __m128i*)(source + i));
+            __m128i low = _mm_unpacklo_epi8(bytes, zero);
+            __m128i high = _mm_unpackhi_epi8(bytes, zero);
+
+            __m128 values[4] =
+            {
+                _mm_mul_ps(weights, _mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero))),
+                _mm_mul_ps(weights, _mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero))),
+                _mm_mul_ps(weights, _mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero))),
+                _mm_mul_ps(weights, _mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero))),
+            };
+
+            for (int j = 0; j < 4; j++)
+            {
+                float* target = accumulator + i + j * 4;
+                _mm_storeu_ps(target, Accumulate ? _mm_add_ps(_mm_loadu_ps(target), values[j]) : values[j]);
+            }
+        }
+
+        for (; i < count; i++)
+        {
+            accumulator[i] = (Accumulate ? accumulator[i] : 0.f) + weight * (float)source[i];
+        }
+    }
+
+    static void AccumulateRowSse2(float* accumulator, const uint8_t* source, uint32_t count, float weight, bool accumulate)
+    {
+        if (accumulate)
+        {
+            AccumulateRowSse2<true>(accumulator, source, count, weight);
+        }
+        else
+        {
+            AccumulateRowSse2<false>(accumulator, source, count, weight);
+        }
+    }
+
+    // Rounds one pixel's channels to bytes and stores them
+    static inline void StorePixelSse2(uint8_t* destination, __m128 pixel)
+    {
+        __m128i words = _mm_cvtps_epi32(pixel);
+        words = _mm_packs_epi32(words, words);
+        int32_t bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+        memcpy(destination, &bytes, sizeof(bytes));
+    }
+
+    static void ReduceColumnsSse2(uint8_t* destination, const float* accumulator, const AreaSpan* columns, const float* weights, uint32_t destinationCount, uint32_t accumulatorOffset)
+    {
+        for (uint32_t x = 0; x < destinationCount; x++)
+        {
+            const AreaSpan& column = columns[x];
+            const float* pixel = accumulator + (size_t)(column.First - accumulatorOffset) * 4;
+            const float* columnWeights = weights + column.WeightOffset;
+            __m128 sum = _mm_setzero_ps();
+
+            for (uint32_t i = 0; i < column.Count; i++, pixel += 4)
+            {
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(columnWeights[i]), _mm_loadu_ps(pixel)));
+            }
+
+            StorePixelSse2(destination + x * 4, sum);
+        }
+    }
+
+    static void BlendSolidSse2(uint8_t* destination, uint32_t pixelCount, const float* color)
+    {
+        __m128i zero = _mm_setzero_si128();
+        __m128 colorVector = _mm_loadu_ps(color);
+        __m128 inverseAlpha = _mm_set1_ps(1.f - color[3] / 255.f);
+        uint32_t i = 0;
+
+        // Four pixels at a time, one pixel per register
+        for (; i + 4 <= pixelCount; i += 4)
+        {
+            __m128i bytes = _mm_loadu_si128((const __m128i*)(destination + i * 4));
+            __m128i low = _mm_unpacklo_epi8(bytes, zero);
+            __m128i high = _mm_unpackhi_epi8(bytes, zero);
+
+            __m128i pixels[4] =
+            {
+                _mm_cvtps_epi32(_mm_add_ps(colorVector, _mm_mul_ps(inverseAlpha, _mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero))))),
+                _mm_cvtps_epi32(_mm_add_ps(colorVector, _mm_mul_ps(inverseAlpha, _mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero))))),
+                _mm_cvtps_epi32(_mm_add_ps(colorVector, _mm_mul_ps(inverseAlpha, _mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero))))),
+                _mm_cvtps_epi32(_mm_add_ps(colorVector, _mm_mul_ps(inverseAlpha, _mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero))))),
+            };
+
+            __m128i packed = _mm_packus_epi16(_mm_packs_epi32(pixels[0], pixels[1]), _mm_packs_epi32(pixels[2], pixels[3]));
+            _mm_storeu_si128((__m128i*)(destination + i * 4), packed);
+        }
+
+        for (; i < pixelCount; i++)
+        {
+            int32_t bytes;
+            memcpy(&bytes, destination + i * 4, sizeof(bytes));
+            __m128 pixel = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero));
+            StorePixelSse2(destination + i * 4, _mm_add_ps(colorVector, _mm_mul_ps(inverseAlpha, pixel)));
+        }
+    }
+
+    const CompositorKernels Sse2CompositorKernels =
+    {
+        AccumulateRowSse2,
+        ReduceColumnsSse2,
+        BlendSolidSse2,
+    };
+}
+#endif
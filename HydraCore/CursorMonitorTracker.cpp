@@ -0,0 +1,119 @@
+#include "Clock.h"
+#include "CursorMonitorTracker.h"
+
+#include <chrono>
+
+namespace HydraCore
+{
+    CursorMonitorTracker::CursorMonitorTracker(DisplayPlatform* platform, uint32_t sampleRate, uint32_t deadZone, bool startSamplingThread)
+    {
+        this->platform = platform;
+        this->sampleRate.store(sampleRate, std::memory_order_relaxed);
+        this->deadZone.store(deadZone, std::memory_order_relaxed);
+
+        startTimestamp = GetTimestamp();
+        sampleCount.store(0, std::memory_order_relaxed);
+        samplingNanoseconds.store(0, std::memory_order_relaxed);
+
+        // Set the initial monitor
+        MonitorHandle initialMonitor = nullptr;
+        cursorMonitorRectangle = {};
+        if (!platform->GetCursorPosition(lastCursorX, lastCursorY))
+        {
+            lastCursorX = 0;
+            lastCursorY = 0;
+        }
+        platform->FindMonitor(lastCursorX, lastCursorY, initialMonitor, cursorMonitorRectangle);
+        cursorMonitor.store(initialMonitor, std::memory_order_relaxed);
+
+        // Start the sampling thread
+        stopRequested = false;
+        if (startSamplingThread)
+        {
+            thread = std::thread(&CursorMonitorTracker::SamplingThreadEntry, this);
+        }
+    }
+
+    CursorMonitorTracker::~CursorMonitorTracker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(stopMutex);
+            stopRequested = true;
+        }
+
+        stopCondition.notify_one();
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+
+    void CursorMonitorTracker::SamplingThreadEntry()
+    {
+        std::unique_lock<std::mutex> lock(stopMutex);
+
+        while (true)
+        {
+            uint32_t rate = sampleRate.load(std::memory_order_relaxed);
+            std::chrono::milliseconds interval(rate == 0 ? 1000 : 1000 / rate);
+
+            if (stopCondition.wait_for(lock, interval, [this]() { return stopRequested; }))
+            {
+                break;
+            }
+
+            Sample();
+        }
+    }
+
+    void CursorMonitorTracker::Sample()
+    {
+        // The sample is timestamped on the platform's clock, but its cost is always measured in real time
+        uint64_t timestamp = platform->GetTimestamp();
+        uint64_t sampleStart = GetTimestamp();
+
+        int32_t cursorX;
+        int32_t cursorY;
+        if (platform->GetCursorPosition(cursorX, cursorY) && (cursorX != lastCursorX || cursorY != lastCursorY))
+        {
+            lastCursorX = cursorX;
+            lastCursorY = cursorY;
+
+            // The cursor only needs to be located when it's left the current monitor by more than the dead zone
+            // This keeps us from flipping back and forth while the cursor rests near a shared edge, and means most samples never leave this function.
+            int64_t distanceX = GetDistanceOutside(cursorX, cursorMonitorRectangle.Left, cursorMonitorRectangle.Width);
+            int64_t distanceY = GetDistanceOutside(cursorY, cursorMonitorRectangle.Top, cursorMonitorRectangle.Height);
+            int64_t distance = distanceX > distanceY ? distanceX : distanceY;
+
+            if (distance > 0 && distance >= (int64_t)deadZone.load(std::memory_order_relaxed))
+            {
+                MonitorHandle newMonitor;
+                Rectangle newMonitorRectangle;
+
+                if (platform->FindMonitor(cursorX, cursorY, newMonitor, newMonitorRectangle) && newMonitor != cursorMonitor.load(std::memory_order_relaxed))
+                {
+                    cursorMonitor.store(newMonitor, std::memory_order_relaxed);
+                    cursorMonitorRectangle = newMonitorRectangle;
+                    cursorMonitorChangedEvent.Dispatch(newMonitor, timestamp);
+                }
+            }
+        }
+
+        sampleCount.fetch_add(1, std::memory_order_relaxed);
+        samplingNanoseconds.fetch_add(GetTimestamp() - sampleStart, std::memory_order_relaxed);
+    }
+
+    void CursorMonitorTracker::UnsubscribeCursorMonitorChanged(EventSubscriptionHandle subscriptionHandle)
+    {
+        cursorMonitorChangedEvent.Unsubscribe(subscriptionHandle);
+    }
+
+    CursorSamplingStatistics CursorMonitorTracker::GetStatistics()
+    {
+        CursorSamplingStatistics ret;
+        ret.SampleCount = sampleCount.load(std::memory_order_relaxed);
+        ret.SamplingNanoseconds = samplingNanoseconds.load(std::memory_order_relaxed);
+        ret.ElapsedNanoseconds = GetTimestamp() - startTimestamp;
+        return ret;
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "ActiveMonitorTracker.h"
+#include "DeferredEvent.h"
+#include "DisplayPlatform.h"
+#include "Event.h"
+
+namespace HydraCore
+{
+    struct CursorSamplingStatistics
+    {
+        uint64_t SampleCount;
+        // Time spent taking samples
+        uint64_t SamplingNanoseconds;
+        // Time since the tracker was started
+        uint64_t ElapsedNanoseconds;
+
+        inline double GetMicrosecondsPerSecond()
+        {
+            return ElapsedNanoseconds == 0 ? 0.0 : (double)SamplingNanoseconds / ((double)ElapsedNanoseconds / 1'000'000'000.0) / 1'000.0;
+        }
+
+        inline double GetMicrosecondsPerSample()
+        {
+            return SampleCount == 0 ? 0.0 : (double)SamplingNanoseconds / (double)SampleCount / 1'000.0;
+        }
+    };
+
+    // Tracks the monitor under the cursor by polling its position at a fixed rate.
+    // Polling keeps the cost bounded by the sample rate rather than by how much the mouse moves, which a low-level mouse hook would not.
+    class CursorMonitorTracker
+    {
+    private:
+        DisplayPlatform* platform;
+        Event<MonitorHandle, uint64_t> cursorMonitorChangedEvent;
+
+        std::atomic<uint32_t> sampleRate;
+        std::atomic<uint32_t> deadZone;
+
+        // Written by the sampling thread, atomic so GetInitialMonitorHandle can be called while it's running
+        std::atomic<MonitorHandle> cursorMonitor;
+        Rectangle cursorMonitorRectangle;
+        int32_t lastCursorX;
+        int32_t lastCursorY;
+
+        uint64_t startTimestamp;
+        std::atomic<uint64_t> sampleCount;
+        std::atomic<uint64_t> samplingNanoseconds;
+
+        std::mutex stopMutex;
+        std::condition_variable stopCondition;
+        bool stopRequested;
+        std::thread thread;
+
+        void SamplingThreadEntry();
+    public:
+        // sampleRate is in samples per second, deadZone is how far (in pixels) the cursor must move past the edge of the current monitor before it's considered to have left
+        // Without the sampling thread the tracker only samples when Sample is called, which allows driving it from a virtual clock.
+        CursorMonitorTracker(DisplayPlatform* platform, uint32_t sampleRate, uint32_t deadZone, bool startSamplingThread = true);
+        ~CursorMonitorTracker();
+
+        // Handlers are invoked on the sampling thread and receive the new monitor and the timestamp (on the platform's clock) of the sample which observed it
+        template<class TTarget>
+        EventSubscriptionHandle SubscribeCursorMonitorChanged(TTarget* targetObject, void (TTarget::*targetMethod)(MonitorHandle newMonitor, uint64_t timestamp))
+        {
+            return cursorMonitorChangedEvent.Subscribe(targetObject, targetMethod);
+        }
+
+        template<class TKey, size_t Capacity>
+        EventSubscriptionHandle SubscribeCursorMonitorChangedDeferred(DeferredEvent<TKey, ActiveMonitorChange, Capacity>* deferredEvent, TKey key)
+        {
+            return cursorMonitorChangedEvent.Subscribe([deferredEvent, key](MonitorHandle newMonitor, uint64_t timestamp)
+            {
+                deferredEvent->Dispatch(key, { newMonitor, timestamp });
+            });
+        }
+
+        void UnsubscribeCursorMonitorChanged(EventSubscriptionHandle subscriptionHandle);
+
+        inline void SetSampleRate(uint32_t sampleRate)
+        {
+            this->sampleRate.store(sampleRate, std::memory_order_relaxed);
+        }
+
+        inline void SetDeadZone(uint32_t deadZone)
+        {
+            this->deadZone.store(deadZone, std::memory_order_relaxed);
+        }
+
+        // Gets the monitor under the cursor as of the latest sample, use the event to keep up with the cursor
+        inline MonitorHandle GetInitialMonitorHandle()
+        {
+            return cursorMonitor.load(std::memory_order_relaxed);
+        }
+
+        // Takes a sample right away, must not be called while the sampling thread is running
+        void Sample();
+
+        CursorSamplingStatistics GetStatistics();
+    };
+}
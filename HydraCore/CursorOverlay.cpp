@@ -0,0 +1,75 @@
+#include "CursorOverlay.h"
+
+#include <algorithm>
+
+namespace HydraCore
+{
+    bool PlaceCursor(const CursorState& state, const CursorShape& shape, const Rectangle& monitor, const RenderTransform& transform, const CompositeTile& tile, CursorPlacement& placement)
+    {
+        if (!state.IsVisible || !transform.IsValid || shape.Width == 0 || shape.Height == 0)
+        {
+            return false;
+        }
+
+        // The image's rectangle in the capture's pixels, captures are the same size as their monitor
+        int64_t left = (int64_t)state.X - monitor.Left - shape.HotspotX;
+        int64_t top = (int64_t)state.Y - monitor.Top - shape.HotspotY;
+
+        // Clipped to the region of the capture the tile shows, which also clips it to the monitor
+        int64_t clippedLeft = std::max(left, (int64_t)transform.SourceX);
+        int64_t clippedTop = std::max(top, (int64_t)transform.SourceY);
+        int64_t clippedRight = std::min(left + shape.Width, (int64_t)transform.SourceX + transform.SourceWidth);
+        int64_t clippedBottom = std::min(top + shape.Height, (int64_t)transform.SourceY + transform.SourceHeight);
+
+        if (clippedLeft >= clippedRight || clippedTop >= clippedBottom)
+        {
+            return false;
+        }
+
+        float scaleX = transform.Width / (float)transform.SourceWidth;
+        float scaleY = transform.Height / (float)transform.SourceHeight;
+
+        placement.X = tile.X + transform.X + (float)(clippedLeft - transform.SourceX) * scaleX;
+        placement.Y = tile.Y + transform.Y + (float)(clippedTop - transform.SourceY) * scaleY;
+        placement.Width = (float)(clippedRight - clippedLeft) * scaleX;
+        placement.Height = (float)(clippedBottom - clippedTop) * scaleY;
+        placement.ImageX = (uint32_t)(clippedLeft - left);
+        placement.ImageY = (uint32_t)(clippedTop - top);
+        placement.ImageWidth = (uint32_t)(clippedRight - clippedLeft);
+        placement.ImageHeight = (uint32_t)(clippedBottom - clippedTop);
+        return true;
+    }
+
+    CursorOverlay::CursorOverlay(DisplayPlatform* platform)
+    {
+        this->platform = platform;
+        state = {};
+        shape = {};
+        isVisible = false;
+        shapeFetchCount = 0;
+    }
+
+    bool CursorOverlay::Update()
+    {
+        if (platform == nullptr || !platform->GetCursorState(state))
+        {
+            isVisible = false;
+            return false;
+        }
+
+        if (state.ShapeId != shape.Id || shapeFetchCount == 0)
+        {
+            // If the image can't be fetched the cursor isn't drawn rather than being drawn with the old one, but it's not asked for again until it changes
+            if (!platform->GetCursorShape(shape))
+            {
+                shape = {};
+            }
+
+            shape.Id = state.ShapeId;
+            shapeFetchCount++;
+        }
+
+        isVisible = state.IsVisible && !shape.Pixels.empty();
+        return isVisible;
+    }
+}
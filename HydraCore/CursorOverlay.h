@@ -0,0 +1,68 @@
+#pragma once
+#include <stdint.h>
+
+#include "CompositeLayout.h"
+#include "DisplayPlatform.h"
+#include "Rectangle.h"
+#include "RenderTransform.h"
+
+namespace HydraCore
+{
+    // Where the part of the cursor which lands in a tile is drawn
+    struct CursorPlacement
+    {
+        // The destination rectangle within the composite
+        float X;
+        float Y;
+        float Width;
+        float Height;
+
+        // The region of the cursor image to draw, in image pixels
+        uint32_t ImageX;
+        uint32_t ImageY;
+        uint32_t ImageWidth;
+        uint32_t ImageHeight;
+    };
+
+    // Works out where the cursor appears within a tile, given the desktop rectangle of the tile's monitor and the transform its capture is drawn with.
+    // The cursor is scaled and cropped exactly like the capture underneath it, returns false if none of it is visible in the tile (IE: it's on another monitor.)
+    bool PlaceCursor(const CursorState& state, const CursorShape& shape, const Rectangle& monitor, const RenderTransform& transform, const CompositeTile& tile, CursorPlacement& placement);
+
+    // Follows the cursor so it can be drawn once over the composite instead of by every capture.
+    // The position is sampled every frame, the image is only fetched again when the platform reports a different shape.
+    class CursorOverlay
+    {
+    private:
+        DisplayPlatform* platform;
+        CursorState state;
+        CursorShape shape;
+        bool isVisible;
+        uint64_t shapeFetchCount;
+    public:
+        explicit CursorOverlay(DisplayPlatform* platform);
+
+        // Called once per frame, returns true if there is a cursor to draw
+        bool Update();
+
+        inline bool IsVisible() const
+        {
+            return isVisible;
+        }
+
+        inline const CursorState& GetState() const
+        {
+            return state;
+        }
+
+        // The shape's ID changes whenever its image does, the image is empty if the platform couldn't provide one
+        inline const CursorShape& GetShape() const
+        {
+            return shape;
+        }
+
+        inline uint64_t GetShapeFetchCount() const
+        {
+            return shapeFetchCount;
+        }
+    };
+}
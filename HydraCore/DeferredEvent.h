@@ -0,0 +1,158 @@
+#pragma once
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+namespace HydraCore
+{
+    // A bounded multi-producer single-consumer queue which coalesces values by key.
+    // Dispatch only records the latest value for its key, the consumer calls Drain whenever it's ready for them (IE: once per frame.)
+    // Producers never wait on the consumer, they only contend with other producers dispatching the same key at the same time.
+    template<class TKey, class TValue, size_t Capacity = 4>
+    class DeferredEvent
+    {
+        static_assert(std::is_trivially_copyable<TKey>::value, "Deferred event keys must be trivially copyable.");
+        static_assert(std::is_trivially_copyable<TValue>::value, "Deferred event values must be trivially copyable.");
+    private:
+        enum SlotState : uint32_t
+        {
+            SLOT_FREE,
+            SLOT_CLAIMING,
+            SLOT_READY,
+        };
+
+        struct Slot
+        {
+            std::atomic<uint32_t> State;
+            // Odd while a producer is writing Value
+            std::atomic<uint32_t> Sequence;
+            // The number of values dispatched since the consumer last drained this slot
+            std::atomic<uint32_t> PendingCount;
+            TKey Key;
+            TValue Value;
+        };
+
+        Slot slots[Capacity];
+        std::atomic<uint64_t> droppedCount;
+
+        Slot* FindOrClaimSlot(const TKey& key)
+        {
+            // Slots are never released, so once a key has a slot it keeps it
+            for (Slot& slot : slots)
+            {
+                uint32_t state = slot.State.load(std::memory_order_acquire);
+
+                if (state == SLOT_FREE)
+                {
+                    if (slot.State.compare_exchange_strong(state, SLOT_CLAIMING, std::memory_order_acquire))
+                    {
+                        slot.Key = key;
+                        slot.State.store(SLOT_READY, std::memory_order_release);
+                        return &slot;
+                    }
+                }
+
+                // Another producer is claiming this slot, wait for its key so we don't end up claiming the same key twice
+                while (state == SLOT_CLAIMING)
+                {
+                    state = slot.State.load(std::memory_order_acquire);
+                }
+
+                if (slot.Key == key)
+                {
+                    return &slot;
+                }
+            }
+
+            return nullptr;
+        }
+    public:
+        DeferredEvent()
+        {
+            for (Slot& slot : slots)
+            {
+                slot.State.store(SLOT_FREE, std::memory_order_relaxed);
+                slot.Sequence.store(0, std::memory_order_relaxed);
+                slot.PendingCount.store(0, std::memory_order_relaxed);
+            }
+
+            droppedCount.store(0, std::memory_order_relaxed);
+        }
+
+        // Records the latest value for the given key
+        // Returns false if the value was dropped because every slot is already taken by another key.
+        bool Dispatch(const TKey& key, const TValue& value)
+        {
+            Slot* slot = FindOrClaimSlot(key);
+
+            if (slot == nullptr)
+            {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            // Lock the slot against other producers by making its sequence odd
+            uint32_t sequence = slot->Sequence.load(std::memory_order_relaxed);
+            while ((sequence & 1) != 0 || !slot->Sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire))
+            {
+                sequence = slot->Sequence.load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+
+            memcpy(&slot->Value, &value, sizeof(TValue));
+
+            slot->Sequence.store(sequence + 2, std::memory_order_release);
+            slot->PendingCount.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+
+        // Delivers the latest value of every key dispatched since the last drain
+        // The callback receives the key, the value, and the number of dispatches which were merged into it.
+        // Must only be called from one thread at a time.
+        template<class TCallable>
+        size_t Drain(TCallable callback)
+        {
+            size_t deliveredCount = 0;
+
+            for (Slot& slot : slots)
+            {
+                if (slot.State.load(std::memory_order_acquire) != SLOT_READY)
+                {
+                    continue;
+                }
+
+                // Check before exchanging so that idle slots don't cost an interlocked operation
+                if (slot.PendingCount.load(std::memory_order_relaxed) == 0)
+                {
+                    continue;
+                }
+
+                uint32_t mergedCount = slot.PendingCount.exchange(0, std::memory_order_acquire);
+
+                // If a producer races us here we might read its newer value early, in which case it'll be delivered again next drain.
+                TValue value;
+                uint32_t sequenceBefore;
+                uint32_t sequenceAfter;
+                do
+                {
+                    sequenceBefore = slot.Sequence.load(std::memory_order_acquire);
+                    memcpy(&value, &slot.Value, sizeof(TValue));
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    sequenceAfter = slot.Sequence.load(std::memory_order_relaxed);
+                } while ((sequenceBefore & 1) != 0 || sequenceBefore != sequenceAfter);
+
+                callback(slot.Key, value, mergedCount);
+                deliveredCount++;
+            }
+
+            return deliveredCount;
+        }
+
+        inline uint64_t GetDroppedCount()
+        {
+            return droppedCount.load(std::memory_order_relaxed);
+        }
+    };
+}
@@ -0,0 +1,19 @@
+#include "DisplayPlatform.h"
+
+#include <atomic>
+
+namespace HydraCore
+{
+    static std::atomic<DisplayPlatform*> currentPlatform(nullptr);
+
+    DisplayPlatform* DisplayPlatform::GetCurrent()
+    {
+        DisplayPlatform* platform = currentPlatform.load(std::memory_order_acquire);
+        return platform == nullptr ? GetNative() : platform;
+    }
+
+    void DisplayPlatform::SetCurrent(DisplayPlatform* platform)
+    {
+        currentPlatform.store(platform, std::memory_order_release);
+    }
+}
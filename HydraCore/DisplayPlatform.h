@@ -0,0 +1,147 @@
+#pragma once
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "DragThrottle.h"
+#include "Event.h"
+#include "Monitor.h"
+#include "Rectangle.h"
+
+namespace HydraCore
+{
+    // Identifies a top-level window (the HWND on Windows, the XID on X11), 0 is never a valid window
+    typedef uintptr_t WindowId;
+
+    struct WindowInfo
+    {
+        // The file name of the window's executable without its directory (IE: obs64.exe), empty if it couldn't be determined
+        std::string ExecutableName;
+        std::string WindowClass;
+    };
+
+    struct CursorState
+    {
+        // False while the cursor is hidden (IE: by a full screen game)
+        bool IsVisible;
+        // The hotspot's position on the desktop
+        int32_t X;
+        int32_t Y;
+        // Changes whenever the cursor's image changes, so the shape only needs fetching again when this does
+        uint64_t ShapeId;
+    };
+
+    struct CursorShape
+    {
+        uint64_t Id;
+        uint32_t Width;
+        uint32_t Height;
+        // Where the hotspot is within the image
+        int32_t HotspotX;
+        int32_t HotspotY;
+        // Premultiplied BGRA, Width * 4 bytes per row
+        std::vector<uint8_t> Pixels;
+    };
+
+    // The windowing system services which monitor enumeration and the trackers are built on.
+    // The native platform is used unless another one (such as SimulatedDisplayPlatform) is installed with SetCurrent, which lets everything above it run without a real desktop.
+    class DisplayPlatform
+    {
+    protected:
+        Event<WindowId, MonitorHandle, uint64_t> activeMonitorChangedEvent;
+        Event<uint64_t> topologyChangedEvent;
+        Event<WindowId> windowDestroyedEvent;
+
+        // Used by the event thread to follow the focused window while it's being dragged
+        DragThrottle dragThrottle;
+    public:
+        virtual ~DisplayPlatform()
+        {
+        }
+
+        // Gets the current time on the platform's clock in nanoseconds, event timestamps are on the same clock
+        virtual uint64_t GetTimestamp() = 0;
+
+        virtual std::vector<Monitor> GetAllMonitors() = 0;
+
+        // Gets the monitor containing the focused window
+        virtual MonitorHandle GetActiveMonitor() = 0;
+
+        virtual bool GetCursorPosition(int32_t& x, int32_t& y) = 0;
+
+        // Cheap enough to call every frame, returns false if the cursor couldn't be queried
+        virtual bool GetCursorState(CursorState& state) = 0;
+
+        // Gets the cursor's current image, which is comparatively expensive so it should only be called when CursorState::ShapeId changes
+        // Returns false if there isn't one (IE: the platform can't provide cursor images)
+        virtual bool GetCursorShape(CursorShape& shape) = 0;
+
+        // Finds the monitor containing the given point, returns false if there isn't one
+        virtual bool FindMonitor(int32_t x, int32_t y, MonitorHandle& monitor, Rectangle& rectangle) = 0;
+
+        // This is expensive (it takes several system calls or round trips to the X server), callers should cache the result until the window is destroyed
+        virtual WindowInfo GetWindowInfo(WindowId window) = 0;
+
+        // Starts delivering events, before this is called the platform doesn't need to be listening to the windowing system
+        // Safe to call more than once.
+        virtual void StartEvents() = 0;
+
+        // While the focused window is being dragged, its monitor is looked up at most once per interval (in nanoseconds) so the active monitor can change before it's dropped
+        // 0 (the default) disables this, in which case windows are only followed once they're dropped.
+        void SetLiveDragInterval(uint64_t interval)
+        {
+            dragThrottle.SetInterval(interval);
+        }
+
+        LiveDragStatistics GetLiveDragStatistics()
+        {
+            return dragThrottle.GetStatistics();
+        }
+
+        // Handlers are invoked whenever the focused window changes or moves, so the monitor is not necessarily different from last time
+        // The window is 0 when the change wasn't caused by a particular window.
+        template<class TTarget>
+        EventSubscriptionHandle SubscribeActiveMonitorChanged(TTarget* targetObject, void (TTarget::*targetMethod)(WindowId window, MonitorHandle newMonitor, uint64_t timestamp))
+        {
+            return activeMonitorChangedEvent.Subscribe(targetObject, targetMethod);
+        }
+
+        void UnsubscribeActiveMonitorChanged(EventSubscriptionHandle subscriptionHandle)
+        {
+            activeMonitorChangedEvent.Unsubscribe(subscriptionHandle);
+        }
+
+        // Handlers are invoked when monitors are added, removed, or rearranged
+        template<class TCallable>
+        EventSubscriptionHandle SubscribeTopologyChanged(TCallable callable)
+        {
+            return topologyChangedEvent.Subscribe(callable);
+        }
+
+        void UnsubscribeTopologyChanged(EventSubscriptionHandle subscriptionHandle)
+        {
+            topologyChangedEvent.Unsubscribe(subscriptionHandle);
+        }
+
+        // Only windows which have been focused are guaranteed to be reported, since those are the only ones anyone asks about
+        template<class TTarget>
+        EventSubscriptionHandle SubscribeWindowDestroyed(TTarget* targetObject, void (TTarget::*targetMethod)(WindowId window))
+        {
+            return windowDestroyedEvent.Subscribe(targetObject, targetMethod);
+        }
+
+        void UnsubscribeWindowDestroyed(EventSubscriptionHandle subscriptionHandle)
+        {
+            windowDestroyedEvent.Unsubscribe(subscriptionHandle);
+        }
+
+        static DisplayPlatform* GetCurrent();
+
+        // Replaces the platform returned by GetCurrent, this must happen before anything (such as ActiveMonitorTracker::GetInstance) has used the current platform
+        // Passing null restores the native platform.
+        static void SetCurrent(DisplayPlatform* platform);
+
+        // Implemented by the platform backend (DisplayPlatformWin32.cpp, DisplayPlatformX11.cpp, or DisplayPlatformNone.cpp)
+        static DisplayPlatform* GetNative();
+    };
+}
@@ -0,0 +1,564 @@
+#include "Clock.h"
+#include "DisplayPlatformI3.h"
+#include "I3Ipc.h"
+
+#include <atomic>
+#include <errno.h>
+#include <mutex>
+#include <stdexcept>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace HydraCore
+{
+    bool FindI3IpcSocketPath(std::string& path, bool& isSway)
+    {
+        // sway sets both, I3SOCK is only there for compatibility
+        const char* swaySocket = getenv("SWAYSOCK");
+        const char* i3Socket = getenv("I3SOCK");
+        isSway = swaySocket != nullptr && swaySocket[0] != '\0';
+        const char* socketPath = isSway ? swaySocket : i3Socket;
+
+        if (socketPath == nullptr || socketPath[0] == '\0')
+        {
+            return false;
+        }
+
+        path = socketPath;
+        return true;
+    }
+
+    class I3DisplayPlatform : public DisplayPlatform
+    {
+    private:
+        static const size_t ReadSize = 64 * 1024;
+
+        struct WindowDetails
+        {
+            std::string WindowClass;
+            int64_t ProcessId;
+        };
+
+        int socketFd;
+        DisplayPlatform* monitorPlatform;
+        std::atomic<MonitorHandle> activeMonitor;
+
+        std::once_flag startEventsFlag;
+        std::thread thread;
+
+        // Only written by the event thread (or the constructor), the lock is for readers on other threads
+        std::mutex monitorsMutex;
+        std::vector<Monitor> monitors;
+        std::vector<std::string> monitorNames;
+
+        // What the events told us about each window which has been focused
+        std::mutex windowsMutex;
+        std::unordered_map<WindowId, WindowDetails> windows;
+
+        // Only used by the event thread once it has started
+        I3IpcReader reader;
+        std::vector<I3Output> outputs;
+        std::string request;
+        WindowId activeWindow;
+        std::string activeOutput;
+        Rectangle activeBounds;
+        bool hasActiveBounds;
+        bool activeMonitorChanged;
+        bool topologyChanged;
+
+        static std::runtime_error MakeException(const std::string& operation)
+        {
+            return std::runtime_error(operation + " failed: " + strerror(errno));
+        }
+
+        void Send(uint32_t type, const char* payload)
+        {
+            request.clear();
+            AppendI3IpcMessage(request, type, payload, strlen(payload));
+
+            // MSG_NOSIGNAL keeps the window manager exiting from killing the process with SIGPIPE
+            const char* cursor = request.data();
+            size_t remaining = request.size();
+            while (remaining > 0)
+            {
+                ssize_t sent = send(socketFd, cursor, remaining, MSG_NOSIGNAL);
+                if (sent < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+
+                if (sent <= 0)
+                {
+                    throw MakeException("Sending to the i3 IPC socket");
+                }
+
+                cursor += sent;
+                remaining -= sent;
+            }
+        }
+
+        // Returns false once the connection is closed
+        bool Receive()
+        {
+            while (true)
+            {
+                ssize_t received = read(socketFd, reader.GetWriteBuffer(ReadSize), ReadSize);
+                if (received > 0)
+                {
+                    reader.CommitWrite(received);
+                    return true;
+                }
+
+                if (received == 0 || errno != EINTR)
+                {
+                    return false;
+                }
+            }
+        }
+
+        void RefreshMonitors()
+        {
+            std::vector<Monitor> newMonitors;
+            if (monitorPlatform != nullptr)
+            {
+                newMonitors = monitorPlatform->GetAllMonitors();
+            }
+            else
+            {
+                // Disabled outputs are still listed (along with i3's fake xroot-0 output)
+                uint32_t id = 0;
+                for (I3Output& output : outputs)
+                {
+                    if (output.IsActive)
+                    {
+                        std::string name = output.Name.ToString();
+                        newMonitors.emplace_back(id, (MonitorHandle)(uintptr_t)(id + 1), output.Bounds, name, name, output.IsPrimary);
+                        id++;
+                    }
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(monitorsMutex);
+            monitors = std::move(newMonitors);
+            monitorNames.clear();
+            for (Monitor& monitor : monitors)
+            {
+                monitorNames.push_back(monitor.GetName());
+            }
+        }
+
+        // Under i3 the output names match the RandR monitor names, otherwise we fall back to the window's (or workspace's) location
+        Monitor* FindOutputMonitor(const JsonString& output, const Rectangle& bounds, bool hasBounds)
+        {
+            if (output.Length > 0)
+            {
+                for (size_t i = 0; i < monitors.size(); i++)
+                {
+                    if (output.Equals(monitorNames[i].c_str()))
+                    {
+                        return &monitors[i];
+                    }
+                }
+            }
+
+            if (!hasBounds)
+            {
+                return nullptr;
+            }
+
+            return Monitor::GetMonitorNearestPoint(monitors, bounds.Left + (int32_t)(bounds.Width / 2), bounds.Top + (int32_t)(bounds.Height / 2));
+        }
+
+        void UpdateActiveMonitor(WindowId window, const JsonString& output, const Rectangle& bounds, bool hasBounds)
+        {
+            activeWindow = window;
+            if (output.HasEscapes)
+            {
+                activeOutput = output.ToString();
+            }
+            else
+            {
+                activeOutput.assign(output.Length > 0 ? output.Data : "", output.Length);
+            }
+            activeBounds = bounds;
+            hasActiveBounds = hasBounds;
+
+            Monitor* monitor = FindOutputMonitor(output, bounds, hasBounds);
+            if (monitor != nullptr)
+            {
+                activeMonitor.store(monitor->GetHandle(), std::memory_order_relaxed);
+                activeMonitorChanged = true;
+            }
+        }
+
+        void RememberWindow(WindowId window, const I3WindowEvent& event)
+        {
+            std::lock_guard<std::mutex> lock(windowsMutex);
+            if (windows.find(window) == windows.end())
+            {
+                windows.emplace(window, WindowDetails { event.WindowClass.ToString(), event.ProcessId });
+            }
+        }
+
+        void HandleWindowEvent(const char* payload, uint32_t length)
+        {
+            I3WindowEvent event;
+            if (!ParseI3WindowEvent(payload, length, event))
+            {
+                return;
+            }
+
+            // Native Wayland windows under sway don't have an X11 window, their container is the next best thing
+            WindowId window = (WindowId)(event.X11Window != 0 ? event.X11Window : event.ContainerId);
+
+            switch (event.Change)
+            {
+                case I3_WINDOW_CHANGE_FOCUS:
+                    RememberWindow(window, event);
+                    UpdateActiveMonitor(window, event.Output, event.Bounds, event.HasBounds);
+                    break;
+                case I3_WINDOW_CHANGE_MOVE:
+                case I3_WINDOW_CHANGE_FLOATING:
+                case I3_WINDOW_CHANGE_FULLSCREEN:
+                    if (window == activeWindow)
+                    {
+                        UpdateActiveMonitor(window, event.Output, event.Bounds, event.HasBounds);
+                    }
+                    break;
+                case I3_WINDOW_CHANGE_CLOSE:
+                {
+                    if (window == activeWindow)
+                    {
+                        activeWindow = 0;
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(windowsMutex);
+                        windows.erase(window);
+                    }
+
+                    windowDestroyedEvent.Dispatch(window);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        void HandleMessage(uint32_t type, const char* payload, uint32_t length)
+        {
+            switch (type)
+            {
+                case I3_IPC_EVENT_WINDOW:
+                    HandleWindowEvent(payload, length);
+                    break;
+                case I3_IPC_EVENT_WORKSPACE:
+                {
+                    // Switching to an empty workspace on another output doesn't focus a window, so the workspace's output is followed too
+                    I3WorkspaceEvent event;
+                    if (ParseI3WorkspaceEvent(payload, length, event) && event.IsFocusChange)
+                    {
+                        UpdateActiveMonitor(0, event.Output, event.Bounds, event.HasBounds);
+                    }
+                    break;
+                }
+                case I3_IPC_GET_WORKSPACES:
+                {
+                    I3WorkspaceEvent workspace;
+                    if (ParseI3FocusedWorkspace(payload, length, workspace))
+                    {
+                        UpdateActiveMonitor(0, workspace.Output, workspace.Bounds, workspace.HasBounds);
+                    }
+                    break;
+                }
+                case I3_IPC_EVENT_OUTPUT:
+                    // The event doesn't say what changed, so the outputs are requested again
+                    if (monitorPlatform != nullptr)
+                    {
+                        RefreshMonitors();
+                        topologyChanged = true;
+                    }
+                    else
+                    {
+                        Send(I3_IPC_GET_OUTPUTS, "");
+                    }
+                    break;
+                case I3_IPC_GET_OUTPUTS:
+                    if (ParseI3Outputs(payload, length, outputs))
+                    {
+                        RefreshMonitors();
+                        topologyChanged = true;
+                    }
+                    break;
+            }
+        }
+
+        // Handles everything that has been received, returns false if the stream is broken
+        bool HandleMessages()
+        {
+            activeMonitorChanged = false;
+            topologyChanged = false;
+
+            try
+            {
+                uint32_t type;
+                const char* payload;
+                uint32_t length;
+                while (reader.NextMessage(type, payload, length))
+                {
+                    HandleMessage(type, payload, length);
+                }
+            }
+            catch (const std::runtime_error&)
+            {
+                return false;
+            }
+
+            uint64_t timestamp = HydraCore::GetTimestamp();
+
+            // Monitors may have been renumbered, so the active monitor is found again
+            if (topologyChanged)
+            {
+                JsonString output = { activeOutput.data(), activeOutput.size(), false };
+                Monitor* monitor = FindOutputMonitor(output, activeBounds, hasActiveBounds);
+                if (monitor != nullptr)
+                {
+                    activeMonitor.store(monitor->GetHandle(), std::memory_order_relaxed);
+                }
+                else if (monitors.size() > 0)
+                {
+                    activeMonitor.store(Monitor::GetPrimaryMonitor(monitors).GetHandle(), std::memory_order_relaxed);
+                }
+
+                activeMonitorChanged = activeMonitorChanged || monitors.size() > 0;
+
+                topologyChangedEvent.Dispatch(timestamp);
+            }
+
+            // Like on X11, a burst of focus changes which arrive together is only dispatched once
+            if (activeMonitorChanged)
+            {
+                activeMonitorChangedEvent.Dispatch(activeWindow, activeMonitor.load(std::memory_order_relaxed), timestamp);
+            }
+
+            return true;
+        }
+
+        void EventThreadEntry()
+        {
+            // Events which arrived along with the replies in the constructor are still queued
+            while (HandleMessages() && Receive())
+            {
+            }
+        }
+    public:
+        I3DisplayPlatform(const std::string& socketPath, DisplayPlatform* monitorPlatform)
+        {
+            this->monitorPlatform = monitorPlatform;
+            activeMonitor.store(nullptr, std::memory_order_relaxed);
+            activeWindow = 0;
+            activeBounds = {};
+            hasActiveBounds = false;
+            activeMonitorChanged = false;
+            topologyChanged = false;
+
+            sockaddr_un address = {};
+            address.sun_family = AF_UNIX;
+            if (socketPath.size() >= sizeof(address.sun_path))
+            {
+                throw std::runtime_error("The i3 IPC socket path is too long.");
+            }
+            memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+            socketFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (socketFd < 0)
+            {
+                throw MakeException("Creating the i3 IPC socket");
+            }
+
+            try
+            {
+                if (connect(socketFd, (sockaddr*)&address, sizeof(address)) != 0)
+                {
+                    throw MakeException("Connecting to the i3 IPC socket");
+                }
+
+                // Replies come back in the order the requests were sent, so once the subscription is acknowledged the initial state has been received
+                if (monitorPlatform != nullptr)
+                {
+                    RefreshMonitors();
+                }
+                else
+                {
+                    Send(I3_IPC_GET_OUTPUTS, "");
+                }
+
+                Send(I3_IPC_GET_WORKSPACES, "");
+                Send(I3_IPC_SUBSCRIBE, "[\"window\",\"workspace\",\"output\"]");
+
+                bool subscribed = false;
+                while (!subscribed)
+                {
+                    if (!Receive())
+                    {
+                        throw std::runtime_error("The i3 IPC socket was closed before the subscription was acknowledged.");
+                    }
+
+                    uint32_t type;
+                    const char* payload;
+                    uint32_t length;
+                    while (!subscribed && reader.NextMessage(type, payload, length))
+                    {
+                        if (type == I3_IPC_SUBSCRIBE)
+                        {
+                            subscribed = true;
+                        }
+                        else
+                        {
+                            HandleMessage(type, payload, length);
+                        }
+                    }
+                }
+            }
+            catch (...)
+            {
+                close(socketFd);
+                throw;
+            }
+
+            if (activeMonitor.load(std::memory_order_relaxed) == nullptr && monitors.size() > 0)
+            {
+                activeMonitor.store(Monitor::GetPrimaryMonitor(monitors).GetHandle(), std::memory_order_relaxed);
+            }
+        }
+
+        ~I3DisplayPlatform() override
+        {
+            // Unblocks the event thread's read
+            shutdown(socketFd, SHUT_RDWR);
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+            close(socketFd);
+        }
+
+        uint64_t GetTimestamp() override
+        {
+            return HydraCore::GetTimestamp();
+        }
+
+        std::vector<Monitor> GetAllMonitors() override
+        {
+            if (monitorPlatform != nullptr)
+            {
+                return monitorPlatform->GetAllMonitors();
+            }
+
+            std::lock_guard<std::mutex> lock(monitorsMutex);
+            return monitors;
+        }
+
+        MonitorHandle GetActiveMonitor() override
+        {
+            return activeMonitor.load(std::memory_order_relaxed);
+        }
+
+        bool GetCursorPosition(int32_t& x, int32_t& y) override
+        {
+            // Neither i3 nor sway report the cursor over IPC
+            return monitorPlatform != nullptr && monitorPlatform->GetCursorPosition(x, y);
+        }
+
+        bool GetCursorState(CursorState& state) override
+        {
+            return monitorPlatform != nullptr && monitorPlatform->GetCursorState(state);
+        }
+
+        bool GetCursorShape(CursorShape& shape) override
+        {
+            return monitorPlatform != nullptr && monitorPlatform->GetCursorShape(shape);
+        }
+
+        bool FindMonitor(int32_t x, int32_t y, MonitorHandle& monitor, Rectangle& rectangle) override
+        {
+            if (monitorPlatform != nullptr)
+            {
+                return monitorPlatform->FindMonitor(x, y, monitor, rectangle);
+            }
+
+            std::lock_guard<std::mutex> lock(monitorsMutex);
+            for (Monitor& candidate : monitors)
+            {
+                Rectangle candidateRectangle = candidate.GetRectangle();
+                if (x >= candidateRectangle.Left && y >= candidateRectangle.Top
+                    && (int64_t)x < (int64_t)candidateRectangle.Left + candidateRectangle.Width
+                    && (int64_t)y < (int64_t)candidateRectangle.Top + candidateRectangle.Height)
+                {
+                    monitor = candidate.GetHandle();
+                    rectangle = candidateRectangle;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        WindowInfo GetWindowInfo(WindowId window) override
+        {
+            WindowInfo ret;
+            int64_t processId = 0;
+            {
+                std::lock_guard<std::mutex> lock(windowsMutex);
+                auto details = windows.find(window);
+                if (details != windows.end())
+                {
+                    ret.WindowClass = details->second.WindowClass;
+                    processId = details->second.ProcessId;
+                }
+            }
+
+            // Only sway includes the process ID in its events, but i3's windows are all X11 windows
+            if (processId <= 0)
+            {
+                return monitorPlatform != nullptr ? monitorPlatform->GetWindowInfo(window) : ret;
+            }
+
+            std::string executableLink = "/proc/" + std::to_string(processId) + "/exe";
+            char executablePath[4096];
+            ssize_t executablePathLength = readlink(executableLink.c_str(), executablePath, sizeof(executablePath));
+            if (executablePathLength > 0)
+            {
+                std::string path(executablePath, executablePathLength);
+                size_t separator = path.find_last_of('/');
+                ret.ExecutableName = separator == std::string::npos ? path : path.substr(separator + 1);
+            }
+
+            return ret;
+        }
+
+        void StartEvents() override
+        {
+            std::call_once(startEventsFlag, [this]()
+            {
+                // The monitor platform's own event thread is what keeps its connection from backing up with events nobody reads
+                if (monitorPlatform != nullptr)
+                {
+                    monitorPlatform->StartEvents();
+                }
+
+                thread = std::thread(&I3DisplayPlatform::EventThreadEntry, this);
+            });
+        }
+    };
+
+    DisplayPlatform* CreateI3DisplayPlatform(const std::string& socketPath, DisplayPlatform* monitorPlatform)
+    {
+        return new I3DisplayPlatform(socketPath, monitorPlatform);
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <string>
+
+#include "DisplayPlatform.h"
+
+namespace HydraCore
+{
+    // Finds the IPC socket of the running sway or i3 session (from SWAYSOCK or I3SOCK), returns false if there isn't one
+    bool FindI3IpcSocketPath(std::string& path, bool& isSway);
+
+    // Creates a platform which follows focus using the window and workspace events from i3's (or sway's) IPC socket, throws std::runtime_error if it can't connect.
+    // If monitorPlatform is given (IE: i3 on X11) it provides the monitors, the cursor, and anything IPC doesn't tell us about windows, otherwise the monitors are the compositor's outputs.
+    // monitorPlatform is not owned by the returned platform and must outlive it.
+    DisplayPlatform* CreateI3DisplayPlatform(const std::string& socketPath, DisplayPlatform* monitorPlatform);
+}
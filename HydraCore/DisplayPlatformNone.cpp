@@ -0,0 +1,35 @@
+#include "DisplayPlatform.h"
+#include "DisplayPlatformI3.h"
+#include "SimulatedDisplayPlatform.h"
+
+#include <stdexcept>
+
+namespace HydraCore
+{
+    static DisplayPlatform* CreateNativePlatform()
+    {
+        // Without xcb, sway (or i3) can still tell us about its outputs and which window is focused
+        std::string socketPath;
+        bool isSway;
+        if (FindI3IpcSocketPath(socketPath, isSway))
+        {
+            try
+            {
+                return CreateI3DisplayPlatform(socketPath, nullptr);
+            }
+            catch (const std::runtime_error&)
+            {
+            }
+        }
+
+        // Used when HydraCore is built without a platform backend (such as for the benchmarks on a machine without the xcb headers)
+        // An empty simulated platform behaves like a desktop with no monitors attached.
+        return new SimulatedDisplayPlatform();
+    }
+
+    DisplayPlatform* DisplayPlatform::GetNative()
+    {
+        static DisplayPlatform* platform = CreateNativePlatform();
+        return platform;
+    }
+}
@@ -0,0 +1,438 @@
+#include "Clock.h"
+#include "DisplayPlatform.h"
+#include "Win32Exception.h"
+
+#include <mutex>
+
+namespace HydraCore
+{
+    class Win32DisplayPlatform : public DisplayPlatform
+    {
+    private:
+        static Win32DisplayPlatform* instance;
+
+        std::once_flag startEventsFlag;
+        HANDLE threadHandle;
+
+        // Only used by the event thread, the location hook only exists while a live drag is in progress
+        HWND draggedWindow;
+        HWINEVENTHOOK windowLocationChangedEventHook;
+
+        static BOOL CALLBACK GetAllMonitorsEnumerator(HMONITOR handle, HDC deviceContext, LPRECT rectangle, LPARAM settings)
+        {
+            auto list = (std::vector<Monitor>*)settings;
+            list->push_back(Monitor((uint32_t)list->size(), handle, rectangle));
+            return TRUE;
+        }
+
+        // Reads a bitmap as top-down 32 bit BGRA, monochrome bitmaps come out as black (0) and white (1)
+        static bool ReadBitmap(HBITMAP bitmap, uint32_t& width, uint32_t& height, std::vector<uint8_t>& pixels)
+        {
+            BITMAP bitmapInfo;
+            if (GetObject(bitmap, sizeof(bitmapInfo), &bitmapInfo) == 0)
+            {
+                return false;
+            }
+
+            BITMAPINFO format = {};
+            format.bmiHeader.biSize = sizeof(format.bmiHeader);
+            format.bmiHeader.biWidth = bitmapInfo.bmWidth;
+            format.bmiHeader.biHeight = -bitmapInfo.bmHeight;
+            format.bmiHeader.biPlanes = 1;
+            format.bmiHeader.biBitCount = 32;
+            format.bmiHeader.biCompression = BI_RGB;
+
+            width = (uint32_t)bitmapInfo.bmWidth;
+            height = (uint32_t)bitmapInfo.bmHeight;
+            pixels.resize((size_t)width * height * 4);
+
+            HDC deviceContext = GetDC(NULL);
+            int lineCount = GetDIBits(deviceContext, bitmap, 0, height, pixels.data(), &format, DIB_RGB_COLORS);
+            ReleaseDC(NULL, deviceContext);
+            return lineCount == (int)height;
+        }
+
+        static HMONITOR GetMonitorFromWindow(HWND window)
+        {
+            if (window == NULL)
+            {
+                window = GetDesktopWindow();
+            }
+
+            return MonitorFromWindow(window, MONITOR_DEFAULTTONEAREST);
+        }
+
+        static DWORD WINAPI EventThreadEntry(LPVOID _this)
+        {
+            ((Win32DisplayPlatform*)_this)->EventThreadEntry();
+            return 0;
+        }
+
+        static void CALLBACK ProcessHookEvent(HWINEVENTHOOK eventHook, DWORD event, HWND activeWindow, LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime)
+        {
+            instance->activeMonitorChangedEvent.Dispatch((WindowId)activeWindow, GetMonitorFromWindow(activeWindow), HydraCore::GetTimestamp());
+        }
+
+        static void CALLBACK ProcessMoveSizeHookEvent(HWINEVENTHOOK eventHook, DWORD event, HWND window, LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime)
+        {
+            if (event == EVENT_SYSTEM_MOVESIZESTART)
+            {
+                instance->BeginLiveDrag(window);
+                return;
+            }
+
+            instance->EndLiveDrag();
+            ProcessHookEvent(eventHook, event, window, idObject, idChild, eventThread, eventTime);
+        }
+
+        static void CALLBACK ProcessLocationHookEvent(HWINEVENTHOOK eventHook, DWORD event, HWND window, LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime)
+        {
+            uint64_t timestamp = HydraCore::GetTimestamp();
+            DragThrottle& dragThrottle = instance->dragThrottle;
+
+            // The hook also reports the caret, the cursor, and every other window on the dragged window's thread, only the window itself matters
+            if (window == instance->draggedWindow && idObject == OBJID_WINDOW && idChild == CHILDID_SELF && dragThrottle.ShouldSample(timestamp))
+            {
+                HMONITOR monitor = GetMonitorFromWindow(window);
+                if (dragThrottle.MonitorChanged(monitor))
+                {
+                    instance->activeMonitorChangedEvent.Dispatch((WindowId)window, monitor, timestamp);
+                }
+            }
+
+            dragThrottle.RecordEvent(HydraCore::GetTimestamp() - timestamp);
+        }
+
+        static void CALLBACK ProcessDestroyHookEvent(HWINEVENTHOOK eventHook, DWORD event, HWND window, LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime)
+        {
+            // This fires for every kind of object (carets, menus, etc), we only care about windows themselves
+            if (idObject == OBJID_WINDOW && idChild == CHILDID_SELF && window != NULL)
+            {
+                instance->windowDestroyedEvent.Dispatch((WindowId)window);
+            }
+        }
+
+        static LRESULT CALLBACK ProcessWindowMessage(HWND window, UINT message, WPARAM wParam, LPARAM lParam)
+        {
+            // WM_DISPLAYCHANGE is broadcast to every top-level window (even hidden ones) when a monitor is added, removed, or moved
+            if (message == WM_DISPLAYCHANGE)
+            {
+                uint64_t timestamp = HydraCore::GetTimestamp();
+                instance->topologyChangedEvent.Dispatch(timestamp);
+
+                // The focused window may have been moved to another monitor along with the change
+                HWND foregroundWindow = GetForegroundWindow();
+                instance->activeMonitorChangedEvent.Dispatch((WindowId)foregroundWindow, GetMonitorFromWindow(foregroundWindow), timestamp);
+            }
+
+            return DefWindowProcA(window, message, wParam, lParam);
+        }
+
+        void BeginLiveDrag(HWND window)
+        {
+            // Windows being dragged without focus (IE: with a third-party tool) never determined the active monitor to begin with
+            if (!dragThrottle.IsEnabled() || window != GetForegroundWindow())
+            {
+                return;
+            }
+
+            // Location changes are raised for every object on the system, so the hook is scoped to the dragged window's thread for the duration of the drag
+            // That way Windows doesn't even deliver the ones from other programs.
+            DWORD processId = 0;
+            DWORD threadId = GetWindowThreadProcessId(window, &processId);
+            windowLocationChangedEventHook = SetWinEventHook(EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE, NULL, ProcessLocationHookEvent, processId, threadId, WINEVENT_OUTOFCONTEXT);
+
+            // The drop is still reported if this fails, so it isn't fatal
+            if (windowLocationChangedEventHook == NULL)
+            {
+                return;
+            }
+
+            draggedWindow = window;
+            dragThrottle.BeginDrag(GetMonitorFromWindow(window), HydraCore::GetTimestamp());
+        }
+
+        void EndLiveDrag()
+        {
+            if (windowLocationChangedEventHook != NULL)
+            {
+                UnhookWinEvent(windowLocationChangedEventHook);
+                windowLocationChangedEventHook = NULL;
+            }
+
+            draggedWindow = NULL;
+        }
+
+        void EventThreadEntry()
+        {
+            // Register for events
+            HWINEVENTHOOK forgroundWindowChangedEventHook = SetWinEventHook(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, NULL, ProcessHookEvent, 0, 0, WINEVENT_OUTOFCONTEXT);
+            if (forgroundWindowChangedEventHook == NULL)
+            {
+                throw Win32Exception();
+            }
+
+            // The start of a move only matters for live dragging, the end is where the window normally gets followed
+            HWINEVENTHOOK windowMovedEventHook = SetWinEventHook(EVENT_SYSTEM_MOVESIZESTART, EVENT_SYSTEM_MOVESIZEEND, NULL, ProcessMoveSizeHookEvent, 0, 0, WINEVENT_OUTOFCONTEXT);
+            if (windowMovedEventHook == NULL)
+            {
+                throw Win32Exception();
+            }
+
+            HWINEVENTHOOK windowDestroyedEventHook = SetWinEventHook(EVENT_OBJECT_DESTROY, EVENT_OBJECT_DESTROY, NULL, ProcessDestroyHookEvent, 0, 0, WINEVENT_OUTOFCONTEXT);
+            if (windowDestroyedEventHook == NULL)
+            {
+                throw Win32Exception();
+            }
+
+            // Message-only windows don't receive broadcasts, so display changes are observed with a hidden window instead
+            WNDCLASSA windowClass = {};
+            windowClass.lpfnWndProc = ProcessWindowMessage;
+            windowClass.hInstance = GetModuleHandleA(NULL);
+            windowClass.lpszClassName = "HydraDisplayPlatform";
+            if (RegisterClassA(&windowClass) == 0)
+            {
+                throw Win32Exception();
+            }
+
+            HWND window = CreateWindowA(windowClass.lpszClassName, "", 0, 0, 0, 0, 0, NULL, NULL, windowClass.hInstance, NULL);
+            if (window == NULL)
+            {
+                throw Win32Exception();
+            }
+
+            // Process events
+            MSG message;
+            while (GetMessage(&message, nullptr, 0, 0))
+            {
+                TranslateMessage(&message);
+                DispatchMessage(&message);
+            }
+
+            // Stop processing events
+            EndLiveDrag();
+            DestroyWindow(window);
+            UnhookWinEvent(forgroundWindowChangedEventHook);
+            UnhookWinEvent(windowMovedEventHook);
+            UnhookWinEvent(windowDestroyedEventHook);
+        }
+    public:
+        Win32DisplayPlatform()
+        {
+            instance = this;
+            threadHandle = NULL;
+            draggedWindow = NULL;
+            windowLocationChangedEventHook = NULL;
+        }
+
+        uint64_t GetTimestamp() override
+        {
+            return HydraCore::GetTimestamp();
+        }
+
+        std::vector<Monitor> GetAllMonitors() override
+        {
+            std::vector<Monitor> ret;
+
+            if (!EnumDisplayMonitors(NULL, NULL, GetAllMonitorsEnumerator, (LPARAM)&ret))
+            {
+                throw Win32Exception();
+            }
+
+            return ret;
+        }
+
+        MonitorHandle GetActiveMonitor() override
+        {
+            return GetMonitorFromWindow(GetForegroundWindow());
+        }
+
+        bool GetCursorPosition(int32_t& x, int32_t& y) override
+        {
+            POINT cursorPosition;
+            if (!GetCursorPos(&cursorPosition))
+            {
+                return false;
+            }
+
+            x = cursorPosition.x;
+            y = cursorPosition.y;
+            return true;
+        }
+
+        bool GetCursorState(CursorState& state) override
+        {
+            CURSORINFO cursorInfo = {};
+            cursorInfo.cbSize = sizeof(cursorInfo);
+            if (!GetCursorInfo(&cursorInfo))
+            {
+                return false;
+            }
+
+            state.IsVisible = (cursorInfo.flags & CURSOR_SHOWING) != 0 && cursorInfo.hCursor != NULL;
+            state.X = cursorInfo.ptScreenPos.x;
+            state.Y = cursorInfo.ptScreenPos.y;
+            // Cursors are shared resources which live as long as their class (or the system), so the handle identifies the image
+            state.ShapeId = (uint64_t)(uintptr_t)cursorInfo.hCursor;
+            return true;
+        }
+
+        bool GetCursorShape(CursorShape& shape) override
+        {
+            CURSORINFO cursorInfo = {};
+            cursorInfo.cbSize = sizeof(cursorInfo);
+            if (!GetCursorInfo(&cursorInfo) || cursorInfo.hCursor == NULL)
+            {
+                return false;
+            }
+
+            ICONINFO iconInfo;
+            if (!GetIconInfo(cursorInfo.hCursor, &iconInfo))
+            {
+                return false;
+            }
+
+            shape.Id = (uint64_t)(uintptr_t)cursorInfo.hCursor;
+            shape.HotspotX = (int32_t)iconInfo.xHotspot;
+            shape.HotspotY = (int32_t)iconInfo.yHotspot;
+
+            uint32_t maskWidth;
+            uint32_t maskHeight;
+            std::vector<uint8_t> mask;
+            bool ret = ReadBitmap(iconInfo.hbmMask, maskWidth, maskHeight, mask);
+
+            if (ret && iconInfo.hbmColor != NULL)
+            {
+                ret = ReadBitmap(iconInfo.hbmColor, shape.Width, shape.Height, shape.Pixels);
+
+                // Color cursors either have an alpha channel or leave it empty and rely on the AND mask, where white is transparent
+                bool hasAlpha = false;
+                for (size_t i = 3; i < shape.Pixels.size() && !hasAlpha; i += 4)
+                {
+                    hasAlpha = shape.Pixels[i] != 0;
+                }
+
+                for (size_t i = 0; ret && i < shape.Pixels.size(); i += 4)
+                {
+                    uint8_t* pixel = &shape.Pixels[i];
+                    if (!hasAlpha)
+                    {
+                        pixel[3] = i < mask.size() && mask[i] != 0 ? 0 : 255;
+                    }
+
+                    pixel[0] = (uint8_t)(pixel[0] * pixel[3] / 255);
+                    pixel[1] = (uint8_t)(pixel[1] * pixel[3] / 255);
+                    pixel[2] = (uint8_t)(pixel[2] * pixel[3] / 255);
+                }
+            }
+            else if (ret)
+            {
+                // Monochrome cursors are the AND mask stacked on top of the XOR mask
+                // Inverted pixels can't be drawn without reading back the target, so they're drawn black like they'd appear over the (usually light) areas they're used on.
+                shape.Width = maskWidth;
+                shape.Height = maskHeight / 2;
+                shape.Pixels.resize((size_t)shape.Width * shape.Height * 4);
+                size_t xorOffset = shape.Pixels.size();
+
+                for (size_t i = 0; i < shape.Pixels.size(); i += 4)
+                {
+                    bool isTransparent = mask[i] != 0;
+                    bool isSet = mask[xorOffset + i] != 0;
+                    uint8_t value = !isTransparent && isSet ? 255 : 0;
+                    shape.Pixels[i + 0] = value;
+                    shape.Pixels[i + 1] = value;
+                    shape.Pixels[i + 2] = value;
+                    shape.Pixels[i + 3] = isTransparent && !isSet ? 0 : 255;
+                }
+            }
+
+            DeleteObject(iconInfo.hbmMask);
+            if (iconInfo.hbmColor != NULL)
+            {
+                DeleteObject(iconInfo.hbmColor);
+            }
+
+            return ret;
+        }
+
+        bool FindMonitor(int32_t x, int32_t y, MonitorHandle& monitor, Rectangle& rectangle) override
+        {
+            POINT point = { x, y };
+            HMONITOR newMonitor = MonitorFromPoint(point, MONITOR_DEFAULTTONULL);
+            if (newMonitor == NULL)
+            {
+                return false;
+            }
+
+            MONITORINFO monitorInfo;
+            monitorInfo.cbSize = sizeof(monitorInfo);
+            if (!GetMonitorInfo(newMonitor, &monitorInfo))
+            {
+                return false;
+            }
+
+            monitor = newMonitor;
+            rectangle.Left = monitorInfo.rcMonitor.left;
+            rectangle.Top = monitorInfo.rcMonitor.top;
+            rectangle.Width = monitorInfo.rcMonitor.right - monitorInfo.rcMonitor.left;
+            rectangle.Height = monitorInfo.rcMonitor.bottom - monitorInfo.rcMonitor.top;
+            return true;
+        }
+
+        WindowInfo GetWindowInfo(WindowId window) override
+        {
+            WindowInfo ret;
+            HWND windowHandle = (HWND)window;
+
+            char windowClass[256];
+            int windowClassLength = GetClassNameA(windowHandle, windowClass, sizeof(windowClass));
+            if (windowClassLength > 0)
+            {
+                ret.WindowClass = std::string(windowClass, windowClassLength);
+            }
+
+            DWORD processId = 0;
+            GetWindowThreadProcessId(windowHandle, &processId);
+
+            // Limited information access is enough for the image name and is granted for most elevated processes too
+            HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, processId);
+            if (process != NULL)
+            {
+                char imagePath[MAX_PATH];
+                DWORD imagePathLength = sizeof(imagePath);
+                if (QueryFullProcessImageNameA(process, 0, imagePath, &imagePathLength))
+                {
+                    std::string path(imagePath, imagePathLength);
+                    size_t separator = path.find_last_of("\\/");
+                    ret.ExecutableName = separator == std::string::npos ? path : path.substr(separator + 1);
+                }
+
+                CloseHandle(process);
+            }
+
+            return ret;
+        }
+
+        void StartEvents() override
+        {
+            std::call_once(startEventsFlag, [this]()
+            {
+                threadHandle = CreateThread(NULL, 0, Win32DisplayPlatform::EventThreadEntry, this, 0, NULL);
+
+                if (threadHandle == NULL)
+                {
+                    throw Win32Exception();
+                }
+            });
+        }
+    };
+
+    Win32DisplayPlatform* Win32DisplayPlatform::instance = nullptr;
+
+    DisplayPlatform* DisplayPlatform::GetNative()
+    {
+        // The hooks call back into the platform from the event thread, so it's never destroyed
+        static Win32DisplayPlatform* platform = new Win32DisplayPlatform();
+        return platform;
+    }
+}
@@ -0,0 +1,566 @@
+#include "Clock.h"
+#include "DisplayPlatform.h"
+#include "DisplayPlatformI3.h"
+#include "MonitorX11.h"
+
+#include <atomic>
+#include <mutex>
+#include <poll.h>
+#include <stdexcept>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <unistd.h>
+#include <xcb/randr.h>
+#include <xcb/xfixes.h>
+
+namespace HydraCore
+{
+    class X11DisplayPlatform : public DisplayPlatform
+    {
+    private:
+        // X11 has no equivalent of the move/size end hook, so a drag is considered over (IE: the window was dropped) once the window has stopped moving for this long
+        static const uint64_t DragSettleTime = 100'000'000;
+
+        // xcb connections are thread-safe, so this is shared between the event thread and callers on other threads
+        xcb_connection_t* connection;
+        xcb_screen_t* screen;
+        xcb_atom_t activeWindowAtom;
+        xcb_atom_t processIdAtom;
+        std::atomic<MonitorHandle> activeMonitor;
+        // Cursor images come from XFixes, without it the cursor can still be followed but not drawn
+        bool hasXfixes;
+        uint8_t xfixesFirstEvent;
+        // RandR tells us about layout changes which don't resize the root window (IE: two monitors swapping places)
+        bool hasRandr;
+        uint8_t randrFirstEvent;
+
+        // The image is only fetched when XFixes tells the event thread the cursor changed, and is kept for GetCursorShape
+        std::atomic<bool> isCursorShapeDirty;
+        std::mutex cursorMutex;
+        CursorShape cursorShape;
+
+        std::once_flag startEventsFlag;
+        std::thread thread;
+
+        // Only used by the event thread once it has started
+        xcb_window_t activeWindow;
+        std::vector<Monitor> monitors;
+        bool dragging;
+        uint64_t lastMoveTime;
+
+        void UpdateActiveWindow()
+        {
+            if (activeWindowAtom == XCB_ATOM_NONE)
+            {
+                return;
+            }
+
+            xcb_get_property_reply_t* reply = xcb_get_property_reply(connection, xcb_get_property(connection, false, screen->root, activeWindowAtom, XCB_ATOM_WINDOW, 0, 1), nullptr);
+            if (reply == nullptr)
+            {
+                return;
+            }
+
+            xcb_window_t newActiveWindow = XCB_WINDOW_NONE;
+            if (xcb_get_property_value_length(reply) >= (int)sizeof(xcb_window_t))
+            {
+                newActiveWindow = *(xcb_window_t*)xcb_get_property_value(reply);
+            }
+            free(reply);
+
+            // Nothing being focused (IE: the desktop was clicked) doesn't change the active monitor
+            if (newActiveWindow == XCB_WINDOW_NONE || newActiveWindow == activeWindow)
+            {
+                return;
+            }
+
+            // Follow the active window's moves, see EventThreadEntry for how they're turned into drags
+            // The selection is left in place once the window loses focus so that we still hear about it being destroyed.
+            uint32_t eventMask = XCB_EVENT_MASK_STRUCTURE_NOTIFY;
+            xcb_change_window_attributes(connection, newActiveWindow, XCB_CW_EVENT_MASK, &eventMask);
+            activeWindow = newActiveWindow;
+        }
+
+        // Returns false if the active monitor couldn't be determined
+        bool UpdateActiveMonitor()
+        {
+            if (activeWindow == XCB_WINDOW_NONE)
+            {
+                if (activeMonitor.load(std::memory_order_relaxed) == nullptr && monitors.size() > 0)
+                {
+                    activeMonitor.store(Monitor::GetPrimaryMonitor(monitors).GetHandle(), std::memory_order_relaxed);
+                    return true;
+                }
+
+                return false;
+            }
+
+            xcb_get_geometry_cookie_t geometryCookie = xcb_get_geometry(connection, activeWindow);
+            xcb_translate_coordinates_cookie_t positionCookie = xcb_translate_coordinates(connection, activeWindow, screen->root, 0, 0);
+            xcb_get_geometry_reply_t* geometry = xcb_get_geometry_reply(connection, geometryCookie, nullptr);
+            xcb_translate_coordinates_reply_t* position = xcb_translate_coordinates_reply(connection, positionCookie, nullptr);
+            bool ret = false;
+
+            // The window may have been destroyed since it was focused, in which case we'll hear about the next one soon enough
+            if (geometry != nullptr && position != nullptr)
+            {
+                int32_t centerX = position->dst_x + geometry->width / 2;
+                int32_t centerY = position->dst_y + geometry->height / 2;
+                Monitor* monitor = Monitor::GetMonitorNearestPoint(monitors, centerX, centerY);
+
+                if (monitor != nullptr)
+                {
+                    activeMonitor.store(monitor->GetHandle(), std::memory_order_relaxed);
+                    ret = true;
+                }
+            }
+
+            free(geometry);
+            free(position);
+            return ret;
+        }
+
+        void DispatchActiveMonitorChanged(uint64_t timestamp)
+        {
+            activeMonitorChangedEvent.Dispatch(activeWindow, activeMonitor.load(std::memory_order_relaxed), timestamp);
+        }
+
+        // Moves which arrive together are handled (and counted) as a single location change
+        void ActiveWindowMoved(uint64_t timestamp)
+        {
+            if (!dragging)
+            {
+                dragging = true;
+                if (dragThrottle.IsEnabled())
+                {
+                    dragThrottle.BeginDrag(activeMonitor.load(std::memory_order_relaxed), timestamp);
+                }
+            }
+
+            lastMoveTime = timestamp;
+
+            if (!dragThrottle.IsEnabled())
+            {
+                return;
+            }
+
+            if (dragThrottle.ShouldSample(timestamp) && UpdateActiveMonitor() && dragThrottle.MonitorChanged(activeMonitor.load(std::memory_order_relaxed)))
+            {
+                DispatchActiveMonitorChanged(timestamp);
+            }
+
+            dragThrottle.RecordEvent(HydraCore::GetTimestamp() - timestamp);
+        }
+
+        void EndDrag(uint64_t timestamp)
+        {
+            dragging = false;
+            if (UpdateActiveMonitor())
+            {
+                DispatchActiveMonitorChanged(timestamp);
+            }
+        }
+
+        void EventThreadEntry()
+        {
+            pollfd connectionPoll = {};
+            connectionPoll.fd = xcb_get_file_descriptor(connection);
+            connectionPoll.events = POLLIN;
+
+            while (!xcb_connection_has_error(connection))
+            {
+                xcb_generic_event_t* event = xcb_poll_for_event(connection);
+
+                // Nothing is queued, wait for the server (or for the dragged window to settle)
+                if (event == nullptr)
+                {
+                    int timeout = -1;
+                    if (dragging)
+                    {
+                        uint64_t now = HydraCore::GetTimestamp();
+                        uint64_t settledTime = lastMoveTime + DragSettleTime;
+                        if (now >= settledTime)
+                        {
+                            EndDrag(now);
+                            xcb_flush(connection);
+                            continue;
+                        }
+
+                        timeout = (int)((settledTime - now + 999'999) / 1'000'000);
+                    }
+
+                    poll(&connectionPoll, 1, timeout);
+                    continue;
+                }
+
+                bool activeWindowChanged = false;
+                bool activeWindowMoved = false;
+                bool layoutChanged = false;
+
+                // Handle everything that's queued before updating so that a window being dragged only costs one update per batch
+                while (event != nullptr)
+                {
+                    uint8_t eventType = event->response_type & ~0x80;
+                    if (hasXfixes && eventType == xfixesFirstEvent + XCB_XFIXES_CURSOR_NOTIFY)
+                    {
+                        isCursorShapeDirty.store(true, std::memory_order_relaxed);
+                    }
+                    else if (hasRandr && eventType == randrFirstEvent + XCB_RANDR_SCREEN_CHANGE_NOTIFY)
+                    {
+                        layoutChanged = true;
+                    }
+
+                    switch (eventType)
+                    {
+                        case XCB_PROPERTY_NOTIFY:
+                        {
+                            xcb_property_notify_event_t* propertyEvent = (xcb_property_notify_event_t*)event;
+                            if (propertyEvent->window == screen->root && propertyEvent->atom == activeWindowAtom)
+                            {
+                                activeWindowChanged = true;
+                            }
+                            break;
+                        }
+                        case XCB_DESTROY_NOTIFY:
+                        {
+                            xcb_destroy_notify_event_t* destroyEvent = (xcb_destroy_notify_event_t*)event;
+                            if (destroyEvent->window == activeWindow)
+                            {
+                                activeWindow = XCB_WINDOW_NONE;
+                                dragging = false;
+                            }
+                            windowDestroyedEvent.Dispatch(destroyEvent->window);
+                            break;
+                        }
+                        case XCB_CONFIGURE_NOTIFY:
+                        {
+                            xcb_configure_notify_event_t* configureEvent = (xcb_configure_notify_event_t*)event;
+                            if (configureEvent->window == screen->root)
+                            {
+                                layoutChanged = true;
+                            }
+                            else if (configureEvent->window == activeWindow)
+                            {
+                                activeWindowMoved = true;
+                            }
+                            break;
+                        }
+                    }
+
+                    free(event);
+                    event = xcb_poll_for_event(connection);
+                }
+
+                uint64_t timestamp = HydraCore::GetTimestamp();
+
+                if (layoutChanged)
+                {
+                    monitors = GetAllMonitorsX11(connection, screen);
+                    topologyChangedEvent.Dispatch(timestamp);
+                }
+
+                if (activeWindowChanged)
+                {
+                    UpdateActiveWindow();
+                }
+
+                // A focus or layout change is followed right away, which also takes care of any drag that was in progress
+                if (activeWindowChanged || layoutChanged)
+                {
+                    EndDrag(timestamp);
+                }
+                else if (activeWindowMoved)
+                {
+                    ActiveWindowMoved(timestamp);
+                }
+
+                xcb_flush(connection);
+            }
+        }
+
+        xcb_atom_t InternAtom(const char* name)
+        {
+            xcb_intern_atom_reply_t* reply = xcb_intern_atom_reply(connection, xcb_intern_atom(connection, true, (uint16_t)strlen(name), name), nullptr);
+            xcb_atom_t ret = reply == nullptr ? (xcb_atom_t)XCB_ATOM_NONE : reply->atom;
+            free(reply);
+            return ret;
+        }
+    public:
+        X11DisplayPlatform()
+        {
+            activeMonitor.store(nullptr, std::memory_order_relaxed);
+            activeWindow = XCB_WINDOW_NONE;
+            dragging = false;
+            lastMoveTime = 0;
+
+            connection = ConnectX11(&screen);
+            if (connection == nullptr)
+            {
+                throw std::runtime_error("Failed to connect to the X server.");
+            }
+
+            monitors = GetAllMonitorsX11(connection, screen);
+
+            // The window manager advertises the focused window with _NET_ACTIVE_WINDOW on the root window
+            activeWindowAtom = InternAtom("_NET_ACTIVE_WINDOW");
+            processIdAtom = InternAtom("_NET_WM_PID");
+
+            // Cursor images need XFixes 2.0 or newer, the version has to be negotiated before any other XFixes request
+            xcb_xfixes_query_version_reply_t* xfixesVersion = xcb_xfixes_query_version_reply(connection, xcb_xfixes_query_version(connection, XCB_XFIXES_MAJOR_VERSION, XCB_XFIXES_MINOR_VERSION), nullptr);
+            hasXfixes = xfixesVersion != nullptr && xfixesVersion->major_version >= 2;
+            free(xfixesVersion);
+            xfixesFirstEvent = hasXfixes ? xcb_get_extension_data(connection, &xcb_xfixes_id)->first_event : 0;
+            isCursorShapeDirty.store(true, std::memory_order_relaxed);
+            cursorShape = {};
+
+            // CursorNotify is sent whenever the displayed cursor image changes, so the image doesn't have to be asked for every frame
+            if (hasXfixes)
+            {
+                xcb_xfixes_select_cursor_input(connection, screen->root, XCB_XFIXES_CURSOR_NOTIFY_MASK_DISPLAY_CURSOR);
+            }
+
+            // GetAllMonitorsX11 has already negotiated the RandR version
+            const xcb_query_extension_reply_t* randrExtension = xcb_get_extension_data(connection, &xcb_randr_id);
+            hasRandr = randrExtension != nullptr && randrExtension->present;
+            randrFirstEvent = hasRandr ? randrExtension->first_event : 0;
+            if (hasRandr)
+            {
+                xcb_randr_select_input(connection, screen->root, XCB_RANDR_NOTIFY_MASK_SCREEN_CHANGE);
+            }
+
+            // Property changes tell us when focus changes, structure changes tell us when the root window is resized (which is all we get without RandR)
+            // Events queue up on the connection until the event thread is started.
+            uint32_t eventMask = XCB_EVENT_MASK_PROPERTY_CHANGE | XCB_EVENT_MASK_STRUCTURE_NOTIFY;
+            xcb_change_window_attributes(connection, screen->root, XCB_CW_EVENT_MASK, &eventMask);
+
+            // Find the initially active monitor
+            UpdateActiveWindow();
+            UpdateActiveMonitor();
+            xcb_flush(connection);
+        }
+
+        uint64_t GetTimestamp() override
+        {
+            return HydraCore::GetTimestamp();
+        }
+
+        std::vector<Monitor> GetAllMonitors() override
+        {
+            return GetAllMonitorsX11(connection, screen);
+        }
+
+        MonitorHandle GetActiveMonitor() override
+        {
+            return activeMonitor.load(std::memory_order_relaxed);
+        }
+
+        bool GetCursorPosition(int32_t& x, int32_t& y) override
+        {
+            xcb_query_pointer_reply_t* reply = xcb_query_pointer_reply(connection, xcb_query_pointer(connection, screen->root), nullptr);
+            if (reply == nullptr)
+            {
+                return false;
+            }
+
+            x = reply->root_x;
+            y = reply->root_y;
+            free(reply);
+            return true;
+        }
+
+        // Fetches the current cursor image, returns false if it couldn't be fetched
+        bool UpdateCursorShape()
+        {
+            xcb_xfixes_get_cursor_image_reply_t* reply = xcb_xfixes_get_cursor_image_reply(connection, xcb_xfixes_get_cursor_image(connection), nullptr);
+            if (reply == nullptr)
+            {
+                return false;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(cursorMutex);
+
+                // The image is premultiplied ARGB in native 32 bit words, which is BGRA in memory on little endian machines
+                const uint32_t* image = xcb_xfixes_get_cursor_image_cursor_image(reply);
+                uint32_t pixelCount = (uint32_t)xcb_xfixes_get_cursor_image_cursor_image_length(reply);
+                cursorShape.Id = reply->cursor_serial;
+                cursorShape.Width = reply->width;
+                cursorShape.Height = reply->height;
+                cursorShape.HotspotX = reply->xhot;
+                cursorShape.HotspotY = reply->yhot;
+                cursorShape.Pixels.resize((size_t)cursorShape.Width * cursorShape.Height * 4);
+
+                uint8_t* pixels = cursorShape.Pixels.data();
+                for (uint32_t i = 0; i < pixelCount && i < cursorShape.Width * cursorShape.Height; i++, pixels += 4)
+                {
+                    pixels[0] = (uint8_t)image[i];
+                    pixels[1] = (uint8_t)(image[i] >> 8);
+                    pixels[2] = (uint8_t)(image[i] >> 16);
+                    pixels[3] = (uint8_t)(image[i] >> 24);
+                }
+            }
+
+            free(reply);
+            return true;
+        }
+
+        bool GetCursorState(CursorState& state) override
+        {
+            // X11 has no notion of a hidden cursor, applications hide it by setting an empty image
+            state.IsVisible = true;
+            state.ShapeId = 0;
+            if (!GetCursorPosition(state.X, state.Y))
+            {
+                return false;
+            }
+
+            if (!hasXfixes)
+            {
+                return true;
+            }
+
+            // CursorNotify is handled by the event thread, so it has to be running for the image to be kept up to date
+            StartEvents();
+
+            // The flag is cleared before fetching so a change which arrives while the image is being fetched isn't lost
+            if (isCursorShapeDirty.exchange(false, std::memory_order_relaxed) && !UpdateCursorShape())
+            {
+                isCursorShapeDirty.store(true, std::memory_order_relaxed);
+            }
+
+            std::lock_guard<std::mutex> lock(cursorMutex);
+            state.ShapeId = cursorShape.Id;
+            return true;
+        }
+
+        bool GetCursorShape(CursorShape& shape) override
+        {
+            std::lock_guard<std::mutex> lock(cursorMutex);
+            if (cursorShape.Pixels.empty())
+            {
+                return false;
+            }
+
+            shape = cursorShape;
+            return true;
+        }
+
+        bool FindMonitor(int32_t x, int32_t y, MonitorHandle& monitor, Rectangle& rectangle) override
+        {
+            // The monitors are enumerated every time since this only happens when the cursor leaves the current monitor
+            std::vector<Monitor> monitors = GetAllMonitorsX11(connection, screen);
+            for (Monitor& candidate : monitors)
+            {
+                Rectangle candidateRectangle = candidate.GetRectangle();
+                if (x >= candidateRectangle.Left && y >= candidateRectangle.Top
+                    && (int64_t)x < (int64_t)candidateRectangle.Left + candidateRectangle.Width
+                    && (int64_t)y < (int64_t)candidateRectangle.Top + candidateRectangle.Height)
+                {
+                    monitor = candidate.GetHandle();
+                    rectangle = candidateRectangle;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        WindowInfo GetWindowInfo(WindowId window) override
+        {
+            WindowInfo ret;
+
+            // Both requests are sent before waiting on either so this only costs one round trip to the server
+            xcb_get_property_cookie_t classCookie = xcb_get_property(connection, false, (xcb_window_t)window, XCB_ATOM_WM_CLASS, XCB_ATOM_STRING, 0, 256);
+            xcb_get_property_cookie_t processIdCookie = xcb_get_property(connection, false, (xcb_window_t)window, processIdAtom, XCB_ATOM_CARDINAL, 0, 1);
+
+            // WM_CLASS is the instance name followed by the class name, each null terminated
+            xcb_get_property_reply_t* classReply = xcb_get_property_reply(connection, classCookie, nullptr);
+            if (classReply != nullptr)
+            {
+                const char* value = (const char*)xcb_get_property_value(classReply);
+                int length = xcb_get_property_value_length(classReply);
+                const char* instanceEnd = (const char*)memchr(value, '\0', length);
+                if (instanceEnd != nullptr)
+                {
+                    const char* className = instanceEnd + 1;
+                    ret.WindowClass = std::string(className, strnlen(className, length - (className - value)));
+                }
+                free(classReply);
+            }
+
+            // _NET_WM_PID is only meaningful for local clients, which are the only ones we could capture anyway
+            xcb_get_property_reply_t* processIdReply = xcb_get_property_reply(connection, processIdCookie, nullptr);
+            if (processIdReply != nullptr)
+            {
+                if (xcb_get_property_value_length(processIdReply) >= (int)sizeof(uint32_t) && processIdAtom != XCB_ATOM_NONE)
+                {
+                    uint32_t processId = *(uint32_t*)xcb_get_property_value(processIdReply);
+                    std::string executableLink = "/proc/" + std::to_string(processId) + "/exe";
+
+                    char executablePath[4096];
+                    ssize_t executablePathLength = readlink(executableLink.c_str(), executablePath, sizeof(executablePath));
+                    if (executablePathLength > 0)
+                    {
+                        std::string path(executablePath, executablePathLength);
+                        size_t separator = path.find_last_of('/');
+                        ret.ExecutableName = separator == std::string::npos ? path : path.substr(separator + 1);
+                    }
+                }
+                free(processIdReply);
+            }
+
+            return ret;
+        }
+
+        void StartEvents() override
+        {
+            std::call_once(startEventsFlag, [this]()
+            {
+                thread = std::thread(&X11DisplayPlatform::EventThreadEntry, this);
+            });
+        }
+    };
+
+    static DisplayPlatform* CreateNativePlatform()
+    {
+        std::string socketPath;
+        bool isSway = false;
+        bool hasI3Ipc = FindI3IpcSocketPath(socketPath, isSway);
+
+        // sway is a Wayland compositor, so X11 (if it's there at all) only knows about XWayland's windows
+        if (hasI3Ipc && isSway)
+        {
+            try
+            {
+                return CreateI3DisplayPlatform(socketPath, nullptr);
+            }
+            catch (const std::runtime_error&)
+            {
+            }
+        }
+
+        X11DisplayPlatform* x11Platform = new X11DisplayPlatform();
+
+        // i3 tells us which window is focused (and where) directly, X11 is still used for the monitors since those are what xshm captures
+        if (hasI3Ipc && !isSway)
+        {
+            try
+            {
+                return CreateI3DisplayPlatform(socketPath, x11Platform);
+            }
+            catch (const std::runtime_error&)
+            {
+            }
+        }
+
+        return x11Platform;
+    }
+
+    DisplayPlatform* DisplayPlatform::GetNative()
+    {
+        // The event thread runs for the rest of the process, so the platform is never destroyed
+        static DisplayPlatform* platform = CreateNativePlatform();
+        return platform;
+    }
+}
@@ -0,0 +1,65 @@
+#include "DragThrottle.h"
+
+namespace HydraCore
+{
+    DragThrottle::DragThrottle()
+    {
+        interval.store(0, std::memory_order_relaxed);
+        lastSampleTime = 0;
+        lastMonitor = nullptr;
+
+        dragCount.store(0, std::memory_order_relaxed);
+        eventCount.store(0, std::memory_order_relaxed);
+        sampleCount.store(0, std::memory_order_relaxed);
+        dispatchCount.store(0, std::memory_order_relaxed);
+        nanoseconds.store(0, std::memory_order_relaxed);
+    }
+
+    void DragThrottle::BeginDrag(MonitorHandle monitor, uint64_t time)
+    {
+        lastSampleTime = time;
+        lastMonitor = monitor;
+        dragCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool DragThrottle::ShouldSample(uint64_t time)
+    {
+        if (time - lastSampleTime < interval.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        lastSampleTime = time;
+        sampleCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool DragThrottle::MonitorChanged(MonitorHandle monitor)
+    {
+        if (monitor == lastMonitor)
+        {
+            return false;
+        }
+
+        lastMonitor = monitor;
+        dispatchCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void DragThrottle::RecordEvent(uint64_t nanoseconds)
+    {
+        eventCount.fetch_add(1, std::memory_order_relaxed);
+        this->nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    LiveDragStatistics DragThrottle::GetStatistics()
+    {
+        LiveDragStatistics ret;
+        ret.DragCount = dragCount.load(std::memory_order_relaxed);
+        ret.EventCount = eventCount.load(std::memory_order_relaxed);
+        ret.SampleCount = sampleCount.load(std::memory_order_relaxed);
+        ret.DispatchCount = dispatchCount.load(std::memory_order_relaxed);
+        ret.Nanoseconds = nanoseconds.load(std::memory_order_relaxed);
+        return ret;
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <stdint.h>
+
+#include "Monitor.h"
+
+namespace HydraCore
+{
+    struct LiveDragStatistics
+    {
+        uint64_t DragCount;
+        // Location changes delivered to the platform while windows were being dragged, including ones which were throttled
+        uint64_t EventCount;
+        // Location changes which were turned into a monitor lookup
+        uint64_t SampleCount;
+        // Samples which found the window on a new monitor
+        uint64_t DispatchCount;
+        // Time spent handling location changes
+        uint64_t Nanoseconds;
+
+        inline double GetMicrosecondsPerDrag()
+        {
+            return DragCount == 0 ? 0.0 : (double)Nanoseconds / (double)DragCount / 1'000.0;
+        }
+
+        inline double GetNanosecondsPerEvent()
+        {
+            return EventCount == 0 ? 0.0 : (double)Nanoseconds / (double)EventCount;
+        }
+    };
+
+    // Rate-limits how often a platform looks up the monitor of a window which is being dragged, and filters out lookups which didn't find a new monitor.
+    // A drag produces a location change for nearly every mouse movement, so without this each one would cost a monitor lookup and an event dispatch.
+    // Everything other than the interval and the statistics is only used by the platform's event thread.
+    class DragThrottle
+    {
+    private:
+        std::atomic<uint64_t> interval;
+        uint64_t lastSampleTime;
+        MonitorHandle lastMonitor;
+
+        std::atomic<uint64_t> dragCount;
+        std::atomic<uint64_t> eventCount;
+        std::atomic<uint64_t> sampleCount;
+        std::atomic<uint64_t> dispatchCount;
+        std::atomic<uint64_t> nanoseconds;
+    public:
+        DragThrottle();
+
+        // 0 disables live dragging, in which case windows are only followed once they're dropped
+        inline void SetInterval(uint64_t interval)
+        {
+            this->interval.store(interval, std::memory_order_relaxed);
+        }
+
+        inline bool IsEnabled()
+        {
+            return interval.load(std::memory_order_relaxed) != 0;
+        }
+
+        void BeginDrag(MonitorHandle monitor, uint64_t time);
+
+        // Returns true if enough time has passed since the last sample to take another one
+        bool ShouldSample(uint64_t time);
+
+        // Returns true if the monitor differs from the one found by the last sample (or the one the drag started on)
+        bool MonitorChanged(MonitorHandle monitor);
+
+        // Records the cost of handling a location change, whether or not it was sampled
+        void RecordEvent(uint64_t nanoseconds);
+
+        LiveDragStatistics GetStatistics();
+    };
+}
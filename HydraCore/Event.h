@@ -1,39 +1,81 @@
 #pragma once
 #include "EventHandler.h"
 
-#include <map>
+#include <algorithm>
 #include <mutex>
+#include <stdint.h>
+#include <vector>
 
 namespace HydraCore
 {
     typedef uintptr_t EventSubscriptionHandle;
 
+    template<class... TArgs>
     class Event
     {
     private:
-        std::map<EventSubscriptionHandle, EventHandlerBase*> eventHandlers;
-        std::mutex eventHandlersMutex;
+        struct Subscription
+        {
+            EventSubscriptionHandle Handle;
+            EventHandler<TArgs...> Handler;
+        };
+
+        // Handles are handed out in increasing order and new subscriptions are appended, so this is always sorted by handle
+        std::vector<Subscription> subscriptions;
+        std::mutex subscriptionsMutex;
         EventSubscriptionHandle nextHandle;
+
+        EventSubscriptionHandle AddSubscription(const EventHandler<TArgs...>& handler)
+        {
+            std::lock_guard<std::mutex> lock(subscriptionsMutex);
+
+            EventSubscriptionHandle handle = nextHandle;
+            nextHandle++;
+            subscriptions.push_back({ handle, handler });
+            return handle;
+        }
     public:
         inline Event()
         {
             nextHandle = 1;
         }
 
-        ~Event();
-
         template<class TTarget>
-        EventSubscriptionHandle Subscribe(TTarget* targetObject, typename EventHandler<TTarget>::TargetMethodType targetMethod)
+        EventSubscriptionHandle Subscribe(TTarget* targetObject, void (TTarget::*targetMethod)(TArgs...))
         {
-            std::lock_guard<std::mutex> lock(eventHandlersMutex);
+            return AddSubscription(EventHandler<TArgs...>::Create(targetObject, targetMethod));
+        }
 
-            EventSubscriptionHandle handle = nextHandle;
-            nextHandle++;
-            eventHandlers[handle] = new EventHandler<TTarget>(targetObject, targetMethod);
-            return handle;
+        template<class TCallable>
+        EventSubscriptionHandle Subscribe(TCallable callable)
+        {
+            return AddSubscription(EventHandler<TArgs...>::Create(callable));
         }
 
-        void Unsubscribe(EventSubscriptionHandle subscriptionHandle);
-        void Dispatch();
+        void Unsubscribe(EventSubscriptionHandle subscriptionHandle)
+        {
+            std::lock_guard<std::mutex> lock(subscriptionsMutex);
+
+            auto subscription = std::lower_bound
+            (
+                subscriptions.begin(), subscriptions.end(), subscriptionHandle,
+                [](const Subscription& a, EventSubscriptionHandle b) { return a.Handle < b; }
+            );
+
+            if (subscription != subscriptions.end() && subscription->Handle == subscriptionHandle)
+            {
+                subscriptions.erase(subscription);
+            }
+        }
+
+        void Dispatch(TArgs... args)
+        {
+            std::lock_guard<std::mutex> lock(subscriptionsMutex);
+
+            for (Subscription& subscription : subscriptions)
+            {
+                subscription.Handler.Dispatch(args...);
+            }
+        }
     };
 }
@@ -1,30 +1,72 @@
 #pragma once
+#include <new>
+#include <stddef.h>
+#include <type_traits>
 
 namespace HydraCore
 {
-    class EventHandlerBase
+    // A type-erased event callback which stores its target inline rather than on the heap.
+    // Member function bindings, free functions, and lambdas capturing a few pointers all fit in the inline storage.
+    template<class... TArgs>
+    class EventHandler
     {
     public:
-        virtual void Dispatch() = 0;
-    };
-
-    template<class TTarget>
-    class EventHandler : public EventHandlerBase
-    {
-    public:
-        typedef void (TTarget::*TargetMethodType)();
+        static const size_t InlineStorageSize = sizeof(void*) * 4;
     private:
-        TTarget * targetObject;
-        TargetMethodType targetMethod;
+        typedef void (*InvokeFunction)(void* storage, TArgs... args);
+
+        template<class TTarget>
+        struct MethodBinding
+        {
+            TTarget* TargetObject;
+            void (TTarget::*TargetMethod)(TArgs...);
+
+            inline void operator()(TArgs... args)
+            {
+                (TargetObject->*TargetMethod)(args...);
+            }
+        };
+
+        alignas(void*) unsigned char storage[InlineStorageSize];
+        InvokeFunction invoke;
+
+        EventHandler()
+        {
+        }
+
+        template<class TCallable>
+        static void Invoke(void* storage, TArgs... args)
+        {
+            (*(TCallable*)storage)(args...);
+        }
     public:
-        EventHandler(TTarget* targetObject, TargetMethodType targetMethod)
-            : targetObject(targetObject), targetMethod(targetMethod)
+        template<class TCallable>
+        static EventHandler Create(TCallable callable)
+        {
+            // Callables are copied around with the handler as raw bytes and never destroyed, so they must not own anything
+            static_assert(sizeof(TCallable) <= InlineStorageSize, "The event handler callable is too large to be stored inline.");
+            static_assert(alignof(TCallable) <= alignof(void*), "The event handler callable is over-aligned.");
+            static_assert(std::is_trivially_copyable<TCallable>::value, "Event handler callables must be trivially copyable.");
+            static_assert(std::is_trivially_destructible<TCallable>::value, "Event handler callables must be trivially destructible.");
+
+            EventHandler ret;
+            new (ret.storage) TCallable(callable);
+            ret.invoke = &Invoke<TCallable>;
+            return ret;
+        }
+
+        template<class TTarget>
+        static EventHandler Create(TTarget* targetObject, void (TTarget::*targetMethod)(TArgs...))
         {
+            MethodBinding<TTarget> binding;
+            binding.TargetObject = targetObject;
+            binding.TargetMethod = targetMethod;
+            return Create(binding);
         }
 
-        virtual void Dispatch()
+        inline void Dispatch(TArgs... args)
         {
-            (targetObject->*targetMethod)();
+            invoke(storage, args...);
         }
     };
 }
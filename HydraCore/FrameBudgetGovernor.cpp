@@ -0,0 +1,168 @@
+#include "FrameBudgetGovernor.h"
+
+#include <algorithm>
+#include <stdio.h>
+
+namespace HydraCore
+{
+    // Tiles are thinned out before neighbours are stopped since a stopped capture takes a moment to produce a frame again when it's switched to
+    static const FrameBudgetLevel FrameBudgetLevels[FrameBudgetLevelCount] =
+    {
+        { 1, UnlimitedWarmNeighbors },
+        { 2, UnlimitedWarmNeighbors },
+        { 2, 2 },
+        { 4, 1 },
+        { 8, 0 },
+    };
+
+    const FrameBudgetLevel& GetFrameBudgetLevel(uint32_t level)
+    {
+        return FrameBudgetLevels[std::min(level, FrameBudgetLevelCount - 1)];
+    }
+
+    FrameBudgetSettings GetDefaultFrameBudgetSettings()
+    {
+        FrameBudgetSettings ret;
+        ret.BudgetFraction = 0.25;
+        ret.LowerAfter = 2;
+        ret.RaiseAfter = 5;
+        ret.HeadroomFraction = 0.8;
+        ret.MaximumRaiseAfter = 60;
+        return ret;
+    }
+
+    FrameBudgetGovernor::FrameBudgetGovernor()
+    {
+        settings = GetDefaultFrameBudgetSettings();
+        Reset();
+    }
+
+    void FrameBudgetGovernor::SetSettings(const FrameBudgetSettings& settings)
+    {
+        this->settings = settings;
+        raiseAfter = std::max(raiseAfter, settings.RaiseAfter);
+    }
+
+    void FrameBudgetGovernor::Reset()
+    {
+        level = 0;
+        overBudgetCount = 0;
+        headroomCount = 0;
+        raiseAfter = settings.RaiseAfter;
+        windowsSinceChange = 0;
+        lastChangeWasRaise = false;
+        reason[0] = '\0';
+
+        for (double& levelCost : levelCosts)
+        {
+            levelCost = 0.0;
+        }
+    }
+
+    FrameBudgetDecision FrameBudgetGovernor::Update(const FrameBudgetSample& sample)
+    {
+        if (sample.FrameCount == 0)
+        {
+            return FRAME_BUDGET_HOLD;
+        }
+
+        windowsSinceChange++;
+
+        // A raise which survived as long as we waited for it means the backoff from earlier oscillation is no longer needed
+        if (lastChangeWasRaise && windowsSinceChange > raiseAfter)
+        {
+            raiseAfter = settings.RaiseAfter;
+            lastChangeWasRaise = false;
+        }
+
+        levelCosts[level] = sample.RenderMilliseconds;
+
+        double budget = sample.FrameMilliseconds * settings.BudgetFraction;
+        double headroomBudget = budget * settings.HeadroomFraction;
+        bool droppedFrames = sample.LaggedFrameCount > 0 || sample.SkippedFrameCount > 0;
+        bool overBudget = sample.RenderMilliseconds > budget;
+
+        // The level above can't be measured without going there, so we go by what it cost last time (or try it anyway once we've been here long enough)
+        double nextLevelCost = level > 0 ? levelCosts[level - 1] : 0.0;
+        bool nextLevelFits = nextLevelCost < headroomBudget || windowsSinceChange >= settings.MaximumRaiseAfter;
+        bool hasHeadroom = !droppedFrames && sample.RenderMilliseconds < headroomBudget && nextLevelFits;
+
+        overBudgetCount = overBudget || droppedFrames ? overBudgetCount + 1 : 0;
+        headroomCount = hasHeadroom ? headroomCount + 1 : 0;
+
+        if ((droppedFrames || overBudgetCount >= settings.LowerAfter) && level + 1 < FrameBudgetLevelCount)
+        {
+            if (droppedFrames)
+            {
+                snprintf(reason, sizeof(reason), "%llu frames lagged and %llu skipped, rendering took %.2f ms/frame", (unsigned long long)sample.LaggedFrameCount, (unsigned long long)sample.SkippedFrameCount, sample.RenderMilliseconds);
+            }
+            else
+            {
+                snprintf(reason, sizeof(reason), "rendering took %.2f ms/frame for %u windows, over the %.2f ms budget", sample.RenderMilliseconds, overBudgetCount, budget);
+            }
+
+            if (lastChangeWasRaise)
+            {
+                raiseAfter = std::min(raiseAfter * 2, std::max(settings.MaximumRaiseAfter, settings.RaiseAfter));
+            }
+
+            level++;
+            overBudgetCount = 0;
+            headroomCount = 0;
+            windowsSinceChange = 0;
+            lastChangeWasRaise = false;
+            return FRAME_BUDGET_LOWER;
+        }
+
+        if (headroomCount >= raiseAfter && level > 0)
+        {
+            snprintf
+            (
+                reason, sizeof(reason), "no frames were dropped for %u windows, rendering took %.2f ms/frame (%.2f ms at the level above when last measured) against the %.2f ms budget",
+                headroomCount, sample.RenderMilliseconds, nextLevelCost, budget
+            );
+
+            level--;
+            overBudgetCount = 0;
+            headroomCount = 0;
+            windowsSinceChange = 0;
+            lastChangeWasRaise = true;
+            return FRAME_BUDGET_RAISE;
+        }
+
+        return FRAME_BUDGET_HOLD;
+    }
+
+    void SelectWarmChildren(const std::vector<uint8_t>& enabledChildren, const CompositeLayout& layout, uint32_t activeChild, uint32_t warmNeighborCount, std::vector<uint8_t>& warmChildren)
+    {
+        uint32_t childCount = (uint32_t)enabledChildren.size();
+        warmChildren.assign(childCount, false);
+
+        for (const CompositeTile& tile : layout.GetTiles())
+        {
+            warmChildren[tile.Child] = true;
+        }
+
+        if (activeChild < childCount)
+        {
+            warmChildren[activeChild] = true;
+        }
+
+        // Walk outwards from the active child, the left neighbour wins a tie
+        uint32_t warmCount = 0;
+        for (uint32_t distance = 1; distance < childCount && warmCount < warmNeighborCount; distance++)
+        {
+            for (int direction = -1; direction <= 1 && warmCount < warmNeighborCount; direction += 2)
+            {
+                int64_t child = (int64_t)activeChild + direction * (int64_t)distance;
+                if (child < 0 || child >= (int64_t)childCount || !enabledChildren[(size_t)child] || warmChildren[(size_t)child])
+                {
+                    continue;
+                }
+
+                warmChildren[(size_t)child] = true;
+                warmCount++;
+            }
+        }
+    }
+}
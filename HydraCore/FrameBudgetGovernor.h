@@ -0,0 +1,116 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+#include "CompositeLayout.h"
+
+namespace HydraCore
+{
+    // Keeps every capture running
+    static const uint32_t UnlimitedWarmNeighbors = UINT32_MAX;
+
+    // How much work is spent on captures which aren't the active monitor, level 0 is full quality and each level after it does less
+    struct FrameBudgetLevel
+    {
+        // Overview tiles other than the active monitor's are redrawn every this many frames, and show their last drawing in between
+        uint32_t TileRefreshDivisor;
+        // How many captures of monitors which aren't on screen are kept running (nearest to the active monitor first) so switching to them is instant
+        uint32_t WarmNeighborCount;
+    };
+
+    static const uint32_t FrameBudgetLevelCount = 5;
+
+    const FrameBudgetLevel& GetFrameBudgetLevel(uint32_t level);
+
+    // What was measured over one statistics window
+    struct FrameBudgetSample
+    {
+        uint64_t FrameCount;
+        // The source's own cost per frame (CPU time, plus GPU time when it is measured)
+        double RenderMilliseconds;
+        // The length of one output frame
+        double FrameMilliseconds;
+        // Frames the whole program failed to render in time (lagged) or encode in time (skipped) during the window
+        uint64_t LaggedFrameCount;
+        uint64_t SkippedFrameCount;
+    };
+
+    enum FrameBudgetDecision
+    {
+        FRAME_BUDGET_HOLD,
+        FRAME_BUDGET_LOWER,
+        FRAME_BUDGET_RAISE,
+    };
+
+    struct FrameBudgetSettings
+    {
+        // The fraction of each frame the source may spend rendering
+        double BudgetFraction;
+        // Consecutive windows over budget before quality is lowered (lagged or skipped frames lower it right away)
+        uint32_t LowerAfter;
+        // Consecutive windows without dropped frames before quality is raised, the level above must have last been measured using less than HeadroomFraction of the budget
+        uint32_t RaiseAfter;
+        double HeadroomFraction;
+        // A raise which is undone right away doubles the wait before the next one, up to this many windows
+        // After this many windows on one level, the level above is tried again even if it was over budget when it was last measured.
+        uint32_t MaximumRaiseAfter;
+    };
+
+    FrameBudgetSettings GetDefaultFrameBudgetSettings();
+
+    // Lowers the quality level while the source is over its render budget or frames are being dropped, and raises it again once there's headroom.
+    // The bar for raising is much higher than for lowering (and grows when raising keeps getting undone) so the level doesn't flip back and forth.
+    // Each level's cost is remembered from the last time it was measured, so a level which was over budget isn't raised back to while nothing has changed.
+    // This is only fed measurements, so the same logic drives the plugin and the simulator.
+    class FrameBudgetGovernor
+    {
+    private:
+        FrameBudgetSettings settings;
+        uint32_t level;
+        uint32_t overBudgetCount;
+        uint32_t headroomCount;
+        uint32_t raiseAfter;
+        // Windows since the level last changed, and whether that change was a raise
+        uint32_t windowsSinceChange;
+        bool lastChangeWasRaise;
+        // Milliseconds per frame during the last window spent on each level, 0 if it hasn't been measured
+        double levelCosts[FrameBudgetLevelCount];
+        char reason[256];
+    public:
+        FrameBudgetGovernor();
+
+        void SetSettings(const FrameBudgetSettings& settings);
+
+        // Goes back to full quality and forgets any history
+        void Reset();
+
+        // Called once per statistics window, returns whether the level changed (and why, see GetReason)
+        FrameBudgetDecision Update(const FrameBudgetSample& sample);
+
+        inline uint32_t GetLevel() const
+        {
+            return level;
+        }
+
+        inline const FrameBudgetLevel& GetCurrentLevel() const
+        {
+            return GetFrameBudgetLevel(level);
+        }
+
+        // Describes the measurements behind the last decision which wasn't FRAME_BUDGET_HOLD
+        inline const char* GetReason() const
+        {
+            return reason;
+        }
+    };
+
+    // Returns true if an overview tile should be redrawn on the given frame, the tiles are staggered so they don't all refresh on the same frame
+    inline bool IsTileRefreshFrame(uint64_t frameIndex, uint32_t child, uint32_t refreshDivisor)
+    {
+        return refreshDivisor <= 1 || (frameIndex + child) % refreshDivisor == 0;
+    }
+
+    // Decides which children's captures should keep running: every child on screen and the nearest warmNeighborCount enabled children which aren't
+    // enabledChildren is in left-to-right order like it is for CompositeLayout::Update, warmChildren is resized to match it.
+    void SelectWarmChildren(const std::vector<uint8_t>& enabledChildren, const CompositeLayout& layout, uint32_t activeChild, uint32_t warmNeighborCount, std::vector<uint8_t>& warmChildren);
+}
@@ -0,0 +1,350 @@
+#include "I3Ipc.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+namespace HydraCore
+{
+    // Nothing we ask for comes close to this, so a bigger message means the stream is out of sync
+    static const uint32_t MaxPayloadLength = 64 * 1024 * 1024;
+
+    void AppendI3IpcMessage(std::string& buffer, uint32_t type, const char* payload, size_t length)
+    {
+        uint32_t payloadLength = (uint32_t)length;
+        buffer.append(I3IpcMagic, sizeof(I3IpcMagic));
+        buffer.append((const char*)&payloadLength, sizeof(payloadLength));
+        buffer.append((const char*)&type, sizeof(type));
+        buffer.append(payload, length);
+    }
+
+    I3IpcReader::I3IpcReader()
+    {
+        readOffset = 0;
+        writeOffset = 0;
+    }
+
+    char* I3IpcReader::GetWriteBuffer(size_t minimumSize)
+    {
+        if (readOffset == writeOffset)
+        {
+            readOffset = 0;
+            writeOffset = 0;
+        }
+
+        if (buffer.size() - writeOffset < minimumSize)
+        {
+            // Move the partial message at the end of the buffer to the front before growing it
+            if (readOffset > 0)
+            {
+                memmove(buffer.data(), buffer.data() + readOffset, writeOffset - readOffset);
+                writeOffset -= readOffset;
+                readOffset = 0;
+            }
+
+            if (buffer.size() - writeOffset < minimumSize)
+            {
+                buffer.resize(std::max(buffer.size() * 2, writeOffset + minimumSize));
+            }
+        }
+
+        return buffer.data() + writeOffset;
+    }
+
+    void I3IpcReader::CommitWrite(size_t length)
+    {
+        writeOffset += length;
+    }
+
+    bool I3IpcReader::NextMessage(uint32_t& type, const char*& payload, uint32_t& length)
+    {
+        size_t available = writeOffset - readOffset;
+        if (available < I3IpcHeaderSize)
+        {
+            return false;
+        }
+
+        const char* header = buffer.data() + readOffset;
+        if (memcmp(header, I3IpcMagic, sizeof(I3IpcMagic)) != 0)
+        {
+            throw std::runtime_error("Received a malformed message from the i3 IPC socket.");
+        }
+
+        uint32_t payloadLength;
+        memcpy(&payloadLength, header + sizeof(I3IpcMagic), sizeof(payloadLength));
+        if (payloadLength > MaxPayloadLength)
+        {
+            throw std::runtime_error("Received an oversized message from the i3 IPC socket.");
+        }
+
+        if (available - I3IpcHeaderSize < payloadLength)
+        {
+            return false;
+        }
+
+        memcpy(&type, header + sizeof(I3IpcMagic) + sizeof(payloadLength), sizeof(type));
+        payload = header + I3IpcHeaderSize;
+        length = payloadLength;
+        readOffset += I3IpcHeaderSize + payloadLength;
+        return true;
+    }
+
+    static bool ReadInt64(const JsonToken& token, int64_t& value)
+    {
+        return token.Type == JSON_TOKEN_NUMBER && token.Text.ToInt64(value);
+    }
+
+    // Reads x, y, width, or height into the rectangle if the token is one of them
+    static void ReadRectangleField(const JsonScanner& scanner, const JsonToken& token, Rectangle& rectangle)
+    {
+        int64_t value;
+        if (!ReadInt64(token, value))
+        {
+            return;
+        }
+
+        const JsonString& key = scanner.GetKey(scanner.GetDepth());
+        if (key.Equals("x")) { rectangle.Left = (int32_t)value; }
+        else if (key.Equals("y")) { rectangle.Top = (int32_t)value; }
+        else if (key.Equals("width")) { rectangle.Width = value < 0 ? 0 : (uint32_t)value; }
+        else if (key.Equals("height")) { rectangle.Height = value < 0 ? 0 : (uint32_t)value; }
+    }
+
+    static bool IsContainerStart(const JsonToken& token)
+    {
+        return token.Type == JSON_TOKEN_OBJECT_START || token.Type == JSON_TOKEN_ARRAY_START;
+    }
+
+    static I3WindowChange ParseWindowChange(const JsonString& change)
+    {
+        if (change.Equals("focus")) { return I3_WINDOW_CHANGE_FOCUS; }
+        if (change.Equals("close")) { return I3_WINDOW_CHANGE_CLOSE; }
+        if (change.Equals("move")) { return I3_WINDOW_CHANGE_MOVE; }
+        if (change.Equals("floating")) { return I3_WINDOW_CHANGE_FLOATING; }
+        if (change.Equals("fullscreen_mode")) { return I3_WINDOW_CHANGE_FULLSCREEN; }
+        return I3_WINDOW_CHANGE_OTHER;
+    }
+
+    bool ParseI3WindowEvent(const char* payload, size_t length, I3WindowEvent& event)
+    {
+        event = {};
+        event.Change = I3_WINDOW_CHANGE_OTHER;
+        bool hasChange = false;
+        JsonString appId = {};
+
+        JsonScanner scanner(payload, length);
+        JsonToken token;
+        while (scanner.Next(token))
+        {
+            // Only the container's own properties are needed, which skips its children (and sway's other rectangles) without scanning them
+            if (IsContainerStart(token))
+            {
+                if (scanner.IsAtPath({}) || scanner.IsAtPath({ "container" }) || scanner.IsAtPath({ "container", "window_properties" }))
+                {
+                    continue;
+                }
+
+                if (scanner.IsAtPath({ "container", "rect" }))
+                {
+                    event.HasBounds = true;
+                    continue;
+                }
+
+                scanner.SkipContainer();
+                continue;
+            }
+
+            if (scanner.IsAtPath({ "change" }))
+            {
+                hasChange = token.Type == JSON_TOKEN_STRING;
+                event.Change = ParseWindowChange(token.Text);
+                continue;
+            }
+
+            if (scanner.GetDepth() < 2 || !scanner.GetKey(1).Equals("container"))
+            {
+                continue;
+            }
+
+            if (scanner.GetDepth() == 3)
+            {
+                if (scanner.GetKey(2).Equals("rect"))
+                {
+                    ReadRectangleField(scanner, token, event.Bounds);
+                }
+                else if (scanner.GetKey(3).Equals("class") && token.Type == JSON_TOKEN_STRING)
+                {
+                    event.WindowClass = token.Text;
+                }
+
+                continue;
+            }
+
+            const JsonString& key = scanner.GetKey(2);
+            int64_t value;
+            if (key.Equals("id") && ReadInt64(token, value))
+            {
+                event.ContainerId = (uint64_t)value;
+            }
+            else if (key.Equals("window") && ReadInt64(token, value))
+            {
+                event.X11Window = (uint64_t)value;
+            }
+            else if (key.Equals("pid") && ReadInt64(token, value))
+            {
+                event.ProcessId = value;
+            }
+            else if (key.Equals("focused"))
+            {
+                event.IsFocused = token.Type == JSON_TOKEN_TRUE;
+            }
+            else if (key.Equals("output") && token.Type == JSON_TOKEN_STRING)
+            {
+                event.Output = token.Text;
+            }
+            else if (key.Equals("app_id") && token.Type == JSON_TOKEN_STRING)
+            {
+                appId = token.Text;
+            }
+        }
+
+        // X11 windows under sway have a class but no app ID, native Wayland windows are the other way around
+        if (event.WindowClass.Length == 0)
+        {
+            event.WindowClass = appId;
+        }
+
+        return hasChange && !scanner.HasError();
+    }
+
+    bool ParseI3WorkspaceEvent(const char* payload, size_t length, I3WorkspaceEvent& event)
+    {
+        event = {};
+        JsonScanner scanner(payload, length);
+        JsonToken token;
+        while (scanner.Next(token))
+        {
+            // The previous workspace and the windows on the new one aren't needed
+            if (IsContainerStart(token))
+            {
+                if (scanner.IsAtPath({ "current", "rect" }))
+                {
+                    event.HasBounds = true;
+                }
+                else if (!scanner.IsAtPath({}) && !scanner.IsAtPath({ "current" }))
+                {
+                    scanner.SkipContainer();
+                }
+            }
+            else if (scanner.IsAtPath({ "change" }))
+            {
+                event.IsFocusChange = token.Text.Equals("focus");
+            }
+            else if (scanner.IsAtPath({ "current", "output" }) && token.Type == JSON_TOKEN_STRING)
+            {
+                event.Output = token.Text;
+            }
+            else if (scanner.GetDepth() == 3 && scanner.GetKey(1).Equals("current") && scanner.GetKey(2).Equals("rect"))
+            {
+                ReadRectangleField(scanner, token, event.Bounds);
+            }
+        }
+
+        return !scanner.HasError();
+    }
+
+    bool ParseI3Outputs(const char* payload, size_t length, std::vector<I3Output>& outputs)
+    {
+        outputs.clear();
+        JsonScanner scanner(payload, length);
+        JsonToken token;
+        while (scanner.Next(token))
+        {
+            // Each element is an output, sway adds modes and other details which we skip
+            if (IsContainerStart(token))
+            {
+                if (scanner.IsAtPath({ "" }))
+                {
+                    outputs.push_back({});
+                }
+                else if (!scanner.IsAtPath({}) && !scanner.IsAtPath({ "", "rect" }))
+                {
+                    scanner.SkipContainer();
+                }
+            }
+            else if (outputs.empty())
+            {
+                continue;
+            }
+            else if (scanner.IsAtPath({ "", "name" }) && token.Type == JSON_TOKEN_STRING)
+            {
+                outputs.back().Name = token.Text;
+            }
+            else if (scanner.IsAtPath({ "", "active" }))
+            {
+                outputs.back().IsActive = token.Type == JSON_TOKEN_TRUE;
+            }
+            else if (scanner.IsAtPath({ "", "primary" }))
+            {
+                outputs.back().IsPrimary = token.Type == JSON_TOKEN_TRUE;
+            }
+            else if (scanner.GetDepth() == 3 && scanner.GetKey(2).Equals("rect"))
+            {
+                ReadRectangleField(scanner, token, outputs.back().Bounds);
+            }
+        }
+
+        return !scanner.HasError();
+    }
+
+    bool ParseI3FocusedWorkspace(const char* payload, size_t length, I3WorkspaceEvent& workspace)
+    {
+        workspace = {};
+        I3WorkspaceEvent candidate = {};
+        bool candidateFocused = false;
+
+        JsonScanner scanner(payload, length);
+        JsonToken token;
+        while (scanner.Next(token))
+        {
+            if (token.Type == JSON_TOKEN_OBJECT_START && scanner.IsAtPath({ "" }))
+            {
+                candidate = {};
+                candidateFocused = false;
+            }
+            else if (token.Type == JSON_TOKEN_OBJECT_END && scanner.IsAtPath({ "" }))
+            {
+                if (candidateFocused)
+                {
+                    workspace = candidate;
+                    workspace.IsFocusChange = true;
+                }
+            }
+            else if (IsContainerStart(token))
+            {
+                if (scanner.IsAtPath({ "", "rect" }))
+                {
+                    candidate.HasBounds = true;
+                }
+                else if (!scanner.IsAtPath({}))
+                {
+                    scanner.SkipContainer();
+                }
+            }
+            else if (scanner.IsAtPath({ "", "focused" }))
+            {
+                candidateFocused = token.Type == JSON_TOKEN_TRUE;
+            }
+            else if (scanner.IsAtPath({ "", "output" }) && token.Type == JSON_TOKEN_STRING)
+            {
+                candidate.Output = token.Text;
+            }
+            else if (scanner.GetDepth() == 3 && scanner.GetKey(2).Equals("rect"))
+            {
+                ReadRectangleField(scanner, token, candidate.Bounds);
+            }
+        }
+
+        return !scanner.HasError();
+    }
+}
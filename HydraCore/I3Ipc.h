@@ -0,0 +1,110 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "JsonScanner.h"
+#include "Rectangle.h"
+
+namespace HydraCore
+{
+    // i3's IPC protocol, which sway also speaks. Every message is "i3-ipc", the payload's length and the message's type (both 32-bit and in native byte order), then a JSON payload.
+    // See https://i3wm.org/docs/ipc.html
+    enum I3IpcMessageType : uint32_t
+    {
+        I3_IPC_GET_WORKSPACES = 1,
+        I3_IPC_SUBSCRIBE = 2,
+        I3_IPC_GET_OUTPUTS = 3,
+
+        // Events have the high bit set, everything else is a reply to a request of the same type
+        I3_IPC_EVENT_WORKSPACE = 0x80000000,
+        I3_IPC_EVENT_OUTPUT = 0x80000001,
+        I3_IPC_EVENT_WINDOW = 0x80000003,
+    };
+
+    static const char I3IpcMagic[] = { 'i', '3', '-', 'i', 'p', 'c' };
+    static const size_t I3IpcHeaderSize = sizeof(I3IpcMagic) + sizeof(uint32_t) * 2;
+
+    // Appends a message to the given buffer
+    void AppendI3IpcMessage(std::string& buffer, uint32_t type, const char* payload, size_t length);
+
+    // Splits the byte stream from the socket into messages.
+    // Data is read straight into the reader's buffer, which is reused so nothing is allocated once it has grown to fit the largest message.
+    class I3IpcReader
+    {
+    private:
+        std::vector<char> buffer;
+        size_t readOffset;
+        size_t writeOffset;
+    public:
+        I3IpcReader();
+
+        // Returns space for at least minimumSize bytes, call CommitWrite with how much was actually written
+        // This invalidates any payload returned by NextMessage.
+        char* GetWriteBuffer(size_t minimumSize);
+        void CommitWrite(size_t length);
+
+        // Returns false if a complete message hasn't been buffered yet, the payload stays valid until GetWriteBuffer is called
+        // Throws std::runtime_error if the stream isn't speaking the protocol.
+        bool NextMessage(uint32_t& type, const char*& payload, uint32_t& length);
+    };
+
+    enum I3WindowChange
+    {
+        I3_WINDOW_CHANGE_FOCUS,
+        I3_WINDOW_CHANGE_CLOSE,
+        // The window was moved to another container or workspace
+        I3_WINDOW_CHANGE_MOVE,
+        I3_WINDOW_CHANGE_FLOATING,
+        I3_WINDOW_CHANGE_FULLSCREEN,
+        // Changes which can't affect which monitor the window is on (new, title, mark, urgent, ...)
+        I3_WINDOW_CHANGE_OTHER,
+    };
+
+    // The strings point into the event's payload
+    struct I3WindowEvent
+    {
+        I3WindowChange Change;
+        // The container's ID, which every window has
+        uint64_t ContainerId;
+        // The X11 window (0 for native Wayland windows under sway)
+        uint64_t X11Window;
+        // In root window coordinates
+        Rectangle Bounds;
+        bool HasBounds;
+        bool IsFocused;
+        // Only some versions of i3 and sway include these
+        JsonString Output;
+        int64_t ProcessId;
+        // The X11 window class, or the Wayland app ID
+        JsonString WindowClass;
+    };
+
+    struct I3WorkspaceEvent
+    {
+        bool IsFocusChange;
+        // The output the newly current workspace is on, and the workspace's area on it
+        JsonString Output;
+        Rectangle Bounds;
+        bool HasBounds;
+    };
+
+    struct I3Output
+    {
+        JsonString Name;
+        Rectangle Bounds;
+        bool IsActive;
+        bool IsPrimary;
+    };
+
+    // These return false if the payload is malformed
+    bool ParseI3WindowEvent(const char* payload, size_t length, I3WindowEvent& event);
+    bool ParseI3WorkspaceEvent(const char* payload, size_t length, I3WorkspaceEvent& event);
+
+    // Parses the reply to I3_IPC_GET_OUTPUTS, outputs is cleared first
+    bool ParseI3Outputs(const char* payload, size_t length, std::vector<I3Output>& outputs);
+
+    // Parses the reply to I3_IPC_GET_WORKSPACES and finds the output of the focused workspace (which is left empty if no workspace is focused)
+    bool ParseI3FocusedWorkspace(const char* payload, size_t length, I3WorkspaceEvent& workspace);
+}
@@ -0,0 +1,440 @@
+#include "JsonScanner.h"
+
+#include <string.h>
+
+namespace HydraCore
+{
+    static int GetHexDigit(char c)
+    {
+        if (c >= '0' && c <= '9') { return c - '0'; }
+        if (c >= 'a' && c <= 'f') { return c - 'a' + 10; }
+        if (c >= 'A' && c <= 'F') { return c - 'A' + 10; }
+        return -1;
+    }
+
+    // Reads the four hex digits of a \u escape, returns -1 if they're malformed
+    static int32_t ReadHexEscape(const char*& cursor, const char* end)
+    {
+        if (end - cursor < 4)
+        {
+            return -1;
+        }
+
+        int32_t ret = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            int digit = GetHexDigit(cursor[i]);
+            if (digit < 0)
+            {
+                return -1;
+            }
+
+            ret = ret << 4 | digit;
+        }
+
+        cursor += 4;
+        return ret;
+    }
+
+    // Decodes the character (or escape) at the cursor into out as UTF-8, returns the number of bytes written
+    static size_t DecodeCharacter(const char*& cursor, const char* end, char* out)
+    {
+        char c = *cursor++;
+        if (c != '\\' || cursor == end)
+        {
+            out[0] = c;
+            return 1;
+        }
+
+        c = *cursor++;
+        switch (c)
+        {
+            case 'b': out[0] = '\b'; return 1;
+            case 'f': out[0] = '\f'; return 1;
+            case 'n': out[0] = '\n'; return 1;
+            case 'r': out[0] = '\r'; return 1;
+            case 't': out[0] = '\t'; return 1;
+            case 'u': break;
+            default: out[0] = c; return 1;
+        }
+
+        int32_t codePoint = ReadHexEscape(cursor, end);
+        if (codePoint < 0)
+        {
+            out[0] = '?';
+            return 1;
+        }
+
+        // Characters outside of the basic multilingual plane are escaped as a surrogate pair
+        if (codePoint >= 0xd800 && codePoint < 0xdc00 && end - cursor >= 6 && cursor[0] == '\\' && cursor[1] == 'u')
+        {
+            const char* lowCursor = cursor + 2;
+            int32_t low = ReadHexEscape(lowCursor, end);
+            if (low >= 0xdc00 && low < 0xe000)
+            {
+                codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+                cursor = lowCursor;
+            }
+        }
+
+        if (codePoint < 0x80)
+        {
+            out[0] = (char)codePoint;
+            return 1;
+        }
+        else if (codePoint < 0x800)
+        {
+            out[0] = (char)(0xc0 | codePoint >> 6);
+            out[1] = (char)(0x80 | (codePoint & 0x3f));
+            return 2;
+        }
+        else if (codePoint < 0x10000)
+        {
+            out[0] = (char)(0xe0 | codePoint >> 12);
+            out[1] = (char)(0x80 | (codePoint >> 6 & 0x3f));
+            out[2] = (char)(0x80 | (codePoint & 0x3f));
+            return 3;
+        }
+
+        out[0] = (char)(0xf0 | codePoint >> 18);
+        out[1] = (char)(0x80 | (codePoint >> 12 & 0x3f));
+        out[2] = (char)(0x80 | (codePoint >> 6 & 0x3f));
+        out[3] = (char)(0x80 | (codePoint & 0x3f));
+        return 4;
+    }
+
+    bool JsonString::EqualsEscaped(const char* text) const
+    {
+        const char* cursor = Data;
+        const char* end = Data + Length;
+        while (cursor < end)
+        {
+            char decoded[4];
+            size_t decodedLength = DecodeCharacter(cursor, end, decoded);
+            if (strncmp(text, decoded, decodedLength) != 0)
+            {
+                return false;
+            }
+
+            text += decodedLength;
+        }
+
+        return *text == '\0';
+    }
+
+    std::string JsonString::ToString() const
+    {
+        if (!HasEscapes)
+        {
+            return std::string(Data, Length);
+        }
+
+        std::string ret;
+        ret.reserve(Length);
+        const char* cursor = Data;
+        const char* end = Data + Length;
+        while (cursor < end)
+        {
+            char decoded[4];
+            size_t decodedLength = DecodeCharacter(cursor, end, decoded);
+            ret.append(decoded, decodedLength);
+        }
+
+        return ret;
+    }
+
+    bool JsonString::ToInt64(int64_t& value) const
+    {
+        const char* cursor = Data;
+        const char* end = Data + Length;
+        bool negative = cursor < end && *cursor == '-';
+        if (negative)
+        {
+            cursor++;
+        }
+
+        // Accumulated as a negative number so that INT64_MIN doesn't overflow
+        int64_t ret = 0;
+        const char* digitsStart = cursor;
+        for (; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++)
+        {
+            int digit = *cursor - '0';
+            if (ret < (INT64_MIN + digit) / 10)
+            {
+                return false;
+            }
+
+            ret = ret * 10 - digit;
+        }
+
+        if (cursor == digitsStart || (cursor < end && *cursor != '.' && *cursor != 'e' && *cursor != 'E'))
+        {
+            return false;
+        }
+
+        if (!negative && ret == INT64_MIN)
+        {
+            return false;
+        }
+
+        value = negative ? ret : -ret;
+        return true;
+    }
+
+    JsonScanner::JsonScanner(const char* data, size_t length)
+    {
+        cursor = data;
+        end = data + length;
+        hasError = false;
+        depth = 0;
+        keys[0] = {};
+        isObject[0] = false;
+        enterPending = false;
+        enterObject = false;
+    }
+
+    void JsonScanner::SkipWhitespace()
+    {
+        while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r'))
+        {
+            cursor++;
+        }
+    }
+
+    bool JsonScanner::ScanString(JsonString& string)
+    {
+        // The cursor is on the opening quote
+        cursor++;
+        string.Data = cursor;
+        string.HasEscapes = false;
+
+        // Most strings don't have escapes, which lets memchr find the closing quote much faster than walking the string one character at a time
+        const char* quote = (const char*)memchr(cursor, '"', end - cursor);
+        const char* backslash = (const char*)memchr(cursor, '\\', (quote == nullptr ? end : quote) - cursor);
+        if (backslash == nullptr)
+        {
+            if (quote == nullptr)
+            {
+                cursor = end;
+                return false;
+            }
+
+            string.Length = quote - string.Data;
+            cursor = quote + 1;
+            return true;
+        }
+
+        cursor = backslash;
+        while (cursor < end && *cursor != '"')
+        {
+            if (*cursor == '\\')
+            {
+                string.HasEscapes = true;
+                cursor++;
+            }
+
+            cursor++;
+        }
+
+        if (cursor >= end)
+        {
+            cursor = end;
+            return false;
+        }
+
+        string.Length = cursor - string.Data;
+        cursor++;
+        return true;
+    }
+
+    bool JsonScanner::Fail()
+    {
+        hasError = true;
+        return false;
+    }
+
+    bool JsonScanner::Next(JsonToken& token)
+    {
+        if (hasError)
+        {
+            return false;
+        }
+
+        if (enterPending)
+        {
+            enterPending = false;
+            if (depth == MaxDepth)
+            {
+                return Fail();
+            }
+
+            depth++;
+            keys[depth] = {};
+            isObject[depth] = enterObject;
+        }
+
+        // Separators carry no information we need, so they're skipped rather than validated
+        while (true)
+        {
+            SkipWhitespace();
+            if (cursor == end)
+            {
+                // Running out in the middle of a container means the document was truncated
+                return depth == 0 ? false : Fail();
+            }
+
+            if (*cursor != ',')
+            {
+                break;
+            }
+
+            cursor++;
+        }
+
+        token.Text = {};
+
+        if (*cursor == '}' || *cursor == ']')
+        {
+            bool closesObject = *cursor == '}';
+            if (depth == 0 || isObject[depth] != closesObject)
+            {
+                return Fail();
+            }
+
+            cursor++;
+            depth--;
+            token.Type = closesObject ? JSON_TOKEN_OBJECT_END : JSON_TOKEN_ARRAY_END;
+            return true;
+        }
+
+        if (isObject[depth])
+        {
+            if (*cursor != '"' || !ScanString(keys[depth]))
+            {
+                return Fail();
+            }
+
+            SkipWhitespace();
+            if (cursor == end || *cursor != ':')
+            {
+                return Fail();
+            }
+
+            cursor++;
+            SkipWhitespace();
+            if (cursor == end)
+            {
+                return Fail();
+            }
+        }
+
+        switch (*cursor)
+        {
+            case '{':
+            case '[':
+                enterPending = true;
+                enterObject = *cursor == '{';
+                token.Type = enterObject ? JSON_TOKEN_OBJECT_START : JSON_TOKEN_ARRAY_START;
+                cursor++;
+                return true;
+            case '"':
+                token.Type = JSON_TOKEN_STRING;
+                return ScanString(token.Text) || Fail();
+            case 't':
+            case 'f':
+            case 'n':
+            {
+                const char* literal = *cursor == 't' ? "true" : *cursor == 'f' ? "false" : "null";
+                size_t literalLength = strlen(literal);
+                if ((size_t)(end - cursor) < literalLength || memcmp(cursor, literal, literalLength) != 0)
+                {
+                    return Fail();
+                }
+
+                token.Type = *cursor == 't' ? JSON_TOKEN_TRUE : *cursor == 'f' ? JSON_TOKEN_FALSE : JSON_TOKEN_NULL;
+                cursor += literalLength;
+                return true;
+            }
+            default:
+            {
+                const char* start = cursor;
+                while (cursor < end && ((*cursor >= '0' && *cursor <= '9') || *cursor == '-' || *cursor == '+' || *cursor == '.' || *cursor == 'e' || *cursor == 'E'))
+                {
+                    cursor++;
+                }
+
+                if (cursor == start)
+                {
+                    return Fail();
+                }
+
+                token.Type = JSON_TOKEN_NUMBER;
+                token.Text = { start, (size_t)(cursor - start), false };
+                return true;
+            }
+        }
+    }
+
+    void JsonScanner::SkipContainer()
+    {
+        if (!enterPending)
+        {
+            return;
+        }
+
+        // Only brackets outside of strings matter, so this is a much simpler scan than tokenizing the container
+        enterPending = false;
+        int nesting = 1;
+        while (cursor < end && nesting > 0)
+        {
+            char c = *cursor++;
+            if (c == '"')
+            {
+                while (cursor < end && *cursor != '"')
+                {
+                    cursor += *cursor == '\\' ? 2 : 1;
+                }
+
+                if (cursor >= end)
+                {
+                    break;
+                }
+                cursor++;
+            }
+            else if (c == '{' || c == '[')
+            {
+                nesting++;
+            }
+            else if (c == '}' || c == ']')
+            {
+                nesting--;
+            }
+        }
+
+        if (nesting > 0)
+        {
+            hasError = true;
+        }
+    }
+
+    bool JsonScanner::IsAtPath(std::initializer_list<const char*> path) const
+    {
+        if ((int)path.size() != depth)
+        {
+            return false;
+        }
+
+        int level = 1;
+        for (const char* key : path)
+        {
+            if (!keys[level].Equals(key))
+            {
+                return false;
+            }
+
+            level++;
+        }
+
+        return true;
+    }
+}
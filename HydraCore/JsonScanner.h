@@ -0,0 +1,112 @@
+#pragma once
+#include <initializer_list>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+namespace HydraCore
+{
+    // Points at a string (without its quotes) or a number inside the document being scanned, so it's only valid as long as the document is
+    struct JsonString
+    {
+        const char* Data;
+        size_t Length;
+        bool HasEscapes;
+
+        // Compares the decoded string without allocating
+        // Keys are almost always compared against literals, so the common case is inline where the compiler can fold the literal's length.
+        inline bool Equals(const char* text) const
+        {
+            if (HasEscapes)
+            {
+                return EqualsEscaped(text);
+            }
+
+            size_t length = strlen(text);
+            return length == Length && (length == 0 || memcmp(Data, text, length) == 0);
+        }
+
+        bool EqualsEscaped(const char* text) const;
+
+        // Decodes escapes (including \u escapes, which are converted to UTF-8)
+        std::string ToString() const;
+
+        // Parses a number's integer part, returns false if this isn't a number or doesn't fit
+        bool ToInt64(int64_t& value) const;
+    };
+
+    enum JsonTokenType
+    {
+        JSON_TOKEN_OBJECT_START,
+        JSON_TOKEN_OBJECT_END,
+        JSON_TOKEN_ARRAY_START,
+        JSON_TOKEN_ARRAY_END,
+        JSON_TOKEN_STRING,
+        JSON_TOKEN_NUMBER,
+        JSON_TOKEN_TRUE,
+        JSON_TOKEN_FALSE,
+        JSON_TOKEN_NULL,
+    };
+
+    struct JsonToken
+    {
+        JsonTokenType Type;
+        // The string's contents or the number's text, empty for everything else
+        JsonString Text;
+    };
+
+    // Walks a JSON document one value at a time without building a tree or allocating anything.
+    // The scanner tracks the key each value was found under (and the keys of the objects around it) so callers can pick out the few values they care about
+    // and skip whole containers they don't. It is lenient about things a validator would reject (such as missing commas) as long as the structure is unambiguous.
+    class JsonScanner
+    {
+    public:
+        static const int MaxDepth = 32;
+    private:
+        const char* cursor;
+        const char* end;
+        bool hasError;
+
+        // keys[i] is the key of the value at depth i, which is empty for array elements and the document itself
+        JsonString keys[MaxDepth + 1];
+        bool isObject[MaxDepth + 1];
+        int depth;
+        // A container's start token is reported at its parent's depth, it's entered on the next call
+        bool enterPending;
+        bool enterObject;
+
+        void SkipWhitespace();
+        bool ScanString(JsonString& string);
+        bool Fail();
+    public:
+        JsonScanner(const char* data, size_t length);
+
+        // Returns false at the end of the document or if it is malformed (see HasError)
+        bool Next(JsonToken& token);
+
+        // Skips the rest of the container whose start token was just returned, the next token is whatever follows it
+        void SkipContainer();
+
+        // The number of containers around the last token (for start and end tokens, not counting the container itself)
+        inline int GetDepth() const
+        {
+            return depth;
+        }
+
+        // level is between 1 and GetDepth(), level GetDepth() is the last token's own key
+        inline const JsonString& GetKey(int level) const
+        {
+            return keys[level];
+        }
+
+        // Checks whether the keys leading to the last token are exactly the given ones, use "" for array elements
+        // IE: {"container", "rect", "x"} matches the x in {"container": {"rect": {"x": 0}}}
+        bool IsAtPath(std::initializer_list<const char*> path) const;
+
+        inline bool HasError() const
+        {
+            return hasError;
+        }
+    };
+}
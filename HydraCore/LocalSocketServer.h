@@ -0,0 +1,29 @@
+#pragma once
+#include <stdint.h>
+#include <string>
+
+namespace HydraCore
+{
+    // Streams messages to any number of local clients from a background thread
+    // Implemented by LocalSocketServerWin32.cpp (a named pipe) or LocalSocketServerPosix.cpp (a Unix domain socket.)
+    // The server never waits on its clients: one which stops reading is disconnected once its buffer fills up.
+    class LocalSocketServer
+    {
+    public:
+        virtual ~LocalSocketServer()
+        {
+        }
+
+        // Queues a message for every connected client, newly connected clients are sent the most recent message first
+        // Safe to call from any thread, this only hands the message to the server's thread.
+        virtual void Broadcast(const std::string& message) = 0;
+
+        virtual uint32_t GetClientCount() = 0;
+
+        // Gets the path clients connect to
+        virtual std::string GetPath() = 0;
+
+        // Starts listening on a path derived from the name, throws if that isn't possible (IE: another server is already using it)
+        static LocalSocketServer* Create(const std::string& name);
+    };
+}
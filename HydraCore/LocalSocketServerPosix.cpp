@@ -0,0 +1,292 @@
+#include "LocalSocketServer.h"
+
+#include <atomic>
+#include <errno.h>
+#include <fcntl.h>
+#include <mutex>
+#include <poll.h>
+#include <stdexcept>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace HydraCore
+{
+    class PosixLocalSocketServer : public LocalSocketServer
+    {
+    private:
+        // Messages beyond this are dropped (oldest first) if the server thread falls behind
+        static const size_t MaxQueuedMessages = 64;
+
+        std::string path;
+        int listenSocket;
+        int wakePipe[2];
+        std::thread thread;
+        std::atomic<bool> stop;
+        std::atomic<uint32_t> clientCount;
+
+        std::mutex queueMutex;
+        std::vector<std::string> queue;
+
+        // Only used by the server thread
+        std::vector<int> clients;
+        std::string lastMessage;
+
+        static std::runtime_error MakeException(const std::string& operation)
+        {
+            return std::runtime_error(operation + " failed: " + strerror(errno));
+        }
+
+        static bool Send(int client, const std::string& message)
+        {
+            // MSG_NOSIGNAL keeps a client which has gone away from killing the process with SIGPIPE
+            ssize_t sent = send(client, message.data(), message.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+            return sent == (ssize_t)message.size();
+        }
+
+        void RemoveClient(size_t index)
+        {
+            close(clients[index]);
+            clients.erase(clients.begin() + index);
+        }
+
+        void SendQueuedMessages()
+        {
+            char buffer[64];
+            while (read(wakePipe[0], buffer, sizeof(buffer)) > 0)
+            {
+            }
+
+            std::vector<std::string> messages;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                messages.swap(queue);
+            }
+
+            for (const std::string& message : messages)
+            {
+                for (size_t i = clients.size(); i-- > 0;)
+                {
+                    // A partial send would leave the client with half a message, so it's disconnected instead
+                    if (!Send(clients[i], message))
+                    {
+                        RemoveClient(i);
+                    }
+                }
+            }
+
+            if (messages.size() > 0)
+            {
+                lastMessage = messages.back();
+            }
+        }
+
+        void AcceptClient()
+        {
+            int client = accept(listenSocket, nullptr, nullptr);
+            if (client < 0)
+            {
+                return;
+            }
+
+            fcntl(client, F_SETFD, FD_CLOEXEC);
+            if (lastMessage.empty() || Send(client, lastMessage))
+            {
+                clients.push_back(client);
+            }
+            else
+            {
+                close(client);
+            }
+        }
+
+        void ThreadEntry()
+        {
+            std::vector<pollfd> pollFds;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                // Clients never send anything, so them becoming readable means they disconnected (or are misbehaving)
+                pollFds.clear();
+                pollFds.push_back({ listenSocket, POLLIN, 0 });
+                pollFds.push_back({ wakePipe[0], POLLIN, 0 });
+                for (int client : clients)
+                {
+                    pollFds.push_back({ client, POLLIN, 0 });
+                }
+
+                if (poll(pollFds.data(), (nfds_t)pollFds.size(), -1) < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    break;
+                }
+
+                for (size_t i = clients.size(); i-- > 0;)
+                {
+                    if (pollFds[i + 2].revents != 0)
+                    {
+                        RemoveClient(i);
+                    }
+                }
+
+                // Queued messages go out before accepting anyone so that new clients don't receive the latest message twice
+                if (pollFds[1].revents != 0)
+                {
+                    SendQueuedMessages();
+                }
+
+                if (pollFds[0].revents != 0)
+                {
+                    AcceptClient();
+                }
+
+                clientCount.store((uint32_t)clients.size(), std::memory_order_relaxed);
+            }
+        }
+
+        void Wake()
+        {
+            // The pipe being full just means a wake up is already pending
+            char wake = 0;
+            ssize_t result = write(wakePipe[1], &wake, 1);
+            (void)result;
+        }
+
+        bool Bind()
+        {
+            sockaddr_un address = {};
+            address.sun_family = AF_UNIX;
+            memcpy(address.sun_path, path.c_str(), path.size() + 1);
+            return bind(listenSocket, (sockaddr*)&address, sizeof(address)) == 0;
+        }
+
+        // Returns true if something is accepting connections on the path
+        bool IsPathInUse()
+        {
+            int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (probe < 0)
+            {
+                return false;
+            }
+
+            sockaddr_un address = {};
+            address.sun_family = AF_UNIX;
+            memcpy(address.sun_path, path.c_str(), path.size() + 1);
+            bool ret = connect(probe, (sockaddr*)&address, sizeof(address)) == 0;
+            close(probe);
+            return ret;
+        }
+    public:
+        PosixLocalSocketServer(const std::string& name)
+        {
+            // The runtime directory is private to the user, /tmp is the fallback for sessions which don't have one
+            const char* runtimeDirectory = getenv("XDG_RUNTIME_DIR");
+            if (runtimeDirectory != nullptr && runtimeDirectory[0] != '\0')
+            {
+                path = std::string(runtimeDirectory) + "/" + name + ".sock";
+            }
+            else
+            {
+                path = "/tmp/" + name + "-" + std::to_string(getuid()) + ".sock";
+            }
+
+            if (path.size() >= sizeof(sockaddr_un::sun_path))
+            {
+                throw std::runtime_error("The socket path '" + path + "' is too long.");
+            }
+
+            listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (listenSocket < 0)
+            {
+                throw MakeException("Creating the socket");
+            }
+            fcntl(listenSocket, F_SETFD, FD_CLOEXEC);
+
+            // A socket file left behind by a crash is replaced, but one which is still being served is not
+            bool bound = Bind();
+            if (!bound && errno == EADDRINUSE && !IsPathInUse())
+            {
+                unlink(path.c_str());
+                bound = Bind();
+            }
+
+            if (!bound || listen(listenSocket, 8) != 0)
+            {
+                std::runtime_error exception = MakeException("Listening on '" + path + "'");
+                close(listenSocket);
+                throw exception;
+            }
+
+            if (pipe(wakePipe) != 0)
+            {
+                std::runtime_error exception = MakeException("Creating the wake pipe");
+                close(listenSocket);
+                unlink(path.c_str());
+                throw exception;
+            }
+
+            for (int fileDescriptor : wakePipe)
+            {
+                fcntl(fileDescriptor, F_SETFD, FD_CLOEXEC);
+                fcntl(fileDescriptor, F_SETFL, O_NONBLOCK);
+            }
+
+            stop.store(false, std::memory_order_relaxed);
+            clientCount.store(0, std::memory_order_relaxed);
+            thread = std::thread(&PosixLocalSocketServer::ThreadEntry, this);
+        }
+
+        ~PosixLocalSocketServer()
+        {
+            stop.store(true, std::memory_order_relaxed);
+            Wake();
+            thread.join();
+
+            for (int client : clients)
+            {
+                close(client);
+            }
+
+            close(listenSocket);
+            unlink(path.c_str());
+            close(wakePipe[0]);
+            close(wakePipe[1]);
+        }
+
+        void Broadcast(const std::string& message) override
+        {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                if (queue.size() >= MaxQueuedMessages)
+                {
+                    queue.erase(queue.begin());
+                }
+                queue.push_back(message);
+            }
+
+            Wake();
+        }
+
+        uint32_t GetClientCount() override
+        {
+            return clientCount.load(std::memory_order_relaxed);
+        }
+
+        std::string GetPath() override
+        {
+            return path;
+        }
+    };
+
+    LocalSocketServer* LocalSocketServer::Create(const std::string& name)
+    {
+        return new PosixLocalSocketServer(name);
+    }
+}
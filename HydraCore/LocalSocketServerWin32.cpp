@@ -0,0 +1,241 @@
+#include "LocalSocketServer.h"
+#include "Win32Exception.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace HydraCore
+{
+    class Win32LocalSocketServer : public LocalSocketServer
+    {
+    private:
+        // Messages beyond this are dropped (oldest first) if the server thread falls behind
+        static const size_t MaxQueuedMessages = 64;
+        static const DWORD PipeBufferSize = 64 * 1024;
+
+        struct Client
+        {
+            HANDLE Pipe;
+            OVERLAPPED Overlapped;
+            // The message being written, which has to stay alive until the write completes
+            std::string Pending;
+        };
+
+        std::string path;
+        HANDLE wakeEvent;
+        HANDLE connectEvent;
+        std::thread thread;
+        std::atomic<bool> stop;
+        std::atomic<uint32_t> clientCount;
+
+        std::mutex queueMutex;
+        std::vector<std::string> queue;
+
+        // Only used by the server thread once it has started
+        HANDLE listeningPipe;
+        OVERLAPPED connectOverlapped;
+        std::vector<Client*> clients;
+        std::string lastMessage;
+
+        HANDLE CreateListeningPipe(bool firstInstance)
+        {
+            // The first instance claims the name, which fails if another server already has it
+            DWORD openMode = PIPE_ACCESS_OUTBOUND | FILE_FLAG_OVERLAPPED | (firstInstance ? FILE_FLAG_FIRST_PIPE_INSTANCE : 0);
+            return CreateNamedPipeA(path.c_str(), openMode, PIPE_TYPE_BYTE | PIPE_REJECT_REMOTE_CLIENTS, PIPE_UNLIMITED_INSTANCES, PipeBufferSize, 0, 0, NULL);
+        }
+
+        // Starts waiting for a client to connect to the listening pipe, connectEvent is signaled once one has
+        void Listen()
+        {
+            connectOverlapped = {};
+            connectOverlapped.hEvent = connectEvent;
+            if (!ConnectNamedPipe(listeningPipe, &connectOverlapped) && GetLastError() == ERROR_PIPE_CONNECTED)
+            {
+                // The client beat us to it
+                SetEvent(connectEvent);
+            }
+        }
+
+        static void CloseClient(Client* client)
+        {
+            // The pending write (if any) must finish before its buffer is freed
+            DWORD transferred;
+            CancelIoEx(client->Pipe, &client->Overlapped);
+            GetOverlappedResult(client->Pipe, &client->Overlapped, &transferred, TRUE);
+            DisconnectNamedPipe(client->Pipe);
+            CloseHandle(client->Pipe);
+            delete client;
+        }
+
+        static bool Send(Client* client, const std::string& message)
+        {
+            // A write which is still pending means the client stopped reading and the pipe's buffer is full
+            if (!HasOverlappedIoCompleted(&client->Overlapped))
+            {
+                return false;
+            }
+
+            client->Pending = message;
+            client->Overlapped = {};
+            return WriteFile(client->Pipe, client->Pending.data(), (DWORD)client->Pending.size(), NULL, &client->Overlapped) || GetLastError() == ERROR_IO_PENDING;
+        }
+
+        void SendQueuedMessages()
+        {
+            std::vector<std::string> messages;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                messages.swap(queue);
+            }
+
+            for (const std::string& message : messages)
+            {
+                for (size_t i = clients.size(); i-- > 0;)
+                {
+                    if (!Send(clients[i], message))
+                    {
+                        CloseClient(clients[i]);
+                        clients.erase(clients.begin() + i);
+                    }
+                }
+            }
+
+            if (messages.size() > 0)
+            {
+                lastMessage = messages.back();
+            }
+        }
+
+        void AcceptClient()
+        {
+            DWORD transferred;
+            Client* client = new Client();
+            client->Pipe = listeningPipe;
+            client->Overlapped = {};
+
+            if (GetOverlappedResult(listeningPipe, &connectOverlapped, &transferred, FALSE) && (lastMessage.empty() || Send(client, lastMessage)))
+            {
+                clients.push_back(client);
+            }
+            else
+            {
+                CloseClient(client);
+            }
+
+            // Every client gets its own instance of the pipe, so there's always a fresh one waiting for the next client
+            listeningPipe = CreateListeningPipe(false);
+            if (listeningPipe == INVALID_HANDLE_VALUE)
+            {
+                ResetEvent(connectEvent);
+                return;
+            }
+
+            Listen();
+        }
+
+        void ThreadEntry()
+        {
+            // Queued messages come first so that new clients don't receive the latest message twice
+            HANDLE events[] = { wakeEvent, connectEvent };
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                DWORD result = WaitForMultipleObjects(2, events, FALSE, INFINITE);
+                if (result == WAIT_OBJECT_0)
+                {
+                    SendQueuedMessages();
+                }
+                else if (result == WAIT_OBJECT_0 + 1)
+                {
+                    AcceptClient();
+                }
+                else
+                {
+                    break;
+                }
+
+                clientCount.store((uint32_t)clients.size(), std::memory_order_relaxed);
+            }
+        }
+    public:
+        Win32LocalSocketServer(const std::string& name)
+        {
+            path = "\\\\.\\pipe\\" + name;
+
+            wakeEvent = CreateEventA(NULL, FALSE, FALSE, NULL);
+            connectEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+            if (wakeEvent == NULL || connectEvent == NULL)
+            {
+                throw Win32Exception();
+            }
+
+            listeningPipe = CreateListeningPipe(true);
+            if (listeningPipe == INVALID_HANDLE_VALUE)
+            {
+                DWORD errorCode = GetLastError();
+                CloseHandle(wakeEvent);
+                CloseHandle(connectEvent);
+                throw Win32Exception(errorCode);
+            }
+
+            Listen();
+
+            stop.store(false, std::memory_order_relaxed);
+            clientCount.store(0, std::memory_order_relaxed);
+            thread = std::thread(&Win32LocalSocketServer::ThreadEntry, this);
+        }
+
+        ~Win32LocalSocketServer()
+        {
+            stop.store(true, std::memory_order_relaxed);
+            SetEvent(wakeEvent);
+            thread.join();
+
+            if (listeningPipe != INVALID_HANDLE_VALUE)
+            {
+                DWORD transferred;
+                CancelIoEx(listeningPipe, &connectOverlapped);
+                GetOverlappedResult(listeningPipe, &connectOverlapped, &transferred, TRUE);
+                CloseHandle(listeningPipe);
+            }
+
+            for (Client* client : clients)
+            {
+                CloseClient(client);
+            }
+
+            CloseHandle(wakeEvent);
+            CloseHandle(connectEvent);
+        }
+
+        void Broadcast(const std::string& message) override
+        {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                if (queue.size() >= MaxQueuedMessages)
+                {
+                    queue.erase(queue.begin());
+                }
+                queue.push_back(message);
+            }
+
+            SetEvent(wakeEvent);
+        }
+
+        uint32_t GetClientCount() override
+        {
+            return clientCount.load(std::memory_order_relaxed);
+        }
+
+        std::string GetPath() override
+        {
+            return path;
+        }
+    };
+
+    LocalSocketServer* LocalSocketServer::Create(const std::string& name)
+    {
+        return new Win32LocalSocketServer(name);
+    }
+}
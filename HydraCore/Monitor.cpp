@@ -1,5 +1,5 @@
+#include "DisplayPlatform.h"
 #include "Monitor.h"
-#include "Win32Exception.h"
 
 #include <algorithm>
 #include <stdexcept>
@@ -7,40 +7,14 @@
 
 namespace HydraCore
 {
-    Monitor::Monitor(uint32_t id, HMONITOR handle, LPRECT rectangle)
+    Monitor::Monitor(uint32_t id, MonitorHandle handle, const Rectangle& rectangle, const std::string& interfaceId, const std::string& name, bool isPrimary)
+        : handle(handle), id(id), interfaceId(interfaceId), name(name), rectangle(rectangle), isPrimary(isPrimary)
     {
-        this->id = id;
-        this->handle = handle;
-        
-        // Compute the virtual display rectangle
-        this->rectangle.Left = rectangle->left;
-        this->rectangle.Top = rectangle->top;
-        this->rectangle.Width = rectangle->right - rectangle->left;
-        this->rectangle.Height = rectangle->bottom - rectangle->top;
-
-        // Get extended monitor info
-        MONITORINFOEXA monitorInfo = {};
-        monitorInfo.cbSize = sizeof(monitorInfo);
-        if (!GetMonitorInfoA(handle, &monitorInfo))
-        {
-            throw Win32Exception();
-        }
-
-        name = std::string(monitorInfo.szDevice);
-        isPrimary = monitorInfo.dwFlags == MONITORINFOF_PRIMARY;
-
-        // Get the interface ID of the monitor
-        DISPLAY_DEVICEA deviceInfo = {};
-        deviceInfo.cb = sizeof(deviceInfo);
-        if (!EnumDisplayDevicesA(monitorInfo.szDevice, 0, &deviceInfo, EDD_GET_DEVICE_INTERFACE_NAME))
-        {
-            // EnumDisplayDevices doesn't set last error but is documented as only failing with bad parameters
-            SetLastError(ERROR_INVALID_PARAMETER);
-            throw Win32Exception();
-        }
-
-        interfaceId = std::string(deviceInfo.DeviceID);
+        BuildDescription();
+    }
 
+    void Monitor::BuildDescription()
+    {
         // Create the monitor description
         std::ostringstream descriptionBuilder;
 #if 0
@@ -56,21 +30,9 @@ namespace HydraCore
         description = descriptionBuilder.str();
     }
 
-    static BOOL CALLBACK GetAllMonitorsEnumerator(HMONITOR handle, HDC deviceCOntext, LPRECT rectangle, LPARAM settings)
-    {
-        auto list = (std::vector<Monitor>*)settings;
-        list->push_back(Monitor((uint32_t)list->size(), handle, rectangle));
-        return TRUE;
-    }
-
     std::vector<Monitor> Monitor::GetAllMonitors(bool sortLeftToRight)
     {
-        std::vector<Monitor> ret;
-
-        if (!EnumDisplayMonitors(NULL, NULL, GetAllMonitorsEnumerator, (LPARAM)&ret))
-        {
-            throw Win32Exception();
-        }
+        std::vector<Monitor> ret = DisplayPlatform::GetCurrent()->GetAllMonitors();
 
         if (sortLeftToRight)
         {
@@ -80,6 +42,12 @@ namespace HydraCore
         return ret;
     }
 
+    Monitor Monitor::GetPrimaryMonitor()
+    {
+        std::vector<Monitor> monitors = GetAllMonitors();
+        return GetPrimaryMonitor(monitors);
+    }
+
     Monitor Monitor::GetPrimaryMonitor(std::vector<Monitor>& monitors)
     {
         for (Monitor& monitor : monitors)
@@ -100,9 +68,55 @@ namespace HydraCore
         throw new std::runtime_error("This system has no monitors attached.");
     }
 
-    Monitor Monitor::GetPrimaryMonitor()
+    Monitor* Monitor::GetMonitorNearestPoint(std::vector<Monitor>& monitors, int32_t x, int32_t y)
     {
-        std::vector<Monitor> monitors = GetAllMonitors();
-        return GetPrimaryMonitor(monitors);
+        Monitor* ret = nullptr;
+        int64_t retDistance = 0;
+
+        for (Monitor& monitor : monitors)
+        {
+            int64_t distanceX = GetDistanceOutside(x, monitor.rectangle.Left, monitor.rectangle.Width);
+            int64_t distanceY = GetDistanceOutside(y, monitor.rectangle.Top, monitor.rectangle.Height);
+            int64_t distance = distanceX * distanceX + distanceY * distanceY;
+
+            if (ret == nullptr || distance < retDistance)
+            {
+                ret = &monitor;
+                retDistance = distance;
+            }
+        }
+
+        return ret;
+    }
+
+    // 64-bit FNV-1a
+    static const uint64_t FingerprintOffsetBasis = 14695981039346656037ull;
+    static const uint64_t FingerprintPrime = 1099511628211ull;
+
+    static void AddToFingerprint(uint64_t& fingerprint, const void* data, size_t size)
+    {
+        const unsigned char* bytes = (const unsigned char*)data;
+        for (size_t i = 0; i < size; i++)
+        {
+            fingerprint ^= bytes[i];
+            fingerprint *= FingerprintPrime;
+        }
+    }
+
+    uint64_t Monitor::GetTopologyFingerprint(std::vector<Monitor>& monitors)
+    {
+        uint64_t fingerprint = FingerprintOffsetBasis;
+
+        for (Monitor& monitor : monitors)
+        {
+            // Strings include their null terminators so adjacent fields can't run together
+            AddToFingerprint(fingerprint, monitor.interfaceId.c_str(), monitor.interfaceId.size() + 1);
+            AddToFingerprint(fingerprint, monitor.name.c_str(), monitor.name.size() + 1);
+
+            int32_t layout[] = { monitor.rectangle.Left, monitor.rectangle.Top, (int32_t)monitor.rectangle.Width, (int32_t)monitor.rectangle.Height, monitor.isPrimary ? 1 : 0 };
+            AddToFingerprint(fingerprint, layout, sizeof(layout));
+        }
+
+        return fingerprint;
     }
 }
@@ -1,26 +1,39 @@
 #pragma once
 #include <string>
 #include <vector>
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
 #include "Rectangle.h"
 
 namespace HydraCore
 {
+#ifdef _WIN32
+    typedef HMONITOR MonitorHandle;
+#else
+    typedef void* MonitorHandle;
+#endif
+
     class Monitor
     {
     private:
-        HMONITOR handle;
+        MonitorHandle handle;
         uint32_t id;
         std::string interfaceId;
         std::string name;
         std::string description;
         Rectangle rectangle;
         bool isPrimary;
+
+        void BuildDescription();
     public:
+        Monitor(uint32_t id, MonitorHandle handle, const Rectangle& rectangle, const std::string& interfaceId, const std::string& name, bool isPrimary);
+#ifdef _WIN32
         Monitor(uint32_t id, HMONITOR handle, LPRECT rectangle);
+#endif
 
-        inline HMONITOR GetHandle()
+        inline MonitorHandle GetHandle()
         {
             return handle;
         }
@@ -65,8 +78,15 @@ namespace HydraCore
             return isPrimary;
         }
 
+        // Enumerates the monitors of the current platform (see DisplayPlatform::GetCurrent)
         static std::vector<Monitor> GetAllMonitors(bool sortLeftToRight = false);
         static Monitor GetPrimaryMonitor();
         static Monitor GetPrimaryMonitor(std::vector<Monitor>& monitors);
+
+        // Gets the monitor containing the given point, or the closest one if no monitor contains it. Returns null if the list is empty.
+        static Monitor* GetMonitorNearestPoint(std::vector<Monitor>& monitors, int32_t x, int32_t y);
+
+        // Gets a hash of the identity, layout, and order of the given monitors which can be saved to tell if the topology changed since
+        static uint64_t GetTopologyFingerprint(std::vector<Monitor>& monitors);
     };
 }
@@ -0,0 +1,104 @@
+#include "MonitorTrackingPolicy.h"
+
+namespace HydraCore
+{
+    MonitorTrackingPolicy::MonitorTrackingPolicy()
+    {
+        mode = MONITOR_TRACKING_MODE_FOCUS;
+        dwellTime = 0;
+
+        focusMonitor = nullptr;
+        focusTimestamp = 0;
+        focusPending = false;
+
+        cursorMonitor = nullptr;
+        cursorTimestamp = 0;
+        cursorPending = false;
+
+        chosenMonitor = nullptr;
+    }
+
+    void MonitorTrackingPolicy::SetMode(MonitorTrackingMode mode, uint64_t dwellTime)
+    {
+        if (this->mode == mode && this->dwellTime == dwellTime)
+        {
+            return;
+        }
+
+        this->mode = mode;
+        this->dwellTime = dwellTime;
+
+        // Re-evaluate the latest inputs under the new mode
+        focusPending = focusMonitor != nullptr;
+        cursorPending = cursorMonitor != nullptr;
+    }
+
+    void MonitorTrackingPolicy::FocusChanged(MonitorHandle monitor, uint64_t timestamp)
+    {
+        focusMonitor = monitor;
+        focusTimestamp = timestamp;
+        focusPending = true;
+    }
+
+    void MonitorTrackingPolicy::CursorChanged(MonitorHandle monitor, uint64_t timestamp)
+    {
+        cursorMonitor = monitor;
+        cursorTimestamp = timestamp;
+        cursorPending = true;
+    }
+
+    bool MonitorTrackingPolicy::Update(uint64_t time, MonitorHandle& newMonitor, uint64_t& changeTimestamp)
+    {
+        MonitorHandle oldMonitor = chosenMonitor;
+
+        switch (mode)
+        {
+            case MONITOR_TRACKING_MODE_FOCUS:
+                if (focusPending)
+                {
+                    chosenMonitor = focusMonitor;
+                    changeTimestamp = focusTimestamp;
+                }
+                cursorPending = false;
+                break;
+            case MONITOR_TRACKING_MODE_CURSOR:
+                if (cursorPending)
+                {
+                    chosenMonitor = cursorMonitor;
+                    changeTimestamp = cursorTimestamp;
+                }
+                focusPending = false;
+                break;
+            case MONITOR_TRACKING_MODE_CURSOR_AFTER_DWELL:
+                if (focusPending)
+                {
+                    chosenMonitor = focusMonitor;
+                    changeTimestamp = focusTimestamp;
+                }
+
+                // The cursor only wins once per arrival, so focusing another monitor while the cursor rests doesn't get overridden
+                if (cursorPending && time >= cursorTimestamp + dwellTime)
+                {
+                    cursorPending = false;
+
+                    // If focus changed after the dwell elapsed, focus is the more recent decision
+                    if (focusTimestamp <= cursorTimestamp + dwellTime)
+                    {
+                        chosenMonitor = cursorMonitor;
+                        changeTimestamp = cursorTimestamp + dwellTime;
+                    }
+                }
+                break;
+        }
+
+        focusPending = false;
+
+        if (chosenMonitor == oldMonitor)
+        {
+            return false;
+        }
+
+        newMonitor = chosenMonitor;
+        return true;
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <stdint.h>
+
+#include "Monitor.h"
+
+namespace HydraCore
+{
+    enum MonitorTrackingMode
+    {
+        // Follow the monitor containing the foreground window
+        MONITOR_TRACKING_MODE_FOCUS,
+        // Follow the monitor under the cursor
+        MONITOR_TRACKING_MODE_CURSOR,
+        // Follow focus, but switch to the cursor's monitor once the cursor has stayed there long enough
+        MONITOR_TRACKING_MODE_CURSOR_AFTER_DWELL,
+    };
+
+    // Decides which monitor should be shown based on the focus and cursor trackers.
+    // Inputs are fed in as they're observed and the decision is made whenever Update is called (IE: once per frame.)
+    class MonitorTrackingPolicy
+    {
+    private:
+        MonitorTrackingMode mode;
+        uint64_t dwellTime;
+
+        MonitorHandle focusMonitor;
+        uint64_t focusTimestamp;
+        bool focusPending;
+
+        MonitorHandle cursorMonitor;
+        uint64_t cursorTimestamp;
+        bool cursorPending;
+
+        MonitorHandle chosenMonitor;
+    public:
+        MonitorTrackingPolicy();
+
+        // dwellTime is in nanoseconds and only applies to MONITOR_TRACKING_MODE_CURSOR_AFTER_DWELL
+        void SetMode(MonitorTrackingMode mode, uint64_t dwellTime);
+
+        void FocusChanged(MonitorHandle monitor, uint64_t timestamp);
+        void CursorChanged(MonitorHandle monitor, uint64_t timestamp);
+
+        // Returns true if the chosen monitor changed, in which case the new monitor and the time it was chosen are returned.
+        bool Update(uint64_t time, MonitorHandle& newMonitor, uint64_t& changeTimestamp);
+
+        inline MonitorTrackingMode GetMode()
+        {
+            return mode;
+        }
+
+        inline MonitorHandle GetChosenMonitor()
+        {
+            return chosenMonitor;
+        }
+    };
+}
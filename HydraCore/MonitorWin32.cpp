@@ -0,0 +1,42 @@
+#include "Monitor.h"
+#include "Win32Exception.h"
+
+namespace HydraCore
+{
+    Monitor::Monitor(uint32_t id, HMONITOR handle, LPRECT rectangle)
+    {
+        this->id = id;
+        this->handle = handle;
+        
+        // Compute the virtual display rectangle
+        this->rectangle.Left = rectangle->left;
+        this->rectangle.Top = rectangle->top;
+        this->rectangle.Width = rectangle->right - rectangle->left;
+        this->rectangle.Height = rectangle->bottom - rectangle->top;
+
+        // Get extended monitor info
+        MONITORINFOEXA monitorInfo = {};
+        monitorInfo.cbSize = sizeof(monitorInfo);
+        if (!GetMonitorInfoA(handle, &monitorInfo))
+        {
+            throw Win32Exception();
+        }
+
+        name = std::string(monitorInfo.szDevice);
+        isPrimary = monitorInfo.dwFlags == MONITORINFOF_PRIMARY;
+
+        // Get the interface ID of the monitor
+        DISPLAY_DEVICEA deviceInfo = {};
+        deviceInfo.cb = sizeof(deviceInfo);
+        if (!EnumDisplayDevicesA(monitorInfo.szDevice, 0, &deviceInfo, EDD_GET_DEVICE_INTERFACE_NAME))
+        {
+            // EnumDisplayDevices doesn't set last error but is documented as only failing with bad parameters
+            SetLastError(ERROR_INVALID_PARAMETER);
+            throw Win32Exception();
+        }
+
+        interfaceId = std::string(deviceInfo.DeviceID);
+
+        BuildDescription();
+    }
+}
@@ -0,0 +1,186 @@
+#include "MonitorX11.h"
+
+#include <stdexcept>
+#include <stdlib.h>
+#include <string>
+#include <xcb/randr.h>
+#include <xcb/xinerama.h>
+
+namespace HydraCore
+{
+    // X has no monitor handles, so the handle is derived from the monitor's index
+    // Like HMONITOR, this is only meaningful until the topology changes.
+    static MonitorHandle GetMonitorHandle(uint32_t id)
+    {
+        return (MonitorHandle)(uintptr_t)(id + 1);
+    }
+
+    static std::string GetOutputName(xcb_connection_t* connection, xcb_randr_output_t output, xcb_timestamp_t configTimestamp)
+    {
+        xcb_randr_get_output_info_reply_t* reply = xcb_randr_get_output_info_reply(connection, xcb_randr_get_output_info(connection, output, configTimestamp), nullptr);
+        if (reply == nullptr)
+        {
+            return std::string();
+        }
+
+        std::string ret((const char*)xcb_randr_get_output_info_name(reply), xcb_randr_get_output_info_name_length(reply));
+        free(reply);
+        return ret;
+    }
+
+    static bool GetRandrMonitors(xcb_connection_t* connection, xcb_screen_t* screen, std::vector<Monitor>& monitors)
+    {
+        const xcb_query_extension_reply_t* extension = xcb_get_extension_data(connection, &xcb_randr_id);
+        if (extension == nullptr || !extension->present)
+        {
+            return false;
+        }
+
+        // GetScreenResourcesCurrent and GetOutputPrimary were added in RandR 1.3
+        xcb_randr_query_version_reply_t* version = xcb_randr_query_version_reply(connection, xcb_randr_query_version(connection, 1, 3), nullptr);
+        bool hasCurrentResources = version != nullptr && (version->major_version > 1 || version->minor_version >= 3);
+        free(version);
+
+        if (!hasCurrentResources)
+        {
+            return false;
+        }
+
+        xcb_randr_get_screen_resources_current_cookie_t resourcesCookie = xcb_randr_get_screen_resources_current(connection, screen->root);
+        xcb_randr_get_output_primary_cookie_t primaryCookie = xcb_randr_get_output_primary(connection, screen->root);
+        xcb_randr_get_screen_resources_current_reply_t* resources = xcb_randr_get_screen_resources_current_reply(connection, resourcesCookie, nullptr);
+        xcb_randr_get_output_primary_reply_t* primary = xcb_randr_get_output_primary_reply(connection, primaryCookie, nullptr);
+        xcb_randr_output_t primaryOutput = primary == nullptr ? XCB_NONE : primary->output;
+        free(primary);
+
+        if (resources == nullptr)
+        {
+            return false;
+        }
+
+        // xshm_input's screen index is an index into the CRTC list (see randr_screen_geo in linux-capture/xhelpers.c), and that list includes CRTCs which are turned off.
+        // The monitor ID is that same index, so CRTCs which are off are skipped without renumbering the ones after them.
+        // (xshm_input asks for the list with GetScreenResources, which may reprobe the outputs, but the CRTCs and their order are the same either way.)
+        xcb_randr_crtc_t* crtcs = xcb_randr_get_screen_resources_current_crtcs(resources);
+        int crtcCount = xcb_randr_get_screen_resources_current_crtcs_length(resources);
+
+        std::vector<xcb_randr_get_crtc_info_cookie_t> crtcCookies;
+        for (int i = 0; i < crtcCount; i++)
+        {
+            crtcCookies.push_back(xcb_randr_get_crtc_info(connection, crtcs[i], resources->config_timestamp));
+        }
+
+        for (int i = 0; i < crtcCount; i++)
+        {
+            xcb_randr_get_crtc_info_reply_t* crtc = xcb_randr_get_crtc_info_reply(connection, crtcCookies[i], nullptr);
+            if (crtc == nullptr)
+            {
+                continue;
+            }
+
+            xcb_randr_output_t* outputs = xcb_randr_get_crtc_info_outputs(crtc);
+            int outputCount = xcb_randr_get_crtc_info_outputs_length(crtc);
+
+            if (crtc->mode != XCB_NONE && crtc->width > 0 && crtc->height > 0 && outputCount > 0)
+            {
+                bool isPrimary = false;
+                for (int j = 0; j < outputCount; j++)
+                {
+                    isPrimary |= outputs[j] == primaryOutput;
+                }
+
+                // The name of the CRTC's first output (IE: "DP-1") is stable across reboots so it doubles as the interface ID
+                uint32_t id = (uint32_t)i;
+                std::string name = GetOutputName(connection, outputs[0], resources->config_timestamp);
+                Rectangle rectangle = { crtc->x, crtc->y, crtc->width, crtc->height };
+                monitors.push_back(Monitor(id, GetMonitorHandle(id), rectangle, name, name, isPrimary));
+            }
+
+            free(crtc);
+        }
+
+        free(resources);
+        return monitors.size() > 0;
+    }
+
+    static bool GetXineramaMonitors(xcb_connection_t* connection, std::vector<Monitor>& monitors)
+    {
+        const xcb_query_extension_reply_t* extension = xcb_get_extension_data(connection, &xcb_xinerama_id);
+        if (extension == nullptr || !extension->present)
+        {
+            return false;
+        }
+
+        xcb_xinerama_is_active_reply_t* active = xcb_xinerama_is_active_reply(connection, xcb_xinerama_is_active(connection), nullptr);
+        bool isActive = active != nullptr && active->state != 0;
+        free(active);
+
+        if (!isActive)
+        {
+            return false;
+        }
+
+        xcb_xinerama_query_screens_reply_t* reply = xcb_xinerama_query_screens_reply(connection, xcb_xinerama_query_screens(connection), nullptr);
+        if (reply == nullptr)
+        {
+            return false;
+        }
+
+        uint32_t id = 0;
+        for (xcb_xinerama_screen_info_iterator_t iterator = xcb_xinerama_query_screens_screen_info_iterator(reply); iterator.rem > 0; xcb_xinerama_screen_info_next(&iterator))
+        {
+            xcb_xinerama_screen_info_t* info = iterator.data;
+            std::string name = "XINERAMA-" + std::to_string(id);
+            Rectangle rectangle = { info->x_org, info->y_org, info->width, info->height };
+
+            // Xinerama has no concept of a primary screen, the first one is treated as primary by convention
+            monitors.push_back(Monitor(id, GetMonitorHandle(id), rectangle, name, name, id == 0));
+            id++;
+        }
+
+        free(reply);
+        return monitors.size() > 0;
+    }
+
+    std::vector<Monitor> GetAllMonitorsX11(xcb_connection_t* connection, xcb_screen_t* screen)
+    {
+        std::vector<Monitor> ret;
+
+        if (GetRandrMonitors(connection, screen, ret) || GetXineramaMonitors(connection, ret))
+        {
+            return ret;
+        }
+
+        // Without either extension the whole X screen is the only monitor
+        Rectangle rectangle = { 0, 0, screen->width_in_pixels, screen->height_in_pixels };
+        ret.push_back(Monitor(0, GetMonitorHandle(0), rectangle, "SCREEN", "SCREEN", true));
+        return ret;
+    }
+
+    xcb_connection_t* ConnectX11(xcb_screen_t** screen)
+    {
+        int screenNumber;
+        xcb_connection_t* connection = xcb_connect(nullptr, &screenNumber);
+
+        if (xcb_connection_has_error(connection))
+        {
+            xcb_disconnect(connection);
+            return nullptr;
+        }
+
+        xcb_screen_iterator_t iterator = xcb_setup_roots_iterator(xcb_get_setup(connection));
+        for (int i = 0; i < screenNumber && iterator.rem > 0; i++)
+        {
+            xcb_screen_next(&iterator);
+        }
+
+        if (iterator.rem == 0)
+        {
+            xcb_disconnect(connection);
+            return nullptr;
+        }
+
+        *screen = iterator.data;
+        return connection;
+    }
+}
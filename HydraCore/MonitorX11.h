@@ -0,0 +1,15 @@
+#pragma once
+#include <vector>
+#include <xcb/xcb.h>
+
+#include "Monitor.h"
+
+namespace HydraCore
+{
+    // Monitors are numbered the same way OBS's xshm_input numbers its screens, so a monitor's ID can be used as its screen index.
+    // (The index of the monitor's RandR CRTC if the server supports RandR 1.3, otherwise its Xinerama screen, otherwise the whole X screen.)
+    std::vector<Monitor> GetAllMonitorsX11(xcb_connection_t* connection, xcb_screen_t* screen);
+
+    // Returns null if the connection failed
+    xcb_connection_t* ConnectX11(xcb_screen_t** screen);
+}
@@ -0,0 +1,72 @@
+#include "MotionQuality.h"
+
+namespace HydraCore
+{
+    const double MotionQualityTracker::AverageWeight = 0.1;
+
+    MotionQualityTracker::MotionQualityTracker()
+    {
+        isSliding = false;
+        isReduced = false;
+        frameCount = 0;
+        slideCount = 0;
+
+        for (int i = 0; i < 2; i++)
+        {
+            averageMilliseconds[i] = 0.0;
+            hasAverage[i] = false;
+        }
+    }
+
+    bool MotionQualityTracker::Update(bool isAnimating, bool reductionEnabled, SlideReport& report)
+    {
+        if (isAnimating)
+        {
+            // The decision is made once per slide so a slide never changes resolution part way through
+            if (!isSliding)
+            {
+                isSliding = true;
+                isReduced = reductionEnabled && slideCount % CalibrationInterval != 0;
+                frameCount = 0;
+                slideCount++;
+            }
+
+            frameCount++;
+            return false;
+        }
+
+        if (!isSliding)
+        {
+            return false;
+        }
+
+        isSliding = false;
+        report.FrameCount = frameCount;
+        report.WasReduced = isReduced;
+        report.ReducedMillisecondsPerFrame = hasAverage[1] ? averageMilliseconds[1] : 0.0;
+        report.FullMillisecondsPerFrame = hasAverage[0] ? averageMilliseconds[0] : 0.0;
+        report.SavedMilliseconds = 0.0;
+
+        if (isReduced && hasAverage[0] && hasAverage[1])
+        {
+            report.SavedMilliseconds = (averageMilliseconds[0] - averageMilliseconds[1]) * (double)frameCount;
+        }
+
+        isReduced = false;
+
+        // Once reduction is turned off the next slide it's turned back on for calibrates again
+        if (!reductionEnabled)
+        {
+            slideCount = 0;
+        }
+
+        return true;
+    }
+
+    void MotionQualityTracker::AddSample(bool reduced, double milliseconds)
+    {
+        int index = reduced ? 1 : 0;
+        averageMilliseconds[index] = hasAverage[index] ? averageMilliseconds[index] + (milliseconds - averageMilliseconds[index]) * AverageWeight : milliseconds;
+        hasAverage[index] = true;
+    }
+}
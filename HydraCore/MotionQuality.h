@@ -0,0 +1,54 @@
+#pragma once
+#include <stdint.h>
+
+namespace HydraCore
+{
+    // What one slide cost, reported once it has settled
+    struct SlideReport
+    {
+        uint64_t FrameCount;
+        bool WasReduced;
+        // The average GPU time of a slide frame at reduced and at full resolution, 0 if none have been measured yet
+        double ReducedMillisecondsPerFrame;
+        double FullMillisecondsPerFrame;
+        // The GPU time the slide saved by being drawn at reduced resolution, 0 if it wasn't or either average is missing
+        double SavedMilliseconds;
+    };
+
+    // Decides which slides are drawn at reduced resolution and estimates how much GPU time that saves.
+    // Every CalibrationInterval-th slide is drawn at full resolution so there's always a recent full-resolution cost to compare against.
+    class MotionQualityTracker
+    {
+    private:
+        static const uint32_t CalibrationInterval = 8;
+        // Each new measurement moves its average this far towards it
+        static const double AverageWeight;
+
+        bool isSliding;
+        bool isReduced;
+        uint64_t frameCount;
+        uint32_t slideCount;
+        // Indexed by whether the measured frame was reduced
+        double averageMilliseconds[2];
+        bool hasAverage[2];
+    public:
+        MotionQualityTracker();
+
+        // Called once per frame, returns true when a slide has just settled and fills in its report
+        bool Update(bool isAnimating, bool reductionEnabled, SlideReport& report);
+
+        inline bool IsSliding() const
+        {
+            return isSliding;
+        }
+
+        // True if the current frame should be drawn at reduced resolution
+        inline bool IsReduced() const
+        {
+            return isReduced;
+        }
+
+        // Adds the GPU time of one slide frame, measurements come back a few frames late so they are tagged with how the frame was drawn
+        void AddSample(bool reduced, double milliseconds);
+    };
+}
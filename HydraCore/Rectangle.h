@@ -10,4 +10,22 @@ namespace HydraCore
         uint32_t Width;
         uint32_t Height;
     };
+
+    // Gets how far value is outside of [start, start + length), or 0 if it is inside
+    inline int64_t GetDistanceOutside(int32_t value, int32_t start, uint32_t length)
+    {
+        int64_t end = (int64_t)start + length;
+
+        if (value < start)
+        {
+            return (int64_t)start - value;
+        }
+
+        if (value >= end)
+        {
+            return value - (end - 1);
+        }
+
+        return 0;
+    }
 }
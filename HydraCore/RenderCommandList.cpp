@@ -0,0 +1,89 @@
+#include "RenderCommandList.h"
+
+#include <string.h>
+
+namespace HydraCore
+{
+    static void AddSolid(std::vector<RenderCommand>& commands, float x, float y, uint32_t width, uint32_t height)
+    {
+        RenderCommand command = {};
+        command.Type = RENDER_COMMAND_DRAW_SOLID;
+        command.X = x;
+        command.Y = y;
+        command.Width = width;
+        command.Height = height;
+        commands.push_back(command);
+    }
+
+    void RecordComposite(const CompositeLayout& layout, const RenderCommandInputs& inputs, const float* outlineColor, std::vector<RenderCommand>& commands)
+    {
+        // Only the active child is always redrawn, see FrameBudgetLevel::TileRefreshDivisor
+        for (const CompositeTile& tile : layout.GetTiles())
+        {
+            RenderCommand command = {};
+            command.Type = inputs.TileRefreshDivisor > 1 && tile.Child != inputs.ActiveChild ? RENDER_COMMAND_DRAW_THROTTLED_TILE : RENDER_COMMAND_DRAW_TILE;
+            command.Child = tile.Child;
+            command.X = tile.X;
+            command.Y = tile.Y;
+            commands.push_back(command);
+        }
+
+        if (!layout.IsOutlineVisible())
+        {
+            return;
+        }
+
+        RenderCommand begin = {};
+        begin.Type = RENDER_COMMAND_BEGIN_SOLID;
+        memcpy(begin.Color, outlineColor, sizeof(begin.Color));
+        commands.push_back(begin);
+
+        // Top, left, right, and bottom, the sides overlap the top and bottom
+        const CompositeOutline& outline = layout.GetOutline();
+        AddSolid(commands, outline.X, outline.Y, outline.Width, outline.Thickness);
+        AddSolid(commands, outline.X, outline.Y, outline.Thickness, outline.Height);
+        AddSolid(commands, outline.X + (float)(outline.Width - outline.Thickness), outline.Y, outline.Thickness, outline.Height);
+        AddSolid(commands, outline.X, outline.Y + (float)(outline.Height - outline.Thickness), outline.Width, outline.Thickness);
+
+        RenderCommand end = {};
+        end.Type = RENDER_COMMAND_END_SOLID;
+        commands.push_back(end);
+    }
+
+    bool AreRenderCommandsEqual(const std::vector<RenderCommand>& a, const std::vector<RenderCommand>& b)
+    {
+        // Commands are always zero-initialized before they're filled in, so there's no uninitialized padding to trip over
+        return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(RenderCommand)) == 0);
+    }
+
+    RenderCommandList::RenderCommandList()
+    {
+        inputs = {};
+        isRecorded = false;
+        recordCount = 0;
+    }
+
+    bool RenderCommandList::NeedsRecording(const RenderCommandInputs& inputs) const
+    {
+        return !isRecorded
+            || inputs.ActiveChild != this->inputs.ActiveChild
+            || inputs.Position != this->inputs.Position
+            || inputs.IsAnimating != this->inputs.IsAnimating
+            || inputs.TileRefreshDivisor != this->inputs.TileRefreshDivisor
+            || inputs.SettingsVersion != this->inputs.SettingsVersion;
+    }
+
+    void RenderCommandList::Record(const CompositeLayout& layout, const RenderCommandInputs& inputs, const float* outlineColor)
+    {
+        commands.clear();
+        RecordComposite(layout, inputs, outlineColor, commands);
+        this->inputs = inputs;
+        isRecorded = true;
+        recordCount++;
+    }
+
+    void RenderCommandList::Invalidate()
+    {
+        isRecorded = false;
+    }
+}
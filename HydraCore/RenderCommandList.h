@@ -0,0 +1,86 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+#include "CompositeLayout.h"
+
+namespace HydraCore
+{
+    enum RenderCommandType
+    {
+        // Draws Child with its tile's top-left corner at X, Y (the child's RenderTransform places it within the tile)
+        RENDER_COMMAND_DRAW_TILE,
+        // Like RENDER_COMMAND_DRAW_TILE, but the tile is only redrawn on its refresh frames (see IsTileRefreshFrame)
+        RENDER_COMMAND_DRAW_THROTTLED_TILE,
+        // Starts a run of solid rectangles in Color, which is RGBA and not premultiplied (like the solid effect's color parameter)
+        RENDER_COMMAND_BEGIN_SOLID,
+        // A solid rectangle at X, Y of Width x Height
+        RENDER_COMMAND_DRAW_SOLID,
+        RENDER_COMMAND_END_SOLID,
+    };
+
+    struct RenderCommand
+    {
+        RenderCommandType Type;
+        uint32_t Child;
+        float X;
+        float Y;
+        uint32_t Width;
+        uint32_t Height;
+        float Color[4];
+    };
+
+    // Everything a recorded composite depends on besides the layout's settings, which are covered by SettingsVersion
+    struct RenderCommandInputs
+    {
+        uint32_t ActiveChild;
+        float Position;
+        bool IsAnimating;
+        uint32_t TileRefreshDivisor;
+        // Changed by the owner whenever anything the layout or the commands are built from changes (the size, enabled children, the outline, etc.)
+        uint64_t SettingsVersion;
+    };
+
+    // Records the draws for a composite: its tiles, followed by the overview outline if it's visible
+    // The commands are appended, outlineColor is RGBA and not premultiplied.
+    void RecordComposite(const CompositeLayout& layout, const RenderCommandInputs& inputs, const float* outlineColor, std::vector<RenderCommand>& commands);
+
+    bool AreRenderCommandsEqual(const std::vector<RenderCommand>& a, const std::vector<RenderCommand>& b);
+
+    // The recorded draws for the composite, which don't change between focus changes so they're recorded once and replayed until one of their inputs changes.
+    // Only the composite's own draws are recorded, what each child draws for its tile is still decided when the commands are replayed.
+    class RenderCommandList
+    {
+    private:
+        std::vector<RenderCommand> commands;
+        RenderCommandInputs inputs;
+        bool isRecorded;
+        uint64_t recordCount;
+    public:
+        RenderCommandList();
+
+        // True if the inputs differ from the ones the commands were recorded with (or nothing has been recorded yet)
+        bool NeedsRecording(const RenderCommandInputs& inputs) const;
+
+        // Replaces the commands with the given layout's
+        void Record(const CompositeLayout& layout, const RenderCommandInputs& inputs, const float* outlineColor);
+
+        // Forces the next NeedsRecording to return true
+        void Invalidate();
+
+        inline const std::vector<RenderCommand>& GetCommands() const
+        {
+            return commands;
+        }
+
+        inline const RenderCommandInputs& GetInputs() const
+        {
+            return inputs;
+        }
+
+        inline uint64_t GetRecordCount() const
+        {
+            return recordCount;
+        }
+    };
+}
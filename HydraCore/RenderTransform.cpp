@@ -0,0 +1,126 @@
+#include "RenderTransform.h"
+
+#include <algorithm>
+
+namespace HydraCore
+{
+    const char* GetScalePathName(ScalePath path)
+    {
+        switch (path)
+        {
+            case SCALE_PATH_IDENTITY: return "Identity";
+            case SCALE_PATH_INTEGER_DOWNSCALE: return "Integer Downscale";
+            case SCALE_PATH_INTEGER_UPSCALE: return "Integer Upscale";
+            case SCALE_PATH_FILTERED: return "Filtered";
+            default: return "Unknown";
+        }
+    }
+
+    static void ChooseScalePath(RenderTransform& transform)
+    {
+        transform.Path = SCALE_PATH_FILTERED;
+        transform.ScaleFactor = 1;
+
+        // Integer paths only apply when the destination lands on whole pixels
+        if (transform.X != (float)(uint32_t)transform.X || transform.Y != (float)(uint32_t)transform.Y
+            || transform.Width != (float)(uint32_t)transform.Width || transform.Height != (float)(uint32_t)transform.Height)
+        {
+            return;
+        }
+
+        uint32_t destinationWidth = (uint32_t)transform.Width;
+        uint32_t destinationHeight = (uint32_t)transform.Height;
+
+        if (destinationWidth == transform.SourceWidth && destinationHeight == transform.SourceHeight)
+        {
+            transform.Path = SCALE_PATH_IDENTITY;
+        }
+        else if (transform.SourceWidth % destinationWidth == 0 && transform.SourceHeight % destinationHeight == 0
+            && transform.SourceWidth / destinationWidth == transform.SourceHeight / destinationHeight)
+        {
+            transform.Path = SCALE_PATH_INTEGER_DOWNSCALE;
+            transform.ScaleFactor = transform.SourceWidth / destinationWidth;
+        }
+        else if (destinationWidth % transform.SourceWidth == 0 && destinationHeight % transform.SourceHeight == 0
+            && destinationWidth / transform.SourceWidth == destinationHeight / transform.SourceHeight)
+        {
+            transform.Path = SCALE_PATH_INTEGER_UPSCALE;
+            transform.ScaleFactor = destinationWidth / transform.SourceWidth;
+        }
+    }
+
+    RenderTransform ComputeRenderTransform(uint32_t sourceWidth, uint32_t sourceHeight, const Margins& crop, uint32_t targetWidth, uint32_t targetHeight, ScaleMode scaleMode)
+    {
+        RenderTransform ret = {};
+
+        // Crops which would consume the entire source are ignored
+        uint32_t regionX = 0;
+        uint32_t regionY = 0;
+        uint32_t regionWidth = sourceWidth;
+        uint32_t regionHeight = sourceHeight;
+
+        if ((uint64_t)crop.Left + crop.Right < sourceWidth)
+        {
+            regionX = crop.Left;
+            regionWidth = sourceWidth - crop.Left - crop.Right;
+        }
+
+        if ((uint64_t)crop.Top + crop.Bottom < sourceHeight)
+        {
+            regionY = crop.Top;
+            regionHeight = sourceHeight - crop.Top - crop.Bottom;
+        }
+
+        if (regionWidth == 0 || regionHeight == 0 || targetWidth == 0 || targetHeight == 0)
+        {
+            ret.IsValid = false;
+            return ret;
+        }
+
+        ret.X = 0.f;
+        ret.Y = 0.f;
+        ret.Width = (float)targetWidth;
+        ret.Height = (float)targetHeight;
+
+        float scaleX = (float)targetWidth / (float)regionWidth;
+        float scaleY = (float)targetHeight / (float)regionHeight;
+
+        switch (scaleMode)
+        {
+            case SCALE_MODE_FIT:
+            {
+                // Letterbox the region within the target
+                float scale = std::min(scaleX, scaleY);
+                ret.Width = (float)regionWidth * scale;
+                ret.Height = (float)regionHeight * scale;
+                ret.X = ((float)targetWidth - ret.Width) * 0.5f;
+                ret.Y = ((float)targetHeight - ret.Height) * 0.5f;
+                break;
+            }
+            case SCALE_MODE_FILL:
+            {
+                // Cover the target and trim whatever overflows evenly from both sides
+                float scale = std::max(scaleX, scaleY);
+                uint32_t visibleWidth = std::min(regionWidth, (uint32_t)((float)targetWidth / scale + 0.5f));
+                uint32_t visibleHeight = std::min(regionHeight, (uint32_t)((float)targetHeight / scale + 0.5f));
+                regionX += (regionWidth - visibleWidth) / 2;
+                regionY += (regionHeight - visibleHeight) / 2;
+                regionWidth = std::max(visibleWidth, 1u);
+                regionHeight = std::max(visibleHeight, 1u);
+                break;
+            }
+            case SCALE_MODE_STRETCH:
+            default:
+                break;
+        }
+
+        ret.SourceX = regionX;
+        ret.SourceY = regionY;
+        ret.SourceWidth = regionWidth;
+        ret.SourceHeight = regionHeight;
+        ret.IsCropped = regionX != 0 || regionY != 0 || regionWidth != sourceWidth || regionHeight != sourceHeight;
+        ret.IsValid = true;
+        ChooseScalePath(ret);
+        return ret;
+    }
+}
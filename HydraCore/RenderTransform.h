@@ -0,0 +1,62 @@
+#pragma once
+#include <stdint.h>
+
+namespace HydraCore
+{
+    enum ScaleMode
+    {
+        SCALE_MODE_STRETCH,
+        SCALE_MODE_FIT,
+        SCALE_MODE_FILL,
+    };
+
+    // Identifies the cheapest way to draw a source with a given transform
+    enum ScalePath
+    {
+        // The source region is drawn 1:1
+        SCALE_PATH_IDENTITY,
+        // The source region is an exact integer multiple of the destination size
+        SCALE_PATH_INTEGER_DOWNSCALE,
+        // The destination size is an exact integer multiple of the source region
+        SCALE_PATH_INTEGER_UPSCALE,
+        // Anything else, needs a proper resampling filter
+        SCALE_PATH_FILTERED,
+        SCALE_PATH_COUNT,
+    };
+
+    struct Margins
+    {
+        uint32_t Left;
+        uint32_t Top;
+        uint32_t Right;
+        uint32_t Bottom;
+    };
+
+    // Describes how to draw a region of a source into a target area
+    struct RenderTransform
+    {
+        // The destination rectangle within the target area
+        float X;
+        float Y;
+        float Width;
+        float Height;
+
+        // The region of the source to draw, in source pixels
+        uint32_t SourceX;
+        uint32_t SourceY;
+        uint32_t SourceWidth;
+        uint32_t SourceHeight;
+
+        ScalePath Path;
+        // The integer scale factor for the integer scale paths, 1 otherwise
+        uint32_t ScaleFactor;
+
+        // True if the source region is not the entire source
+        bool IsCropped;
+        // False if there is nothing to draw (IE: the source has no size yet)
+        bool IsValid;
+    };
+
+    const char* GetScalePathName(ScalePath path);
+    RenderTransform ComputeRenderTransform(uint32_t sourceWidth, uint32_t sourceHeight, const Margins& crop, uint32_t targetWidth, uint32_t targetHeight, ScaleMode scaleMode);
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <stddef.h>
+#include <string>
+
+namespace HydraCore
+{
+    // A named block of memory which other processes belonging to the same user can map
+    // Implemented by SharedMemoryWin32.cpp (a file mapping in the session's Local\ namespace) or SharedMemoryPosix.cpp (a POSIX shared memory object.)
+    class SharedMemory
+    {
+    public:
+        virtual ~SharedMemory()
+        {
+        }
+
+        virtual void* GetAddress() = 0;
+        virtual size_t GetSize() = 0;
+
+        // Creates the block, replacing an existing one with the same name (IE: one left behind by a crash), new blocks are zero-filled
+        // The caller has to make sure no other live process owns the name, TrackerFeed does this by binding its socket first.
+        // The name goes away once the creator is destroyed (on Windows, once every process has closed it.) Throws if the block can't be created.
+        static SharedMemory* Create(const std::string& name, size_t size);
+
+        // Maps a block created by another process, throws if it doesn't exist or is smaller than the given size
+        static SharedMemory* Open(const std::string& name, size_t size, bool readOnly);
+    };
+}
@@ -0,0 +1,107 @@
+#include "SharedMemory.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace HydraCore
+{
+    class PosixSharedMemory : public SharedMemory
+    {
+    private:
+        std::string objectName;
+        void* address;
+        size_t size;
+        bool owner;
+
+        static std::runtime_error MakeException(const char* operation, const std::string& objectName)
+        {
+            return std::runtime_error(std::string(operation) + " of shared memory '" + objectName + "' failed: " + strerror(errno));
+        }
+    public:
+        PosixSharedMemory(const std::string& name, size_t size, bool create, bool readOnly)
+        {
+            // Shared memory objects live in a single namespace (/dev/shm), so the user is part of the name to keep users from stepping on each other
+            objectName = "/" + name + "-" + std::to_string(getuid());
+            this->size = size;
+            owner = create;
+
+            // O_EXCL guarantees the object we unlink in the destructor is the one we created rather than another process's
+            int fileDescriptor = shm_open(objectName.c_str(), create ? O_RDWR | O_CREAT | O_EXCL : (readOnly ? O_RDONLY : O_RDWR), S_IRUSR | S_IWUSR);
+            if (fileDescriptor < 0 && create && errno == EEXIST)
+            {
+                // Left behind by a crash, replacing it rather than reusing it means the new block starts out zero-filled like any other
+                shm_unlink(objectName.c_str());
+                fileDescriptor = shm_open(objectName.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+            }
+
+            if (fileDescriptor < 0)
+            {
+                throw MakeException("Opening", objectName);
+            }
+
+            struct stat status;
+            if (create ? ftruncate(fileDescriptor, (off_t)size) != 0 : (fstat(fileDescriptor, &status) != 0 || (size_t)status.st_size < size))
+            {
+                std::runtime_error exception = MakeException(create ? "Resizing" : "Checking the size", objectName);
+                close(fileDescriptor);
+                if (create)
+                {
+                    shm_unlink(objectName.c_str());
+                }
+
+                throw exception;
+            }
+
+            // The mapping keeps the object alive, so the descriptor isn't needed past this point
+            address = mmap(nullptr, size, readOnly ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+            close(fileDescriptor);
+
+            if (address == MAP_FAILED)
+            {
+                std::runtime_error exception = MakeException("Mapping", objectName);
+                if (create)
+                {
+                    shm_unlink(objectName.c_str());
+                }
+
+                throw exception;
+            }
+        }
+
+        ~PosixSharedMemory()
+        {
+            munmap(address, size);
+
+            // Readers which already have the block mapped keep it until they unmap it
+            if (owner)
+            {
+                shm_unlink(objectName.c_str());
+            }
+        }
+
+        void* GetAddress() override
+        {
+            return address;
+        }
+
+        size_t GetSize() override
+        {
+            return size;
+        }
+    };
+
+    SharedMemory* SharedMemory::Create(const std::string& name, size_t size)
+    {
+        return new PosixSharedMemory(name, size, true, false);
+    }
+
+    SharedMemory* SharedMemory::Open(const std::string& name, size_t size, bool readOnly)
+    {
+        return new PosixSharedMemory(name, size, false, readOnly);
+    }
+}
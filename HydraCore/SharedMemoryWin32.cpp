@@ -0,0 +1,78 @@
+#include "SharedMemory.h"
+#include "Win32Exception.h"
+
+namespace HydraCore
+{
+    class Win32SharedMemory : public SharedMemory
+    {
+    private:
+        HANDLE mapping;
+        void* address;
+        size_t size;
+    public:
+        Win32SharedMemory(const std::string& name, size_t size, bool create, bool readOnly)
+        {
+            // The Local\ namespace is per-session, which keeps other users (and services) from seeing the block
+            std::string mappingName = "Local\\" + name;
+            this->size = size;
+
+            if (create)
+            {
+                mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, (DWORD)((uint64_t)size >> 32), (DWORD)size, mappingName.c_str());
+            }
+            else
+            {
+                mapping = OpenFileMappingA(readOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS, FALSE, mappingName.c_str());
+            }
+
+            if (mapping == NULL)
+            {
+                throw Win32Exception();
+            }
+
+            address = MapViewOfFile(mapping, readOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS, 0, 0, 0);
+            if (address == NULL)
+            {
+                DWORD errorCode = GetLastError();
+                CloseHandle(mapping);
+                throw Win32Exception(errorCode);
+            }
+
+            // Views are rounded up to whole pages, so this only catches blocks created by an older (smaller) layout
+            MEMORY_BASIC_INFORMATION memoryInfo;
+            if (VirtualQuery(address, &memoryInfo, sizeof(memoryInfo)) == 0 || memoryInfo.RegionSize < size)
+            {
+                UnmapViewOfFile(address);
+                CloseHandle(mapping);
+                throw std::runtime_error("Shared memory '" + mappingName + "' is smaller than expected.");
+            }
+        }
+
+        ~Win32SharedMemory()
+        {
+            // File mappings are reference counted, so the name goes away on its own once every process has closed it
+            UnmapViewOfFile(address);
+            CloseHandle(mapping);
+        }
+
+        void* GetAddress() override
+        {
+            return address;
+        }
+
+        size_t GetSize() override
+        {
+            return size;
+        }
+    };
+
+    SharedMemory* SharedMemory::Create(const std::string& name, size_t size)
+    {
+        return new Win32SharedMemory(name, size, true, false);
+    }
+
+    SharedMemory* SharedMemory::Open(const std::string& name, size_t size, bool readOnly)
+    {
+        return new Win32SharedMemory(name, size, false, readOnly);
+    }
+}
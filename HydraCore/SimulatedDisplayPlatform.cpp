@@ -0,0 +1,418 @@
+#include "Clock.h"
+#include "SimulatedDisplayPlatform.h"
+
+namespace HydraCore
+{
+    SimulatedDisplayPlatform::SimulatedDisplayPlatform()
+    {
+        time = 0;
+        nextMonitorHandle = 1;
+        nextWindow = 1;
+        focusedWindow = 0;
+        draggedWindow = 0;
+        activeMonitor = nullptr;
+        cursorX = 0;
+        cursorY = 0;
+        cursorShape = {};
+    }
+
+    void SimulatedDisplayPlatform::RebuildMonitorList()
+    {
+        monitorList.clear();
+        monitorList.reserve(monitors.size());
+
+        for (SimulatedMonitor& monitor : monitors)
+        {
+            monitorList.push_back(Monitor((uint32_t)monitorList.size(), monitor.Handle, monitor.Bounds, monitor.Name, monitor.Name, monitor.IsPrimary));
+        }
+    }
+
+    SimulatedDisplayPlatform::WindowState* SimulatedDisplayPlatform::GetWindowState(SimulatedWindow window)
+    {
+        for (WindowState& state : windows)
+        {
+            if (state.Window == window)
+            {
+                return &state;
+            }
+        }
+
+        return nullptr;
+    }
+
+    MonitorHandle SimulatedDisplayPlatform::GetWindowMonitor(const WindowState& state)
+    {
+        int32_t centerX = state.Bounds.Left + (int32_t)(state.Bounds.Width / 2);
+        int32_t centerY = state.Bounds.Top + (int32_t)(state.Bounds.Height / 2);
+        Monitor* monitor = Monitor::GetMonitorNearestPoint(monitorList, centerX, centerY);
+        return monitor == nullptr ? nullptr : monitor->GetHandle();
+    }
+
+    MonitorHandle SimulatedDisplayPlatform::UpdateActiveMonitor()
+    {
+        WindowState* focusedState = GetWindowState(focusedWindow);
+
+        if (focusedState != nullptr)
+        {
+            activeMonitor = GetWindowMonitor(*focusedState);
+            return activeMonitor;
+        }
+
+        // Without a focused window the active monitor stays put unless it was unplugged
+        for (Monitor& monitor : monitorList)
+        {
+            if (monitor.GetHandle() == activeMonitor)
+            {
+                return activeMonitor;
+            }
+        }
+
+        activeMonitor = monitorList.size() == 0 ? nullptr : Monitor::GetPrimaryMonitor(monitorList).GetHandle();
+        return activeMonitor;
+    }
+
+    void SimulatedDisplayPlatform::DispatchTopologyChanged(WindowId window, MonitorHandle newMonitor, uint64_t timestamp)
+    {
+        topologyChangedEvent.Dispatch(timestamp);
+        activeMonitorChangedEvent.Dispatch(window, newMonitor, timestamp);
+    }
+
+    uint64_t SimulatedDisplayPlatform::GetTimestamp()
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return time;
+    }
+
+    std::vector<Monitor> SimulatedDisplayPlatform::GetAllMonitors()
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return monitorList;
+    }
+
+    MonitorHandle SimulatedDisplayPlatform::GetActiveMonitor()
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return activeMonitor;
+    }
+
+    bool SimulatedDisplayPlatform::GetCursorPosition(int32_t& x, int32_t& y)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        x = cursorX;
+        y = cursorY;
+        return true;
+    }
+
+    bool SimulatedDisplayPlatform::GetCursorState(CursorState& state)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        state.IsVisible = !cursorShape.Pixels.empty();
+        state.X = cursorX;
+        state.Y = cursorY;
+        state.ShapeId = cursorShape.Id;
+        return true;
+    }
+
+    bool SimulatedDisplayPlatform::GetCursorShape(CursorShape& shape)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (cursorShape.Pixels.empty())
+        {
+            return false;
+        }
+
+        shape = cursorShape;
+        return true;
+    }
+
+    bool SimulatedDisplayPlatform::FindMonitor(int32_t x, int32_t y, MonitorHandle& monitor, Rectangle& rectangle)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+
+        for (SimulatedMonitor& candidate : monitors)
+        {
+            if (x >= candidate.Bounds.Left && y >= candidate.Bounds.Top
+                && (int64_t)x < (int64_t)candidate.Bounds.Left + candidate.Bounds.Width
+                && (int64_t)y < (int64_t)candidate.Bounds.Top + candidate.Bounds.Height)
+            {
+                monitor = candidate.Handle;
+                rectangle = candidate.Bounds;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    WindowInfo SimulatedDisplayPlatform::GetWindowInfo(WindowId window)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+
+        WindowState* state = GetWindowState((SimulatedWindow)window);
+        return state == nullptr ? WindowInfo() : state->Info;
+    }
+
+    void SimulatedDisplayPlatform::SetTime(uint64_t time)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        this->time = time;
+    }
+
+    void SimulatedDisplayPlatform::AdvanceTime(uint64_t nanoseconds)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        time += nanoseconds;
+    }
+
+    MonitorHandle SimulatedDisplayPlatform::ConnectMonitor(const Rectangle& rectangle, const std::string& name, bool isPrimary)
+    {
+        MonitorHandle handle;
+        MonitorHandle newActiveMonitor;
+        SimulatedWindow window;
+        uint64_t timestamp;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+
+            handle = reinterpret_cast<MonitorHandle>(nextMonitorHandle);
+            nextMonitorHandle++;
+
+            // There's only ever one primary monitor
+            if (isPrimary)
+            {
+                for (SimulatedMonitor& monitor : monitors)
+                {
+                    monitor.IsPrimary = false;
+                }
+            }
+
+            monitors.push_back({ handle, rectangle, name, isPrimary });
+            RebuildMonitorList();
+            newActiveMonitor = UpdateActiveMonitor();
+            window = focusedWindow;
+            timestamp = time;
+        }
+
+        DispatchTopologyChanged(window, newActiveMonitor, timestamp);
+        return handle;
+    }
+
+    void SimulatedDisplayPlatform::DisconnectMonitor(MonitorHandle monitor)
+    {
+        MonitorHandle newActiveMonitor;
+        SimulatedWindow window;
+        uint64_t timestamp;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+
+            for (auto it = monitors.begin(); it != monitors.end(); it++)
+            {
+                if (it->Handle == monitor)
+                {
+                    monitors.erase(it);
+                    break;
+                }
+            }
+
+            RebuildMonitorList();
+            newActiveMonitor = UpdateActiveMonitor();
+            window = focusedWindow;
+            timestamp = time;
+        }
+
+        DispatchTopologyChanged(window, newActiveMonitor, timestamp);
+    }
+
+    void SimulatedDisplayPlatform::MoveMonitor(MonitorHandle monitor, const Rectangle& rectangle)
+    {
+        MonitorHandle newActiveMonitor;
+        SimulatedWindow window;
+        uint64_t timestamp;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+
+            for (SimulatedMonitor& candidate : monitors)
+            {
+                if (candidate.Handle == monitor)
+                {
+                    candidate.Bounds = rectangle;
+                }
+            }
+
+            RebuildMonitorList();
+            newActiveMonitor = UpdateActiveMonitor();
+            window = focusedWindow;
+            timestamp = time;
+        }
+
+        DispatchTopologyChanged(window, newActiveMonitor, timestamp);
+    }
+
+    SimulatedWindow SimulatedDisplayPlatform::AddWindow(const Rectangle& rectangle, const std::string& executableName, const std::string& windowClass)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+
+        SimulatedWindow window = nextWindow;
+        nextWindow++;
+        windows.push_back({ window, rectangle, { executableName, windowClass } });
+        return window;
+    }
+
+    void SimulatedDisplayPlatform::RemoveWindow(SimulatedWindow window)
+    {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+
+            for (auto it = windows.begin(); it != windows.end(); it++)
+            {
+                if (it->Window == window)
+                {
+                    windows.erase(it);
+                    break;
+                }
+            }
+
+            // Like the native platforms, losing focus to nothing doesn't change the active monitor
+            if (focusedWindow == window)
+            {
+                focusedWindow = 0;
+            }
+
+            if (draggedWindow == window)
+            {
+                draggedWindow = 0;
+            }
+        }
+
+        windowDestroyedEvent.Dispatch(window);
+    }
+
+    void SimulatedDisplayPlatform::MoveWindow(SimulatedWindow window, const Rectangle& rectangle)
+    {
+        MonitorHandle newActiveMonitor;
+        uint64_t timestamp;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+
+            WindowState* state = GetWindowState(window);
+            if (state == nullptr)
+            {
+                return;
+            }
+
+            state->Bounds = rectangle;
+
+            // Only the focused window moving can change the active monitor
+            if (window != focusedWindow)
+            {
+                return;
+            }
+
+            // Dragged windows are only followed as they move when live dragging is on, otherwise they're followed once they're dropped
+            if (window == draggedWindow)
+            {
+                if (!dragThrottle.IsEnabled())
+                {
+                    return;
+                }
+
+                // The cost is measured on the real clock since that's what the event thread would be spending
+                uint64_t startTime = HydraCore::GetTimestamp();
+                bool sampled = dragThrottle.ShouldSample(time);
+                if (sampled)
+                {
+                    newActiveMonitor = UpdateActiveMonitor();
+                    sampled = dragThrottle.MonitorChanged(newActiveMonitor);
+                }
+
+                dragThrottle.RecordEvent(HydraCore::GetTimestamp() - startTime);
+                if (!sampled)
+                {
+                    return;
+                }
+            }
+            else
+            {
+                newActiveMonitor = UpdateActiveMonitor();
+            }
+
+            timestamp = time;
+        }
+
+        activeMonitorChangedEvent.Dispatch(window, newActiveMonitor, timestamp);
+    }
+
+    void SimulatedDisplayPlatform::BeginWindowDrag(SimulatedWindow window)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+
+        WindowState* state = GetWindowState(window);
+        if (state == nullptr)
+        {
+            return;
+        }
+
+        draggedWindow = window;
+
+        // Like on Windows, only a focused window is followed while it's dragged
+        if (dragThrottle.IsEnabled() && window == focusedWindow)
+        {
+            dragThrottle.BeginDrag(GetWindowMonitor(*state), time);
+        }
+    }
+
+    void SimulatedDisplayPlatform::EndWindowDrag()
+    {
+        MonitorHandle newActiveMonitor;
+        SimulatedWindow window;
+        uint64_t timestamp;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+
+            window = draggedWindow;
+            draggedWindow = 0;
+
+            if (window == 0 || window != focusedWindow)
+            {
+                return;
+            }
+
+            newActiveMonitor = UpdateActiveMonitor();
+            timestamp = time;
+        }
+
+        activeMonitorChangedEvent.Dispatch(window, newActiveMonitor, timestamp);
+    }
+
+    void SimulatedDisplayPlatform::FocusWindow(SimulatedWindow window)
+    {
+        MonitorHandle newActiveMonitor;
+        uint64_t timestamp;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+
+            if (GetWindowState(window) == nullptr)
+            {
+                return;
+            }
+
+            focusedWindow = window;
+            newActiveMonitor = UpdateActiveMonitor();
+            timestamp = time;
+        }
+
+        activeMonitorChangedEvent.Dispatch(window, newActiveMonitor, timestamp);
+    }
+
+    void SimulatedDisplayPlatform::SetCursorPosition(int32_t x, int32_t y)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        cursorX = x;
+        cursorY = y;
+    }
+
+    void SimulatedDisplayPlatform::SetCursorShape(const CursorShape& shape)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        cursorShape = shape;
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "DisplayPlatform.h"
+
+namespace HydraCore
+{
+    typedef uint32_t SimulatedWindow;
+
+    // An in-memory display platform which is scripted by the caller instead of observing a real desktop.
+    // Time only moves when the script moves it, and events are dispatched synchronously on the thread making the change, so runs are deterministic.
+    // The script should only be driven from one thread, although the query methods may be called from any thread (IE: by a CursorMonitorTracker's sampling thread).
+    class SimulatedDisplayPlatform : public DisplayPlatform
+    {
+    private:
+        struct SimulatedMonitor
+        {
+            MonitorHandle Handle;
+            Rectangle Bounds;
+            std::string Name;
+            bool IsPrimary;
+        };
+
+        struct WindowState
+        {
+            SimulatedWindow Window;
+            Rectangle Bounds;
+            WindowInfo Info;
+        };
+
+        std::mutex stateMutex;
+        uint64_t time;
+        std::vector<SimulatedMonitor> monitors;
+        // Monitor objects are comparatively expensive to build, so they're only rebuilt when the topology changes
+        std::vector<Monitor> monitorList;
+        std::vector<WindowState> windows;
+        uintptr_t nextMonitorHandle;
+        SimulatedWindow nextWindow;
+        SimulatedWindow focusedWindow;
+        SimulatedWindow draggedWindow;
+        MonitorHandle activeMonitor;
+        int32_t cursorX;
+        int32_t cursorY;
+        CursorShape cursorShape;
+
+        // These expect stateMutex to be held
+        void RebuildMonitorList();
+        WindowState* GetWindowState(SimulatedWindow window);
+        MonitorHandle GetWindowMonitor(const WindowState& state);
+        MonitorHandle UpdateActiveMonitor();
+
+        // Events are dispatched without holding stateMutex so handlers are free to query the platform
+        void DispatchTopologyChanged(WindowId window, MonitorHandle newMonitor, uint64_t timestamp);
+    public:
+        SimulatedDisplayPlatform();
+
+        uint64_t GetTimestamp() override;
+        std::vector<Monitor> GetAllMonitors() override;
+        MonitorHandle GetActiveMonitor() override;
+        bool GetCursorPosition(int32_t& x, int32_t& y) override;
+        bool GetCursorState(CursorState& state) override;
+        bool GetCursorShape(CursorShape& shape) override;
+        bool FindMonitor(int32_t x, int32_t y, MonitorHandle& monitor, Rectangle& rectangle) override;
+        WindowInfo GetWindowInfo(WindowId window) override;
+
+        // Events are always delivered as the script makes changes
+        void StartEvents() override
+        {
+        }
+
+        // Virtual clock
+        void SetTime(uint64_t time);
+        void AdvanceTime(uint64_t nanoseconds);
+
+        // Hot-plugging, each of these raises the topology changed event followed by the active monitor changed event
+        // Monitors are numbered in the order they were added, and their handles are never reused (like HMONITOR after a display change.)
+        MonitorHandle ConnectMonitor(const Rectangle& rectangle, const std::string& name, bool isPrimary = false);
+        void DisconnectMonitor(MonitorHandle monitor);
+        void MoveMonitor(MonitorHandle monitor, const Rectangle& rectangle);
+
+        // Windows belong to the monitor nearest to their center, moving or focusing a window raises the active monitor changed event
+        // Simulated windows are their own WindowId
+        SimulatedWindow AddWindow(const Rectangle& rectangle, const std::string& executableName = "", const std::string& windowClass = "");
+        void RemoveWindow(SimulatedWindow window);
+        void MoveWindow(SimulatedWindow window, const Rectangle& rectangle);
+        void FocusWindow(SimulatedWindow window);
+
+        // Dragging works like it does on Windows: the window is only followed once it's dropped, unless live dragging is enabled (see SetLiveDragInterval)
+        // in which case MoveWindow samples the focused window as it's dragged, based on the virtual clock.
+        void BeginWindowDrag(SimulatedWindow window);
+        void EndWindowDrag();
+
+        void SetCursorPosition(int32_t x, int32_t y);
+        // The shape's ID is what GetCursorState reports, the cursor has no shape (and is hidden) until one is set
+        void SetCursorShape(const CursorShape& shape);
+    };
+}
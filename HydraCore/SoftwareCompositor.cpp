@@ -0,0 +1,239 @@
+#include "SoftwareCompositor.h"
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+namespace HydraCore
+{
+    // Coverage below this is rounding error in the span's edges rather than a real overlap
+    static const double MinimumCoverage = 1e-6;
+
+    static void BuildSpans(uint32_t sourceSize, uint32_t destinationSize, std::vector<AreaSpan>& spans, std::vector<float>& weights)
+    {
+        spans.resize(destinationSize);
+        double scale = (double)sourceSize / (double)destinationSize;
+
+        for (uint32_t i = 0; i < destinationSize; i++)
+        {
+            double start = i * scale;
+            double end = std::min((i + 1) * scale, (double)sourceSize);
+            uint32_t first = (uint32_t)floor(start);
+            uint32_t last = std::min((uint32_t)ceil(end), sourceSize);
+
+            while (first + 1 < last && first + 1 - start < MinimumCoverage)
+            {
+                first++;
+            }
+
+            while (last - 1 > first && end - (last - 1) < MinimumCoverage)
+            {
+                last--;
+            }
+
+            AreaSpan& span = spans[i];
+            span.First = first;
+            span.Count = last - first;
+            span.WeightOffset = (uint32_t)weights.size();
+
+            double total = 0.0;
+            for (uint32_t source = first; source < last; source++)
+            {
+                total += std::min(end, source + 1.0) - std::max(start, (double)source);
+            }
+
+            for (uint32_t source = first; source < last; source++)
+            {
+                weights.push_back((float)((std::min(end, source + 1.0) - std::max(start, (double)source)) / total));
+            }
+        }
+    }
+
+    AreaScalePlan::AreaScalePlan()
+    {
+        sourceWidth = 0;
+        sourceHeight = 0;
+        destinationWidth = 0;
+        destinationHeight = 0;
+    }
+
+    void AreaScalePlan::Update(uint32_t sourceWidth, uint32_t sourceHeight, uint32_t destinationWidth, uint32_t destinationHeight)
+    {
+        if (sourceWidth == this->sourceWidth && sourceHeight == this->sourceHeight && destinationWidth == this->destinationWidth && destinationHeight == this->destinationHeight)
+        {
+            return;
+        }
+
+        this->sourceWidth = sourceWidth;
+        this->sourceHeight = sourceHeight;
+        this->destinationWidth = destinationWidth;
+        this->destinationHeight = destinationHeight;
+
+        columns.clear();
+        rows.clear();
+        weights.clear();
+
+        if (sourceWidth == 0 || sourceHeight == 0)
+        {
+            return;
+        }
+
+        BuildSpans(sourceWidth, destinationWidth, columns, weights);
+        BuildSpans(sourceHeight, destinationHeight, rows, weights);
+    }
+
+    void ScaleAreaRows(const CompositorKernels& kernels, const AreaScalePlan& plan, const uint8_t* source, uint32_t sourceStride, uint8_t* destination, uint32_t destinationStride, uint32_t firstRow, uint32_t endRow, uint32_t firstColumn, uint32_t endColumn, float* accumulator)
+    {
+        if (firstRow >= endRow || firstColumn >= endColumn || plan.GetSourceWidth() == 0 || plan.GetSourceHeight() == 0)
+        {
+            return;
+        }
+
+        const AreaSpan* columns = plan.GetColumns();
+        const AreaSpan* rows = plan.GetRows();
+        const float* weights = plan.GetWeights();
+
+        // Only the source columns the destination columns cover are accumulated, which matters for tiles which are mostly off screen
+        uint32_t firstSourceColumn = columns[firstColumn].First;
+        uint32_t endSourceColumn = columns[endColumn - 1].First + columns[endColumn - 1].Count;
+        uint32_t accumulatorCount = (endSourceColumn - firstSourceColumn) * 4;
+        source += (size_t)firstSourceColumn * 4;
+
+        // Each destination row is the weighted sum of its source rows, which is then reduced along the row
+        for (uint32_t y = firstRow; y < endRow; y++, destination += destinationStride)
+        {
+            const AreaSpan& row = rows[y];
+            for (uint32_t i = 0; i < row.Count; i++)
+            {
+                kernels.AccumulateRow(accumulator, source + (size_t)(row.First + i) * sourceStride, accumulatorCount, weights[row.WeightOffset + i], i > 0);
+            }
+
+            kernels.ReduceColumns(destination, accumulator, columns + firstColumn, weights, endColumn - firstColumn, firstSourceColumn);
+        }
+    }
+
+    SoftwareCompositor::SoftwareCompositor(SimdLevel simdLevel, uint32_t threadCount) : threadPool(threadCount)
+    {
+        this->simdLevel = std::min(simdLevel, GetSupportedSimdLevel());
+        kernels = &GetCompositorKernels(this->simdLevel);
+        accumulators.resize(threadPool.GetWorkerCount());
+    }
+
+    void SoftwareCompositor::CompositeBand(const SoftwareImage& target, uint32_t firstRow, uint32_t endRow, uint32_t worker, const float* outlineColor)
+    {
+        for (uint32_t y = firstRow; y < endRow; y++)
+        {
+            memset(target.Pixels + (size_t)y * target.Stride, 0, (size_t)target.Width * 4);
+        }
+
+        // Tiles don't overlap so they're copied rather than blended, like the GPU path they're clipped to the target
+        for (const PlacedTile& tile : placedTiles)
+        {
+            const AreaScalePlan& plan = plans[tile.Child];
+            int64_t tileFirstRow = std::max((int64_t)firstRow, tile.Y);
+            int64_t tileEndRow = std::min((int64_t)endRow, tile.Y + plan.GetDestinationHeight());
+            int64_t tileFirstColumn = std::max((int64_t)0, tile.X);
+            int64_t tileEndColumn = std::min((int64_t)target.Width, tile.X + plan.GetDestinationWidth());
+
+            if (tileFirstRow >= tileEndRow || tileFirstColumn >= tileEndColumn)
+            {
+                continue;
+            }
+
+            uint8_t* destination = target.Pixels + (size_t)tileFirstRow * target.Stride + (size_t)tileFirstColumn * 4;
+            uint32_t planFirstRow = (uint32_t)(tileFirstRow - tile.Y);
+            uint32_t planFirstColumn = (uint32_t)(tileFirstColumn - tile.X);
+            ScaleAreaRows(*kernels, plan, tile.Source, tile.SourceStride, destination, target.Stride, planFirstRow, (uint32_t)(tileEndRow - tile.Y), planFirstColumn, (uint32_t)(tileEndColumn - tile.X), accumulators[worker].data());
+        }
+
+        for (const OutlineBar& bar : outlineBars)
+        {
+            int64_t barFirstRow = std::max((int64_t)firstRow, bar.Y);
+            int64_t barEndRow = std::min((int64_t)endRow, bar.Y + bar.Height);
+            int64_t barFirstColumn = std::max((int64_t)0, bar.X);
+            int64_t barEndColumn = std::min((int64_t)target.Width, bar.X + bar.Width);
+
+            for (int64_t y = barFirstRow; y < barEndRow && barFirstColumn < barEndColumn; y++)
+            {
+                kernels->BlendSolid(target.Pixels + (size_t)y * target.Stride + (size_t)barFirstColumn * 4, (uint32_t)(barEndColumn - barFirstColumn), outlineColor);
+            }
+        }
+    }
+
+    void SoftwareCompositor::Composite(const SoftwareImage& target, const CompositeLayout& layout, const std::vector<SoftwareImage>& children, const std::vector<RenderTransform>& transforms, uint32_t outlineColor)
+    {
+        if (target.Width == 0 || target.Height == 0)
+        {
+            return;
+        }
+
+        // Everything which isn't per-row is worked out up front, so the workers only read it
+        plans.resize(children.size());
+        placedTiles.clear();
+        size_t accumulatorSize = 0;
+
+        for (const CompositeTile& tile : layout.GetTiles())
+        {
+            const SoftwareImage& child = children[tile.Child];
+            const RenderTransform& transform = transforms[tile.Child];
+            if (!transform.IsValid || child.Pixels == nullptr)
+            {
+                continue;
+            }
+
+            AreaScalePlan& plan = plans[tile.Child];
+            plan.Update(transform.SourceWidth, transform.SourceHeight, (uint32_t)lroundf(transform.Width), (uint32_t)lroundf(transform.Height));
+            accumulatorSize = std::max(accumulatorSize, (size_t)transform.SourceWidth * 4);
+
+            PlacedTile placedTile;
+            placedTile.Child = tile.Child;
+            placedTile.X = lroundf(tile.X + transform.X);
+            placedTile.Y = lroundf(tile.Y + transform.Y);
+            placedTile.Source = child.Pixels + (size_t)transform.SourceY * child.Stride + (size_t)transform.SourceX * 4;
+            placedTile.SourceStride = child.Stride;
+            placedTiles.push_back(placedTile);
+        }
+
+        for (std::vector<float>& accumulator : accumulators)
+        {
+            if (accumulator.size() < accumulatorSize)
+            {
+                accumulator.resize(accumulatorSize);
+            }
+        }
+
+        // The same four bars RenderOverviewMode draws, the sides overlap the top and bottom
+        outlineBars.clear();
+        if (layout.IsOutlineVisible())
+        {
+            const CompositeOutline& outline = layout.GetOutline();
+            int64_t x = lroundf(outline.X);
+            int64_t y = lroundf(outline.Y);
+            outlineBars.push_back({ x, y, outline.Width, outline.Thickness });
+            outlineBars.push_back({ x, y, outline.Thickness, outline.Height });
+            outlineBars.push_back({ x + outline.Width - outline.Thickness, y, outline.Thickness, outline.Height });
+            outlineBars.push_back({ x, y + outline.Height - outline.Thickness, outline.Width, outline.Thickness });
+        }
+
+        // Premultiplied and in BGRA order like the pixels
+        float alpha = (float)(outlineColor >> 24);
+        float premultipliedOutlineColor[4] =
+        {
+            (float)(outlineColor & 0xff) * alpha / 255.f,
+            (float)((outlineColor >> 8) & 0xff) * alpha / 255.f,
+            (float)((outlineColor >> 16) & 0xff) * alpha / 255.f,
+            alpha,
+        };
+
+        // A few bands per worker evens out workers which get scheduled late
+        uint32_t bandCount = std::min(target.Height, threadPool.GetWorkerCount() * 4);
+        uint32_t bandHeight = (target.Height + bandCount - 1) / bandCount;
+        bandCount = (target.Height + bandHeight - 1) / bandHeight;
+
+        threadPool.Run(bandCount, [&](uint32_t band, uint32_t worker)
+        {
+            uint32_t firstRow = band * bandHeight;
+            CompositeBand(target, firstRow, std::min(firstRow + bandHeight, target.Height), worker, premultipliedOutlineColor);
+        });
+    }
+}
@@ -0,0 +1,133 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+#include "CompositeLayout.h"
+#include "CompositorKernels.h"
+#include "RenderTransform.h"
+#include "ThreadPool.h"
+
+namespace HydraCore
+{
+    // A BGRA image in system memory, rows are Stride bytes apart
+    struct SoftwareImage
+    {
+        uint8_t* Pixels;
+        uint32_t Width;
+        uint32_t Height;
+        uint32_t Stride;
+    };
+
+    // The spans and weights for area-average scaling between two sizes, each destination pixel is the average of the source pixels it covers (weighted by how much of each it covers)
+    class AreaScalePlan
+    {
+    private:
+        uint32_t sourceWidth;
+        uint32_t sourceHeight;
+        uint32_t destinationWidth;
+        uint32_t destinationHeight;
+        std::vector<AreaSpan> columns;
+        std::vector<AreaSpan> rows;
+        // Shared by the columns and the rows
+        std::vector<float> weights;
+    public:
+        AreaScalePlan();
+
+        // Does nothing if the sizes haven't changed
+        void Update(uint32_t sourceWidth, uint32_t sourceHeight, uint32_t destinationWidth, uint32_t destinationHeight);
+
+        inline uint32_t GetSourceWidth() const
+        {
+            return sourceWidth;
+        }
+
+        inline uint32_t GetSourceHeight() const
+        {
+            return sourceHeight;
+        }
+
+        inline uint32_t GetDestinationWidth() const
+        {
+            return destinationWidth;
+        }
+
+        inline uint32_t GetDestinationHeight() const
+        {
+            return destinationHeight;
+        }
+
+        inline const AreaSpan* GetColumns() const
+        {
+            return columns.data();
+        }
+
+        inline const AreaSpan* GetRows() const
+        {
+            return rows.data();
+        }
+
+        inline const float* GetWeights() const
+        {
+            return weights.data();
+        }
+    };
+
+    // Scales part of the plan's destination: rows [firstRow, endRow) and columns [firstColumn, endColumn).
+    // source points at the top-left of the plan's source region, destination points at the destination pixel (firstColumn, firstRow).
+    // accumulator needs room for the plan's source width * 4 floats.
+    void ScaleAreaRows(const CompositorKernels& kernels, const AreaScalePlan& plan, const uint8_t* source, uint32_t sourceStride, uint8_t* destination, uint32_t destinationStride, uint32_t firstRow, uint32_t endRow, uint32_t firstColumn, uint32_t endColumn, float* accumulator);
+
+    // Composites a frame on the CPU: every tile of a CompositeLayout is area-average scaled from its child's frame and the overview outline is blended on top.
+    // This is the same image RenderComposite draws on the GPU, for hosts where the GPU (or the lack of one) is the bottleneck.
+    // The target is split into bands of rows which are spread over a thread pool, each band is cleared, scaled into and outlined by one worker.
+    class SoftwareCompositor
+    {
+    private:
+        // A tile's destination rectangle in the target, rounded to whole pixels
+        struct PlacedTile
+        {
+            uint32_t Child;
+            int64_t X;
+            int64_t Y;
+            const uint8_t* Source;
+            uint32_t SourceStride;
+        };
+
+        struct OutlineBar
+        {
+            int64_t X;
+            int64_t Y;
+            int64_t Width;
+            int64_t Height;
+        };
+
+        const CompositorKernels* kernels;
+        SimdLevel simdLevel;
+        ThreadPool threadPool;
+        // Indexed by child, so a child's weights are only recomputed when its size changes
+        std::vector<AreaScalePlan> plans;
+        // Indexed by worker
+        std::vector<std::vector<float>> accumulators;
+        std::vector<PlacedTile> placedTiles;
+        std::vector<OutlineBar> outlineBars;
+
+        void CompositeBand(const SoftwareImage& target, uint32_t firstRow, uint32_t endRow, uint32_t worker, const float* outlineColor);
+    public:
+        // The SIMD level is lowered to what the CPU supports, a thread count of 0 uses every core
+        explicit SoftwareCompositor(SimdLevel simdLevel = SIMD_LEVEL_AVX2, uint32_t threadCount = 0);
+
+        inline SimdLevel GetSimdLevel() const
+        {
+            return simdLevel;
+        }
+
+        inline uint32_t GetWorkerCount() const
+        {
+            return threadPool.GetWorkerCount();
+        }
+
+        // children and transforms are indexed by CompositeTile::Child, each transform places its child within a tile (see ComputeRenderTransform)
+        // The target is cleared to transparent first, outlineColor is 0xAARRGGBB and isn't premultiplied.
+        void Composite(const SoftwareImage& target, const CompositeLayout& layout, const std::vector<SoftwareImage>& children, const std::vector<RenderTransform>& transforms, uint32_t outlineColor);
+    };
+}
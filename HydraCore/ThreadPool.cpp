@@ -0,0 +1,110 @@
+#include "ThreadPool.h"
+
+namespace HydraCore
+{
+    ThreadPool::ThreadPool(uint32_t threadCount)
+    {
+        task = nullptr;
+        taskCount = 0;
+        nextTask = 0;
+        busyThreadCount = 0;
+        batch = 0;
+        isStopping = false;
+
+        if (threadCount == 0)
+        {
+            threadCount = std::thread::hardware_concurrency();
+        }
+
+        // The calling thread is one of the workers
+        for (uint32_t i = 1; i < threadCount; i++)
+        {
+            threads.emplace_back(&ThreadPool::ThreadEntry, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isStopping = true;
+        }
+
+        batchStarted.notify_all();
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::RunTasks(uint32_t worker)
+    {
+        for (uint32_t i = nextTask.fetch_add(1, std::memory_order_relaxed); i < taskCount; i = nextTask.fetch_add(1, std::memory_order_relaxed))
+        {
+            (*task)(i, worker);
+        }
+    }
+
+    void ThreadPool::ThreadEntry(uint32_t worker)
+    {
+        uint64_t finishedBatch = 0;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                batchStarted.wait(lock, [&]() { return isStopping || batch != finishedBatch; });
+
+                if (isStopping)
+                {
+                    return;
+                }
+
+                finishedBatch = batch;
+            }
+
+            RunTasks(worker);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busyThreadCount == 0)
+            {
+                batchFinished.notify_one();
+            }
+        }
+    }
+
+    void ThreadPool::Run(uint32_t taskCount, const Task& task)
+    {
+        if (taskCount == 0)
+        {
+            return;
+        }
+
+        // Waking the threads isn't worth it for a single task
+        if (threads.empty() || taskCount == 1)
+        {
+            for (uint32_t i = 0; i < taskCount; i++)
+            {
+                task(i, 0);
+            }
+
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            this->task = &task;
+            this->taskCount = taskCount;
+            nextTask.store(0, std::memory_order_relaxed);
+            busyThreadCount = (uint32_t)threads.size();
+            batch++;
+        }
+
+        batchStarted.notify_all();
+        RunTasks(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        batchFinished.wait(lock, [&]() { return busyThreadCount == 0; });
+        this->task = nullptr;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+namespace HydraCore
+{
+    // A fixed set of threads which split a batch of tasks between them, the thread which starts the batch works on it too.
+    // Tasks are handed out one at a time so uneven tasks still balance out.
+    class ThreadPool
+    {
+    public:
+        // Called with the task's index and the index of the worker running it (which is below GetWorkerCount, so per-worker scratch space can be indexed by it)
+        typedef std::function<void(uint32_t task, uint32_t worker)> Task;
+    private:
+        std::vector<std::thread> threads;
+        std::mutex mutex;
+        std::condition_variable batchStarted;
+        std::condition_variable batchFinished;
+        const Task* task;
+        uint32_t taskCount;
+        std::atomic<uint32_t> nextTask;
+        // Threads which haven't finished the current batch yet
+        uint32_t busyThreadCount;
+        // Incremented for every batch so that a thread can tell a new batch from the one it just finished
+        uint64_t batch;
+        bool isStopping;
+
+        void RunTasks(uint32_t worker);
+        void ThreadEntry(uint32_t worker);
+    public:
+        // A thread count of 0 uses one thread per core (counting the calling thread)
+        explicit ThreadPool(uint32_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        inline uint32_t GetWorkerCount() const
+        {
+            return (uint32_t)threads.size() + 1;
+        }
+
+        // Runs every task and returns once they have all finished, only one batch can run at a time
+        void Run(uint32_t taskCount, const Task& task);
+    };
+}
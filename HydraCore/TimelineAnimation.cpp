@@ -0,0 +1,213 @@
+#include "TimelineAnimation.h"
+
+#include <cmath>
+
+namespace HydraCore
+{
+    // Transitions which start out moving are never shorter than this so there's time to blend out of the old motion
+    static const double MinimumBlendDuration = 0.1;
+
+    TimelineAnimation::TimelineAnimation()
+        : Animation()
+    {
+        currentTime = 0;
+        velocity = 0.f;
+        JumpToPosition(0.f);
+    }
+
+    void TimelineAnimation::EvaluateTransition(const Transition& transition, uint64_t time, float& position, float& velocity)
+    {
+        if (time > transition.EndTime)
+        {
+            time = transition.EndTime;
+        }
+
+        double s = time <= transition.StartTime ? 0.0 : (double)(time - transition.StartTime) / 1'000'000'000.0 / transition.Duration;
+
+        if (s >= 1.0)
+        {
+            position = transition.TargetPosition;
+            velocity = 0.f;
+            return;
+        }
+
+        // Cubic Hermite basis with the end tangent fixed at zero
+        double s2 = s * s;
+        double s3 = s2 * s;
+        double p0 = transition.StartPosition;
+        double m0 = (double)transition.StartVelocity * transition.Duration;
+        double p1 = transition.TargetPosition;
+
+        position = (float)((2.0 * s3 - 3.0 * s2 + 1.0) * p0 + (s3 - 2.0 * s2 + s) * m0 + (-2.0 * s3 + 3.0 * s2) * p1);
+        velocity = (float)(((6.0 * s2 - 6.0 * s) * p0 + (3.0 * s2 - 4.0 * s + 1.0) * m0 + (-6.0 * s2 + 6.0 * s) * p1) / transition.Duration);
+    }
+
+    void TimelineAnimation::Sample(uint64_t time, float& position, float& velocity)
+    {
+        if (transitionCount == 0)
+        {
+            position = currentPosition;
+            velocity = 0.f;
+            return;
+        }
+
+        for (int i = 0; i < transitionCount; i++)
+        {
+            Transition& transition = GetTransition(i);
+            if (time < transition.EndTime || i == transitionCount - 1)
+            {
+                EvaluateTransition(transition, time, position, velocity);
+                return;
+            }
+        }
+    }
+
+    void TimelineAnimation::PushTransition(uint64_t startTime, float startPosition, float startVelocity, float targetPosition)
+    {
+        // Make room by merging the new transition into the last queued one, it restarts toward the new target from where it was going to start
+        // Only the first transition can have started (the rest start after it ends), so this never changes anything which was already shown.
+        if (transitionCount == MaxTransitions)
+        {
+            Transition& last = GetTransition(transitionCount - 1);
+            startTime = last.StartTime;
+            startPosition = last.StartPosition;
+            startVelocity = last.StartVelocity;
+            transitionCount--;
+        }
+
+        double distance = std::abs((double)targetPosition - (double)startPosition);
+
+        if (distance == 0.0 && startVelocity == 0.f)
+        {
+            return;
+        }
+
+        double duration = distance / velocity;
+        if (startVelocity != 0.f && duration < MinimumBlendDuration)
+        {
+            duration = MinimumBlendDuration;
+        }
+
+        Transition& transition = GetTransition(transitionCount);
+        transitionCount++;
+
+        transition.StartTime = startTime;
+        transition.EndTime = startTime + (uint64_t)(duration * 1'000'000'000.0);
+        transition.Duration = duration;
+        transition.StartPosition = startPosition;
+        transition.StartVelocity = startVelocity;
+        transition.TargetPosition = targetPosition;
+    }
+
+    void TimelineAnimation::JumpToPosition(float targetPosition)
+    {
+        firstTransition = 0;
+        transitionCount = 0;
+        isAnimating = false;
+        currentPosition = targetPosition;
+        currentVelocity = 0.f;
+        this->targetPosition = targetPosition;
+    }
+
+    void TimelineAnimation::Update(float deltaTime)
+    {
+        UpdateToTime(currentTime + (uint64_t)((double)deltaTime * 1'000'000'000.0));
+    }
+
+    void TimelineAnimation::UpdateToTime(uint64_t time)
+    {
+        // Time never goes backwards
+        if (time < currentTime)
+        {
+            return;
+        }
+
+        currentTime = time;
+        Sample(currentTime, currentPosition, currentVelocity);
+
+        // Retire finished transitions, this makes evaluation constant time no matter how long the timeline has been running
+        while (transitionCount > 0 && GetTransition(0).EndTime <= currentTime)
+        {
+            firstTransition = (firstTransition + 1) % MaxTransitions;
+            transitionCount--;
+        }
+
+        isAnimating = transitionCount > 0;
+    }
+
+    void TimelineAnimation::SetTargetPosition(float targetPosition)
+    {
+        SetTargetPosition(targetPosition, currentTime);
+    }
+
+    void TimelineAnimation::SetTargetPosition(float targetPosition, uint64_t startTime)
+    {
+        // A non-positive speed means transitions are instant
+        if (velocity <= 0.f)
+        {
+            JumpToPosition(targetPosition);
+            return;
+        }
+
+        // Transitions can't start in the past since we've already shown those frames
+        if (startTime < currentTime)
+        {
+            startTime = currentTime;
+        }
+
+        float startPosition;
+        float startVelocity;
+        Sample(startTime, startPosition, startVelocity);
+
+        // Drop anything which was going to happen after the retarget and cut the in-progress transition short
+        while (transitionCount > 0 && GetTransition(transitionCount - 1).StartTime >= startTime)
+        {
+            transitionCount--;
+        }
+
+        if (transitionCount > 0 && GetTransition(transitionCount - 1).EndTime > startTime)
+        {
+            GetTransition(transitionCount - 1).EndTime = startTime;
+        }
+
+        // If there's nothing left to animate the new target is reached instantly
+        if (transitionCount == 0 && startPosition == targetPosition && startVelocity == 0.f)
+        {
+            JumpToPosition(targetPosition);
+            return;
+        }
+
+        PushTransition(startTime, startPosition, startVelocity, targetPosition);
+        this->targetPosition = targetPosition;
+        isAnimating = transitionCount > 0;
+    }
+
+    bool TimelineAnimation::QueueTargetPosition(float targetPosition)
+    {
+        if (transitionCount == 0)
+        {
+            SetTargetPosition(targetPosition);
+            return true;
+        }
+
+        if (transitionCount == MaxTransitions)
+        {
+            return false;
+        }
+
+        // Queued transitions start where the last one ends
+        Transition& last = GetTransition(transitionCount - 1);
+        float startPosition;
+        float startVelocity;
+        EvaluateTransition(last, last.EndTime, startPosition, startVelocity);
+
+        PushTransition(last.EndTime, startPosition, startVelocity, targetPosition);
+        this->targetPosition = targetPosition;
+        return true;
+    }
+
+    void TimelineAnimation::SetVelocity(float velocity)
+    {
+        this->velocity = velocity;
+    }
+}
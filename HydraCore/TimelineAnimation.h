@@ -0,0 +1,64 @@
+#pragma once
+#include "Animation.h"
+
+#include <stdint.h>
+
+namespace HydraCore
+{
+    // An animation which is evaluated in closed form at absolute timestamps (in nanoseconds) instead of being stepped by frame deltas.
+    // Each transition is a cubic Hermite curve which starts with the position and velocity the animation had when it was started,
+    // so retargeting in the middle of a transition smoothly changes direction instead of snapping.
+    class TimelineAnimation : public Animation
+    {
+    public:
+        static const int MaxTransitions = 8;
+    private:
+        struct Transition
+        {
+            uint64_t StartTime;
+            // The time this transition hands off to the next one, this is before it finishes if it was retargeted
+            uint64_t EndTime;
+            double Duration;
+            float StartPosition;
+            float StartVelocity;
+            float TargetPosition;
+        };
+
+        Transition transitions[MaxTransitions];
+        int firstTransition;
+        int transitionCount;
+
+        uint64_t currentTime;
+        float currentVelocity;
+        float velocity;
+
+        inline Transition& GetTransition(int i)
+        {
+            return transitions[(firstTransition + i) % MaxTransitions];
+        }
+
+        static void EvaluateTransition(const Transition& transition, uint64_t time, float& position, float& velocity);
+        void Sample(uint64_t time, float& position, float& velocity);
+        void PushTransition(uint64_t startTime, float startPosition, float startVelocity, float targetPosition);
+    public:
+        TimelineAnimation();
+        virtual void JumpToPosition(float targetPosition);
+        virtual void Update(float deltaTime);
+        void UpdateToTime(uint64_t time);
+
+        virtual void SetTargetPosition(float targetPosition);
+        void SetTargetPosition(float targetPosition, uint64_t startTime);
+        bool QueueTargetPosition(float targetPosition);
+        void SetVelocity(float velocity);
+
+        inline float GetCurrentVelocity()
+        {
+            return currentVelocity;
+        }
+
+        inline uint64_t GetCurrentTime()
+        {
+            return currentTime;
+        }
+    };
+}
@@ -0,0 +1,205 @@
+#include "Clock.h"
+#include "TrackerFeed.h"
+
+#include <algorithm>
+#include <new>
+#include <stdio.h>
+
+namespace HydraCore
+{
+    void TrackerFeedBlock::Write(const TrackerFeedState& state)
+    {
+        // Marking the block as being written has to become visible before any of the payload does
+        uint64_t sequenceLock = SequenceLock.load(std::memory_order_relaxed);
+        SequenceLock.store(sequenceLock + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Monitor.store(state.Monitor, std::memory_order_relaxed);
+        MonitorIndex.store(state.MonitorIndex, std::memory_order_relaxed);
+        Position.store((uint64_t)(uint32_t)state.Bounds.Left << 32 | (uint32_t)state.Bounds.Top, std::memory_order_relaxed);
+        Size.store((uint64_t)state.Bounds.Width << 32 | state.Bounds.Height, std::memory_order_relaxed);
+        ChangeTimestamp.store(state.ChangeTimestamp, std::memory_order_relaxed);
+        PublishTimestamp.store(state.PublishTimestamp, std::memory_order_relaxed);
+
+        SequenceLock.store(sequenceLock + 2, std::memory_order_release);
+    }
+
+    bool TrackerFeedBlock::TryRead(TrackerFeedState& state) const
+    {
+        uint64_t sequenceLock = SequenceLock.load(std::memory_order_acquire);
+        if (sequenceLock % 2 != 0)
+        {
+            return false;
+        }
+
+        uint64_t position = Position.load(std::memory_order_relaxed);
+        uint64_t size = Size.load(std::memory_order_relaxed);
+        state.Sequence = sequenceLock / 2;
+        state.Monitor = Monitor.load(std::memory_order_relaxed);
+        state.MonitorIndex = (uint32_t)MonitorIndex.load(std::memory_order_relaxed);
+        state.Bounds.Left = (int32_t)(uint32_t)(position >> 32);
+        state.Bounds.Top = (int32_t)(uint32_t)position;
+        state.Bounds.Width = (uint32_t)(size >> 32);
+        state.Bounds.Height = (uint32_t)size;
+        state.ChangeTimestamp = ChangeTimestamp.load(std::memory_order_relaxed);
+        state.PublishTimestamp = PublishTimestamp.load(std::memory_order_relaxed);
+
+        // The payload loads have to complete before the sequence is checked again
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return SequenceLock.load(std::memory_order_relaxed) == sequenceLock;
+    }
+
+    TrackerFeedState TrackerFeedBlock::Read() const
+    {
+        TrackerFeedState ret;
+        while (!TryRead(ret))
+        {
+        }
+
+        return ret;
+    }
+
+    // Monitors are looked up by handle on every change, so they're only enumerated when the layout changes
+    static std::vector<Monitor> GetMonitorsLeftToRight(DisplayPlatform* platform)
+    {
+        std::vector<Monitor> ret = platform->GetAllMonitors();
+        std::sort(ret.begin(), ret.end(), [](Monitor& a, Monitor& b) { return a.GetRectangle().Left < b.GetRectangle().Left; });
+        return ret;
+    }
+
+    TrackerFeed::TrackerFeed(DisplayPlatform* platform, ActiveMonitorTracker* tracker, const std::string& name)
+    {
+        this->platform = platform;
+        this->tracker = tracker;
+        lastMonitor = nullptr;
+        lastChangeTimestamp = 0;
+
+        // Only one process can serve the socket, so binding it first keeps a second instance from touching the shared memory of the first
+        server = LocalSocketServer::Create(name);
+        try
+        {
+            sharedMemory = SharedMemory::Create(name, sizeof(TrackerFeedBlock));
+        }
+        catch (...)
+        {
+            delete server;
+            throw;
+        }
+
+        // The block may have been left behind by a previous run, so it's initialized from scratch before readers are told it's valid
+        block = new (sharedMemory->GetAddress()) TrackerFeedBlock();
+        block->Magic.store(0, std::memory_order_relaxed);
+        block->Version = TrackerFeedBlock::CurrentVersion;
+        block->SequenceLock.store(0, std::memory_order_relaxed);
+        block->Magic.store(TrackerFeedBlock::ExpectedMagic, std::memory_order_release);
+
+        monitors = GetMonitorsLeftToRight(platform);
+        Publish(tracker->GetActiveMonitorHandle(), platform->GetTimestamp());
+
+        trackerSubscription = tracker->SubscribeActiveMonitorChanged([this](MonitorHandle newMonitor, uint64_t timestamp)
+        {
+            Publish(newMonitor, timestamp);
+        });
+        topologySubscription = platform->SubscribeTopologyChanged([this](uint64_t timestamp)
+        {
+            TopologyChanged(timestamp);
+        });
+    }
+
+    TrackerFeed::~TrackerFeed()
+    {
+        tracker->UnsubscribeActiveMonitorChanged(trackerSubscription);
+        platform->UnsubscribeTopologyChanged(topologySubscription);
+
+        // Readers which still have the block mapped will see it become invalid rather than go stale silently
+        block->Magic.store(0, std::memory_order_release);
+
+        delete server;
+        delete sharedMemory;
+    }
+
+    void TrackerFeed::Publish(MonitorHandle monitor, uint64_t changeTimestamp)
+    {
+        TrackerFeedState state = {};
+        std::string message;
+        {
+            std::lock_guard<std::mutex> lock(publishMutex);
+
+            lastMonitor = monitor;
+            lastChangeTimestamp = changeTimestamp;
+
+            state.Monitor = (uint64_t)(uintptr_t)monitor;
+            state.ChangeTimestamp = changeTimestamp;
+            for (size_t i = 0; i < monitors.size(); i++)
+            {
+                if (monitors[i].GetHandle() == monitor)
+                {
+                    state.MonitorIndex = (uint32_t)i;
+                    state.Bounds = monitors[i].GetRectangle();
+                    break;
+                }
+            }
+
+            // The sequence number is assigned by the write, so it's read back for the socket rather than predicted
+            state.PublishTimestamp = HydraCore::GetTimestamp();
+            block->Write(state);
+            state.Sequence = block->GetSequence();
+            message = FormatJson(state);
+        }
+
+        server->Broadcast(message);
+    }
+
+    void TrackerFeed::TopologyChanged(uint64_t timestamp)
+    {
+        std::vector<Monitor> newMonitors = GetMonitorsLeftToRight(platform);
+
+        MonitorHandle monitor;
+        uint64_t changeTimestamp;
+        {
+            std::lock_guard<std::mutex> lock(publishMutex);
+            monitors = newMonitors;
+            monitor = lastMonitor;
+            changeTimestamp = lastChangeTimestamp;
+        }
+
+        // The active monitor may have been moved or resized even if it's still the active one
+        Publish(monitor, changeTimestamp);
+    }
+
+    std::string TrackerFeed::FormatJson(const TrackerFeedState& state)
+    {
+        char ret[384];
+        snprintf
+        (
+            ret, sizeof(ret),
+            "{\"sequence\":%llu,\"monitor\":%llu,\"index\":%u,\"left\":%d,\"top\":%d,\"width\":%u,\"height\":%u,\"changeTimestamp\":%llu,\"publishTimestamp\":%llu}\n",
+            (unsigned long long)state.Sequence, (unsigned long long)state.Monitor, state.MonitorIndex,
+            state.Bounds.Left, state.Bounds.Top, state.Bounds.Width, state.Bounds.Height,
+            (unsigned long long)state.ChangeTimestamp, (unsigned long long)state.PublishTimestamp
+        );
+        return ret;
+    }
+
+    TrackerFeedReader::TrackerFeedReader(const std::string& name)
+    {
+        sharedMemory = SharedMemory::Open(name, sizeof(TrackerFeedBlock), true);
+        block = (const TrackerFeedBlock*)sharedMemory->GetAddress();
+    }
+
+    TrackerFeedReader::~TrackerFeedReader()
+    {
+        delete sharedMemory;
+    }
+
+    bool TrackerFeedReader::Read(TrackerFeedState& state)
+    {
+        if (!block->IsValid())
+        {
+            return false;
+        }
+
+        state = block->Read();
+        return true;
+    }
+}
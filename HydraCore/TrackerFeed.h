@@ -0,0 +1,137 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "ActiveMonitorTracker.h"
+#include "DisplayPlatform.h"
+#include "LocalSocketServer.h"
+#include "Monitor.h"
+#include "Rectangle.h"
+#include "SharedMemory.h"
+
+// The name of the shared memory block and the socket (see SharedMemory and LocalSocketServer for where they end up)
+#define TRACKER_FEED_NAME "hydra-tracker"
+
+namespace HydraCore
+{
+    struct TrackerFeedState
+    {
+        // Incremented every time the state is published, so readers can tell whether anything changed (or how many changes they missed)
+        uint64_t Sequence;
+        // The platform's monitor handle (the HMONITOR on Windows)
+        uint64_t Monitor;
+        // The monitor's position in left-to-right order
+        uint32_t MonitorIndex;
+        Rectangle Bounds;
+        // When the tracker observed the change and when it was published, on the same clock as HydraCore::GetTimestamp (CLOCK_MONOTONIC or QueryPerformanceCounter)
+        uint64_t ChangeTimestamp;
+        uint64_t PublishTimestamp;
+    };
+
+    // The layout of the shared memory block, which is protected by a sequence lock so that readers never block the publisher (or each other.)
+    // The payload is stored in atomics so that reading it while it's being written is well-defined, a reader just has to retry when that happens.
+    struct TrackerFeedBlock
+    {
+        static const uint32_t ExpectedMagic = 0x52445948; // "HYDR"
+        static const uint32_t CurrentVersion = 1;
+
+        // Magic is written last when the block is initialized, readers should ignore the block until it's correct
+        std::atomic<uint32_t> Magic;
+        uint32_t Version;
+
+        // Odd while a write is in progress, the sequence number is half of this
+        std::atomic<uint64_t> SequenceLock;
+        std::atomic<uint64_t> Monitor;
+        std::atomic<uint64_t> MonitorIndex;
+        std::atomic<uint64_t> Position;
+        std::atomic<uint64_t> Size;
+        std::atomic<uint64_t> ChangeTimestamp;
+        std::atomic<uint64_t> PublishTimestamp;
+
+        // Only one thread may write at a time
+        void Write(const TrackerFeedState& state);
+
+        // Returns false if a write was in progress, in which case the state should be read again
+        bool TryRead(TrackerFeedState& state) const;
+
+        // Reads the state, retrying until no write gets in the way
+        TrackerFeedState Read() const;
+
+        inline uint64_t GetSequence() const
+        {
+            return SequenceLock.load(std::memory_order_acquire) / 2;
+        }
+
+        inline bool IsValid() const
+        {
+            return Magic.load(std::memory_order_acquire) == ExpectedMagic && Version == CurrentVersion;
+        }
+    };
+
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The tracker feed relies on lock-free 64-bit atomics, which work across processes.");
+
+    // Publishes the tracker's active monitor to other programs (IE: overlays and automation tools) so they don't need focus hooks of their own.
+    // Readers either map the shared memory block (see TrackerFeedReader) or connect to the socket, which streams a line of JSON per change:
+    // {"sequence":1,"monitor":65537,"index":0,"left":0,"top":0,"width":1920,"height":1080,"changeTimestamp":...,"publishTimestamp":...}
+    class TrackerFeed
+    {
+    private:
+        DisplayPlatform* platform;
+        ActiveMonitorTracker* tracker;
+        EventSubscriptionHandle trackerSubscription;
+        EventSubscriptionHandle topologySubscription;
+
+        SharedMemory* sharedMemory;
+        TrackerFeedBlock* block;
+        LocalSocketServer* server;
+
+        // Guards the block (which needs a single writer) and the cached monitors
+        std::mutex publishMutex;
+        std::vector<Monitor> monitors;
+        MonitorHandle lastMonitor;
+        uint64_t lastChangeTimestamp;
+
+        void Publish(MonitorHandle monitor, uint64_t changeTimestamp);
+        void TopologyChanged(uint64_t timestamp);
+    public:
+        // Throws if the block or the socket can't be created (IE: another OBS instance is already publishing)
+        TrackerFeed(DisplayPlatform* platform, ActiveMonitorTracker* tracker, const std::string& name = TRACKER_FEED_NAME);
+        ~TrackerFeed();
+
+        inline uint32_t GetClientCount()
+        {
+            return server->GetClientCount();
+        }
+
+        inline std::string GetSocketPath()
+        {
+            return server->GetPath();
+        }
+
+        static std::string FormatJson(const TrackerFeedState& state);
+    };
+
+    // Maps the block published by a TrackerFeed in another process, reading it never copies more than the state itself
+    class TrackerFeedReader
+    {
+    private:
+        SharedMemory* sharedMemory;
+        const TrackerFeedBlock* block;
+    public:
+        // Throws if no feed is being published
+        TrackerFeedReader(const std::string& name = TRACKER_FEED_NAME);
+        ~TrackerFeedReader();
+
+        // Returns false if the publisher hasn't finished initializing the block
+        bool Read(TrackerFeedState& state);
+
+        // A single load, for polling the block for changes cheaply
+        inline uint64_t GetSequence()
+        {
+            return block->GetSequence();
+        }
+    };
+}
@@ -0,0 +1,99 @@
+#include "Clock.h"
+#include "WindowFilter.h"
+
+#include <algorithm>
+#include <ctype.h>
+
+namespace HydraCore
+{
+    static std::string ToLower(std::string value)
+    {
+        std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return (char)tolower(c); });
+        return value;
+    }
+
+    WindowFilter::WindowFilter(DisplayPlatform* platform)
+    {
+        this->platform = platform;
+        statistics = {};
+    }
+
+    bool WindowFilter::Matches(const WindowInfo& info)
+    {
+        std::string executableName = ToLower(info.ExecutableName);
+        std::string windowClass = ToLower(info.WindowClass);
+
+        return (!executableName.empty() && std::find(ignoredExecutables.begin(), ignoredExecutables.end(), executableName) != ignoredExecutables.end())
+            || (!windowClass.empty() && std::find(ignoredWindowClasses.begin(), ignoredWindowClasses.end(), windowClass) != ignoredWindowClasses.end());
+    }
+
+    void WindowFilter::SetRules(const std::vector<std::string>& ignoredExecutables, const std::vector<std::string>& ignoredWindowClasses)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        this->ignoredExecutables.clear();
+        for (const std::string& executable : ignoredExecutables)
+        {
+            this->ignoredExecutables.push_back(ToLower(executable));
+        }
+
+        this->ignoredWindowClasses.clear();
+        for (const std::string& windowClass : ignoredWindowClasses)
+        {
+            this->ignoredWindowClasses.push_back(ToLower(windowClass));
+        }
+
+        for (auto& entry : cache)
+        {
+            entry.second.IsIgnored = Matches(entry.second.Info);
+        }
+    }
+
+    bool WindowFilter::ShouldIgnore(WindowId window)
+    {
+        uint64_t startTime = GetTimestamp();
+        std::lock_guard<std::mutex> lock(mutex);
+        statistics.EventCount++;
+
+        // Without any rules there's no reason to resolve anything
+        bool ret = false;
+        if (!ignoredExecutables.empty() || !ignoredWindowClasses.empty())
+        {
+            auto entry = cache.find(window);
+            if (entry != cache.end())
+            {
+                statistics.CacheHitCount++;
+                ret = entry->second.IsIgnored;
+            }
+            else
+            {
+                statistics.CacheMissCount++;
+                CachedWindow cachedWindow;
+                cachedWindow.Info = platform->GetWindowInfo(window);
+                cachedWindow.IsIgnored = Matches(cachedWindow.Info);
+                cache.emplace(window, cachedWindow);
+                ret = cachedWindow.IsIgnored;
+            }
+        }
+
+        if (ret)
+        {
+            statistics.IgnoredCount++;
+        }
+
+        statistics.FilterNanoseconds += GetTimestamp() - startTime;
+        return ret;
+    }
+
+    void WindowFilter::Forget(WindowId window)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cache.erase(window);
+    }
+
+    WindowFilterStatistics WindowFilter::GetStatistics()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return statistics;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "DisplayPlatform.h"
+
+namespace HydraCore
+{
+    struct WindowFilterStatistics
+    {
+        uint64_t EventCount;
+        uint64_t CacheHitCount;
+        uint64_t CacheMissCount;
+        uint64_t IgnoredCount;
+        // Time spent filtering, including resolving windows which weren't cached
+        uint64_t FilterNanoseconds;
+
+        inline double GetCacheHitRate()
+        {
+            uint64_t lookupCount = CacheHitCount + CacheMissCount;
+            return lookupCount == 0 ? 0.0 : (double)CacheHitCount / (double)lookupCount;
+        }
+
+        inline double GetNanosecondsPerEvent()
+        {
+            return EventCount == 0 ? 0.0 : (double)FilterNanoseconds / (double)EventCount;
+        }
+    };
+
+    // Decides which windows should be ignored when they're focused based on their executable name or window class
+    // Looking up a window's executable is expensive, so each window is resolved the first time it's seen and cached until it is destroyed.
+    class WindowFilter
+    {
+    private:
+        struct CachedWindow
+        {
+            WindowInfo Info;
+            bool IsIgnored;
+        };
+
+        DisplayPlatform* platform;
+        std::mutex mutex;
+        std::unordered_map<WindowId, CachedWindow> cache;
+        // These are stored in lowercase since both are case-insensitive on Windows
+        std::vector<std::string> ignoredExecutables;
+        std::vector<std::string> ignoredWindowClasses;
+        WindowFilterStatistics statistics;
+
+        bool Matches(const WindowInfo& info);
+    public:
+        WindowFilter(DisplayPlatform* platform);
+
+        // Replaces the rules, windows which are already cached are re-evaluated without being resolved again
+        void SetRules(const std::vector<std::string>& ignoredExecutables, const std::vector<std::string>& ignoredWindowClasses);
+
+        bool ShouldIgnore(WindowId window);
+
+        // Removes a destroyed window from the cache so that its ID being reused doesn't inherit its decision
+        void Forget(WindowId window);
+
+        WindowFilterStatistics GetStatistics();
+    };
+}
@@ -16,131 +16,607 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 ---------------------------------------------------------------------*/
 #include "ActiveMonitorSource.h"
+#include "CaptureBackend.h"
+#include "GpuTimer.h"
 #include "ObsSourceDefinition.h"
+#include "OverviewAtlas.h"
+#include "SourceStatistics.h"
 
 #include <algorithm>
 #include <ActiveMonitorTracker.h>
+#include <atomic>
+#include <Clock.h>
+#include <CompositeLayout.h>
+#include <CursorMonitorTracker.h>
+#include <CursorOverlay.h>
+#include <DisplayPlatform.h>
+#include <FrameBudgetGovernor.h>
 #include <Monitor.h>
+#include <MotionQuality.h>
+#include <MonitorTrackingPolicy.h>
+#include <mutex>
 #include <obs.h>
-#include <LinearAnimation.h>
+#include <RenderCommandList.h>
+#include <RenderTransform.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <TimelineAnimation.h>
+#include <util/profiler.h>
 #include <vector>
 
 #define SHOW_CURSOR_PROPERTY "showCursor"
 #define USE_PRIMARY_FOR_SIZE_PROPERTY "usePrimaryMonitorForSize"
 #define WIDTH_PROPERTY "width"
 #define HEIGHT_PROPERTY "height"
+#define SCALE_MODE_PROPERTY "scaleMode"
+
+// Per-monitor crop settings are stored under the monitor's name with these suffixes
+#define MONITOR_CROP_LEFT_PROPERTY_SUFFIX ".cropLeft"
+#define MONITOR_CROP_TOP_PROPERTY_SUFFIX ".cropTop"
+#define MONITOR_CROP_RIGHT_PROPERTY_SUFFIX ".cropRight"
+#define MONITOR_CROP_BOTTOM_PROPERTY_SUFFIX ".cropBottom"
+
+#define TRACKING_MODE_PROPERTY "trackingMode"
+#define CURSOR_SAMPLE_RATE_PROPERTY "cursorSampleRate"
+#define CURSOR_DEAD_ZONE_PROPERTY "cursorDeadZone"
+#define CURSOR_DWELL_TIME_PROPERTY "cursorDwellTime"
+#define IGNORED_EXECUTABLES_PROPERTY "ignoredExecutables"
+#define IGNORED_WINDOW_CLASSES_PROPERTY "ignoredWindowClasses"
+#define LIVE_DRAG_ENABLED_PROPERTY "liveDragEnabled"
+#define LIVE_DRAG_RATE_PROPERTY "liveDragRate"
 
 #define ANIMATION_ENABLED_PROPERTY "animationEnabled"
 #define ANIMATION_SPEED_PROPERTY "animationSpeed"
+#define MOTION_QUALITY_PROPERTY "motionQuality"
+#define MOTION_SCALE_PROPERTY "motionScale"
+
+#define ADAPTIVE_QUALITY_PROPERTY "adaptiveQuality"
+#define RENDER_BUDGET_PROPERTY "renderBudget"
+
+#define MEASURE_GPU_TIME_PROPERTY "measureGpuTime"
+#define STATISTICS_PROPERTY "statistics"
+#define REFRESH_STATISTICS_PROPERTY "refreshStatistics"
+
+// These aren't user-facing, they're written by Save so the source can start on the right monitor when the collection is loaded
+#define TOPOLOGY_FINGERPRINT_PROPERTY "topologyFingerprint"
+#define LAST_ACTIVE_MONITOR_PROPERTY "lastActiveMonitor"
 
 #define OVERVIEW_MODE_PROPERTY "overviewMode"
 #define OVERVIEW_OUTLINE_ENABLED_PROPERTY "overviewOutlineEnabled"
 #define OVERVIEW_OUTLINE_THICKNESS_PROPERTY "overviewOutlineThickness"
 #define OVERVIEW_OUTLINE_COLOR_PROPERTY "overviewOutlineColor"
 
-// These correspond to the properties used by plugins\win-capture\duplicator-monitor-capture.c
-#define MONITOR_CAPTURE_SOURCE_ID "monitor_capture"
-#define MONITOR_CAPTURE_MONITOR_ID_LEGACY_PROPERTY "monitor"
-#define MONITOR_CAPTURE_MONITOR_ID_PROPERTY "monitor_id"
-#define MONITOR_CAPTURE_METHOD_PROPERTY "method"
-#define MONITOR_CAPTURE_CURSOR_PROPERTY "capture_cursor"
-#define MONITOR_CAPTURE_FORCE_SDR_PROPERTY "force_sdr"
+// OBS identifies profiler scopes by the address of their name, so these must be stable
+static const char* const VideoTickProfilerName = "ActiveMonitorSource::VideoTick";
+static const char* const VideoRenderProfilerName = "ActiveMonitorSource::VideoRender";
+static const char* const RenderOverviewModeProfilerName = "ActiveMonitorSource::RenderOverviewMode";
+static const char* const RenderNormalModeProfilerName = "ActiveMonitorSource::RenderNormalMode";
+
+// How often statistics are published for the properties view
+static const uint64_t StatisticsWindow = 1'000'000'000;
+
+// Drawn in place of a monitor whose capture isn't up yet
+static const uint32_t PlaceholderColor = 0xff202020;
+
+// Reads the values of an editable list property
+static std::vector<std::string> GetStringList(obs_data_t* settings, const char* name)
+{
+    std::vector<std::string> ret;
+    obs_data_array_t* array = obs_data_get_array(settings, name);
+    size_t count = obs_data_array_count(array);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        obs_data_t* item = obs_data_array_item(array, i);
+        const char* value = obs_data_get_string(item, "value");
+        if (value[0] != '\0')
+        {
+            ret.push_back(value);
+        }
+        obs_data_release(item);
+    }
+
+    obs_data_array_release(array);
+    return ret;
+}
 
-enum monitor_capture_method
+// The per-frame state of a child, ActiveMonitorSource keeps these in one array indexed by child
+// This is everything the per-frame loops look at, so they walk that array instead of following a pointer into each child's MonitorSource.
+// Only touched from the graphics thread.
+struct ChildState
 {
-    MONITOR_CAPTURE_METHOD_AUTO,
-    MONITOR_CAPTURE_METHOD_DXGI,
-    MONITOR_CAPTURE_METHOD_WGC,
+    // Copied from the MonitorSource by VideoTick once the capture has been created, null until then
+    obs_source_t* Source;
+    // Set while the capture has been taken out of our active children because the frame budget doesn't leave room for it
+    uint8_t IsParked;
+
+    // The render transform is cached and only recomputed when the child's size or our settings change
+    uint8_t IsTransformDirty;
+    HydraCore::ScaleMode TransformScaleMode;
+    uint32_t SourceWidth;
+    uint32_t SourceHeight;
+    uint32_t TargetWidth;
+    uint32_t TargetHeight;
+    HydraCore::Margins Crop;
+    HydraCore::RenderTransform Transform;
 };
 
+// The capture of a single monitor along with what's needed to draw it, the per-frame state it's drawn with is passed in from its ChildState
 class MonitorSource
 {
 private:
-    obs_source_t* source;
+    // The child is created in the background by ActiveMonitorSource, this stays null until it's ready to be used
+    std::atomic<obs_source_t*> source;
+    // The ActiveMonitorSource the child was added to as an active child
+    obs_source_t* parent;
+    // Mirrors ChildState::IsParked for EnumSources and the destructor, which don't run on the graphics thread
+    std::atomic<bool> isParked;
+    // Only needed until the child is created, which takes its own reference
     obs_data_t* settings;
-    HydraCore::Monitor monitor;
-    bool showCursor;
-    bool isEnabled;
-    int physicalIndex;
+
+    // When the child can't be drawn directly, it is rendered here (at most once per frame) so we can resample it ourselves
+    gs_texrender_t* childTexrender;
+    uint64_t childTexrenderFrameTime;
+    gs_samplerstate_t* pointSampler;
+
+    // When the frame budget lowers how often this child's overview tile is redrawn, its last drawing is kept here
+    gs_texrender_t* tileTexrender;
+    uint64_t tileFrameTime;
+
+    // Optional GPU timing of each scale path
+    bool measureGpuTime;
+    GpuTimer* gpuTimer;
+    HydraCore::ScalePath gpuTimerPath;
+    GpuTimeStatistics scalePathGpuTime[HydraCore::SCALE_PATH_COUNT];
+
+    // Statistics since the last call to TakeStatistics
+    uint64_t renderCount;
+    uint64_t skippedTileRefreshCount;
+    GpuTimeStatistics gpuTime;
+
+    // Stored in OBS's name store since the profiler outlives us
+    const char* profilerName;
+
+    gs_texture_t* RenderChildTexture(const ChildState& state)
+    {
+        if (childTexrender == nullptr)
+        {
+            childTexrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+        }
+
+        uint64_t frameTime = obs_get_video_frame_time();
+        if (childTexrenderFrameTime != frameTime)
+        {
+            childTexrenderFrameTime = frameTime;
+            gs_texrender_reset(childTexrender);
+
+            if (gs_texrender_begin(childTexrender, state.SourceWidth, state.SourceHeight))
+            {
+                vec4 clearColor;
+                vec4_zero(&clearColor);
+                gs_clear(GS_CLEAR_COLOR, &clearColor, 0.f, 0);
+                gs_ortho(0.f, (float)state.SourceWidth, 0.f, (float)state.SourceHeight, -100.f, 100.f);
+
+                gs_blend_state_push();
+                gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+                obs_source_video_render(state.Source);
+                gs_blend_state_pop();
+
+                gs_texrender_end(childTexrender);
+            }
+        }
+
+        return gs_texrender_get_texture(childTexrender);
+    }
+
+    void DrawChildTexture(const ChildState& state, gs_effect_t* effect, bool pointFilter)
+    {
+        gs_texture_t* texture = RenderChildTexture(state);
+        if (texture == nullptr)
+        { return; }
+
+        gs_eparam_t* image = gs_effect_get_param_by_name(effect, "image");
+
+        // The resampling effects need to know the size of the texture they're sampling
+        gs_eparam_t* baseDimension = gs_effect_get_param_by_name(effect, "base_dimension");
+        gs_eparam_t* baseDimensionInverse = gs_effect_get_param_by_name(effect, "base_dimension_i");
+        gs_eparam_t* undistortFactor = gs_effect_get_param_by_name(effect, "undistort_factor");
+
+        if (baseDimension != nullptr)
+        {
+            vec2 dimension;
+            vec2_set(&dimension, (float)state.SourceWidth, (float)state.SourceHeight);
+            gs_effect_set_vec2(baseDimension, &dimension);
+        }
+
+        if (baseDimensionInverse != nullptr)
+        {
+            vec2 dimensionInverse;
+            vec2_set(&dimensionInverse, 1.f / (float)state.SourceWidth, 1.f / (float)state.SourceHeight);
+            gs_effect_set_vec2(baseDimensionInverse, &dimensionInverse);
+        }
+
+        if (undistortFactor != nullptr)
+        {
+            gs_effect_set_float(undistortFactor, 1.f);
+        }
+
+        bool previousSrgb = gs_framebuffer_srgb_enabled();
+        gs_enable_framebuffer_srgb(true);
+        gs_effect_set_texture_srgb(image, texture);
+
+        if (pointFilter)
+        {
+            if (pointSampler == nullptr)
+            {
+                gs_sampler_info samplerInfo = {};
+                samplerInfo.filter = GS_FILTER_POINT;
+                samplerInfo.address_u = GS_ADDRESS_CLAMP;
+                samplerInfo.address_v = GS_ADDRESS_CLAMP;
+                samplerInfo.address_w = GS_ADDRESS_CLAMP;
+                pointSampler = gs_samplerstate_create(&samplerInfo);
+            }
+
+            gs_effect_set_next_sampler(image, pointSampler);
+        }
+
+        const HydraCore::RenderTransform& transform = state.Transform;
+        gs_matrix_push();
+        gs_matrix_translate3f(transform.X, transform.Y, 0.f);
+        gs_matrix_scale3f(transform.Width / (float)transform.SourceWidth, transform.Height / (float)transform.SourceHeight, 1.f);
+
+        while (gs_effect_loop(effect, "Draw"))
+        {
+            gs_draw_sprite_subregion(texture, 0, transform.SourceX, transform.SourceY, transform.SourceWidth, transform.SourceHeight);
+        }
+
+        gs_matrix_pop();
+        gs_enable_framebuffer_srgb(previousSrgb);
+    }
+
+    void DrawChildDirect(const ChildState& state)
+    {
+        gs_matrix_push();
+        gs_matrix_translate3f(state.Transform.X, state.Transform.Y, 0.f);
+        gs_matrix_scale3f(state.Transform.Width / (float)state.SourceWidth, state.Transform.Height / (float)state.SourceHeight, 1.f);
+        obs_source_video_render(state.Source);
+        gs_matrix_pop();
+    }
+
+    void RenderScalePath(const ChildState& state)
+    {
+        const HydraCore::RenderTransform& transform = state.Transform;
+        switch (transform.Path)
+        {
+            case HydraCore::SCALE_PATH_IDENTITY:
+                // Nothing to scale, so the child can draw itself (it still has to be moved to the transform's offset, IE: when fitting)
+                if (!transform.IsCropped)
+                {
+                    DrawChildDirect(state);
+                }
+                else
+                {
+                    DrawChildTexture(state, obs_get_base_effect(OBS_EFFECT_DEFAULT), true);
+                }
+                break;
+            case HydraCore::SCALE_PATH_INTEGER_DOWNSCALE:
+                // At exactly half size a single bilinear tap is a 2x2 box filter, so the child can draw itself
+                // Larger integer factors use the area filter, which is an exact box filter at integer ratios.
+                if (transform.ScaleFactor == 2 && !transform.IsCropped)
+                {
+                    DrawChildDirect(state);
+                }
+                else
+                {
+                    DrawChildTexture(state, obs_get_base_effect(OBS_EFFECT_AREA), false);
+                }
+                break;
+            case HydraCore::SCALE_PATH_INTEGER_UPSCALE:
+                DrawChildTexture(state, obs_get_base_effect(OBS_EFFECT_DEFAULT), true);
+                break;
+            case HydraCore::SCALE_PATH_FILTERED:
+            default:
+                // Area averaging avoids aliasing when shrinking, bicubic keeps things sharp when growing
+                if (transform.SourceWidth > transform.Width || transform.SourceHeight > transform.Height)
+                {
+                    DrawChildTexture(state, obs_get_base_effect(OBS_EFFECT_AREA), false);
+                }
+                else
+                {
+                    DrawChildTexture(state, obs_get_base_effect(OBS_EFFECT_BICUBIC), false);
+                }
+                break;
+        }
+    }
 public:
-    MonitorSource(HydraCore::Monitor& monitor, bool showCursor)
-        : monitor(monitor), showCursor(showCursor)
+    // ActiveMonitorSource keeps its MonitorSources in an array which is sized once, so they're set up by Initialize rather than the constructor
+    MonitorSource()
     {
-        this->showCursor = showCursor;
-        isEnabled = true;
-        this->physicalIndex = 0;
+        source = nullptr;
+        parent = nullptr;
+        isParked = false;
+        settings = nullptr;
+
+        childTexrender = nullptr;
+        childTexrenderFrameTime = 0;
+        pointSampler = nullptr;
+
+        tileTexrender = nullptr;
+        tileFrameTime = 0;
+
+        measureGpuTime = false;
+        gpuTimer = nullptr;
+        gpuTimerPath = HydraCore::SCALE_PATH_IDENTITY;
+        memset(scalePathGpuTime, 0, sizeof(scalePathGpuTime));
+
+        renderCount = 0;
+        skippedTileRefreshCount = 0;
+        gpuTime = {};
+        profilerName = nullptr;
+    }
+
+    // The monitor is only used to set up the capture, ActiveMonitorSource keeps the monitors itself
+    void Initialize(HydraCore::Monitor& monitor)
+    {
+        profilerName = profile_store_name(obs_get_profiler_name_store(), "Hydra child: %s", monitor.GetDescription().c_str());
 
         // Create a data collection to hold the source's settings
         // We can't share this between sources because OBS will use it internally for the source, meaning each source will have the same settings data.
         // (See obs.c:1808 - obs_data_newref is used, only adding a reference - not cloning the settings.)
         settings = obs_data_create();
-        
-        // https://github.com/obsproject/obs-studio/pull/7049 changed the monitor ID from using the monitor index to the monitor's DeviceID
-        if ((obs_get_version() >> 24) < 29)
-        {
-            obs_data_set_int(settings, MONITOR_CAPTURE_MONITOR_ID_LEGACY_PROPERTY, monitor.GetId());
-        }
-        else
+        CaptureBackend::GetInstance()->InitializeSettings(settings, monitor);
+    }
+
+    // Creates the child capture source, this can take a while so it's called from a background thread
+    // Returns the number of nanoseconds creation took.
+    uint64_t CreateSource(obs_source_t* parent, const char* name)
+    {
+        uint64_t startTime = HydraCore::GetTimestamp();
+
+        obs_source_t* createdSource = obs_source_create_private(CaptureBackend::GetInstance()->GetSourceId(), name, settings);
+        obs_data_release(settings);
+        settings = nullptr;
+
+        // This matches how scenes add their items, the child picks up our active/showing state before we start enumerating it
+        if (createdSource != nullptr)
         {
-            obs_data_set_string(settings, MONITOR_CAPTURE_MONITOR_ID_PROPERTY, monitor.GetInterfaceId().c_str());
+            this->parent = parent;
+            obs_source_add_active_child(parent, createdSource);
+            source.store(createdSource, std::memory_order_release);
         }
 
-        obs_data_set_int(settings, MONITOR_CAPTURE_METHOD_PROPERTY, MONITOR_CAPTURE_METHOD_DXGI);
-        obs_data_set_bool(settings, MONITOR_CAPTURE_CURSOR_PROPERTY, showCursor);
-        obs_data_set_bool(settings, MONITOR_CAPTURE_FORCE_SDR_PROPERTY, true); //TODO: Investigate adding HDR support
+        return HydraCore::GetTimestamp() - startTime;
+    }
 
-        source = obs_source_create_private(MONITOR_CAPTURE_SOURCE_ID, monitor.GetDescription().c_str(), settings);
+    // Returns null until the child has been created
+    obs_source_t* GetSource()
+    {
+        return source.load(std::memory_order_acquire);
     }
 
-    void SetShowCursor(bool showCursor)
+    bool IsParked()
     {
-        if (this->showCursor == showCursor)
-        { return; }
+        return isParked.load(std::memory_order_relaxed);
+    }
 
-        this->showCursor = showCursor;
-        obs_data_set_bool(settings, MONITOR_CAPTURE_CURSOR_PROPERTY, showCursor);
+    // Stops or restarts the capture by removing it from or adding it back to our active children, which is how scenes hide and show their items
+    void SetIsParked(ChildState& state, bool parked)
+    {
+        if (state.Source == nullptr || (state.IsParked != 0) == parked)
+        { return; }
 
-        obs_source_update(source, settings);
+        state.IsParked = parked;
+        if (parked)
+        {
+            isParked.store(true, std::memory_order_relaxed);
+            obs_source_remove_active_child(parent, state.Source);
+        }
+        else
+        {
+            obs_source_add_active_child(parent, state.Source);
+            isParked.store(false, std::memory_order_relaxed);
+        }
     }
 
-    std::string GetMonitorName()
+    void RenderPlaceholder(const ChildState& state)
     {
-        return monitor.GetName();
+        gs_effect_t* solidEffect = obs_get_base_effect(OBS_EFFECT_SOLID);
+        vec4 color;
+        vec4_from_rgba(&color, PlaceholderColor);
+        gs_effect_set_vec4(gs_effect_get_param_by_name(solidEffect, "color"), &color);
+
+        while (gs_effect_loop(solidEffect, "Solid"))
+        {
+            gs_draw_sprite(nullptr, 0, state.TargetWidth, state.TargetHeight);
+        }
     }
 
-    HMONITOR GetMonitorHandle()
+    // Renders the child into the target area its transform was last computed for
+    void Render(const ChildState& state)
     {
-        return monitor.GetHandle();
+        if (!state.Transform.IsValid)
+        {
+            RenderPlaceholder(state);
+            return;
+        }
+
+        profile_start(profilerName);
+        renderCount++;
+
+        // The timer is created and destroyed here since it belongs to the graphics thread
+        if (measureGpuTime != (gpuTimer != nullptr))
+        {
+            delete gpuTimer;
+            gpuTimer = measureGpuTime ? new GpuTimer() : nullptr;
+        }
+
+        if (gpuTimer == nullptr)
+        {
+            RenderScalePath(state);
+        }
+        else
+        {
+            double milliseconds;
+            if (gpuTimer->Poll(&milliseconds))
+            {
+                scalePathGpuTime[gpuTimerPath].Add(milliseconds);
+                gpuTime.Add(milliseconds);
+            }
+
+            if (gpuTimer->Begin())
+            {
+                gpuTimerPath = state.Transform.Path;
+                RenderScalePath(state);
+                gpuTimer->End();
+            }
+            else
+            {
+                RenderScalePath(state);
+            }
+        }
+
+        profile_end(profilerName);
     }
 
-    obs_source_t* GetSource()
+    // Draws the tile from its last drawing, which is only redrawn on frames where refresh is set (or when there's nothing to draw yet)
+    void RenderThrottled(const ChildState& state, bool refresh)
     {
-        return source;
+        if (!state.Transform.IsValid)
+        {
+            RenderPlaceholder(state);
+            return;
+        }
+
+        if (tileTexrender == nullptr)
+        {
+            tileTexrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+        }
+
+        uint64_t frameTime = obs_get_video_frame_time();
+        if (tileFrameTime != frameTime && (refresh || gs_texrender_get_texture(tileTexrender) == nullptr))
+        {
+            tileFrameTime = frameTime;
+            gs_texrender_reset(tileTexrender);
+
+            if (gs_texrender_begin(tileTexrender, state.TargetWidth, state.TargetHeight))
+            {
+                vec4 clearColor;
+                vec4_zero(&clearColor);
+                gs_clear(GS_CLEAR_COLOR, &clearColor, 0.f, 0);
+                gs_ortho(0.f, (float)state.TargetWidth, 0.f, (float)state.TargetHeight, -100.f, 100.f);
+
+                gs_blend_state_push();
+                gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+                Render(state);
+                gs_blend_state_pop();
+
+                gs_texrender_end(tileTexrender);
+            }
+        }
+        else if (tileFrameTime != frameTime)
+        {
+            tileFrameTime = frameTime;
+            skippedTileRefreshCount++;
+        }
+
+        gs_texture_t* texture = gs_texrender_get_texture(tileTexrender);
+        if (texture == nullptr)
+        { return; }
+
+        // Like the cached composite, the tile was cleared to transparent so it's drawn as premultiplied alpha
+        gs_effect_t* defaultEffect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+        bool previousSrgb = gs_framebuffer_srgb_enabled();
+        gs_enable_framebuffer_srgb(true);
+        gs_effect_set_texture_srgb(gs_effect_get_param_by_name(defaultEffect, "image"), texture);
+
+        gs_blend_state_push();
+        gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+
+        while (gs_effect_loop(defaultEffect, "Draw"))
+        {
+            gs_draw_sprite(texture, 0, state.TargetWidth, state.TargetHeight);
+        }
+
+        gs_blend_state_pop();
+        gs_enable_framebuffer_srgb(previousSrgb);
     }
 
-    bool IsEnabled()
+    // Frees the tile's last drawing once the tile is being redrawn every frame again, must be called from the graphics thread
+    void ReleaseThrottledTile()
     {
-        return isEnabled;
+        if (tileTexrender != nullptr)
+        {
+            gs_texrender_destroy(tileTexrender);
+            tileTexrender = nullptr;
+        }
     }
 
-    void SetIsEnabled(bool enabled)
+    // Adds this child's statistics since the last call to the given statistics
+    void TakeStatistics(SourceStatistics& statistics, const ChildState& state, bool isEnabled)
     {
-        isEnabled = enabled;
+        statistics.ChildRenderCount += renderCount;
+        statistics.SkippedTileRefreshCount += skippedTileRefreshCount;
+        statistics.ChildGpuTime.SampleCount += gpuTime.SampleCount;
+        statistics.ChildGpuTime.TotalMilliseconds += gpuTime.TotalMilliseconds;
+        renderCount = 0;
+        skippedTileRefreshCount = 0;
+        gpuTime = {};
+
+        if (isEnabled && state.IsParked)
+        {
+            statistics.ParkedCaptureCount++;
+        }
+        else if (isEnabled && state.SourceWidth > 0 && state.SourceHeight > 0)
+        {
+            statistics.ActiveCaptureCount++;
+
+            // The capture's own texture plus our intermediate one when a scale path needed it (both 32bpp)
+            uint64_t textureSize = (uint64_t)state.SourceWidth * state.SourceHeight * 4;
+            statistics.EstimatedTextureMemory += childTexrender == nullptr ? textureSize : textureSize * 2;
+
+            if (tileTexrender != nullptr)
+            {
+                statistics.EstimatedTextureMemory += (uint64_t)state.TargetWidth * state.TargetHeight * 4;
+            }
+        }
     }
 
-    int GetPhysicalIndex()
+    void SetMeasureGpuTime(bool measureGpuTime)
     {
-        return physicalIndex;
+        this->measureGpuTime = measureGpuTime;
     }
 
-    void SetPhysicalIndex(int physicalIndex)
+    GpuTimeStatistics& GetScalePathGpuTime(HydraCore::ScalePath path)
     {
-        this->physicalIndex = physicalIndex;
+        return scalePathGpuTime[path];
     }
 
     ~MonitorSource()
     {
-        obs_source_release(source);
+        delete gpuTimer;
+
+        if (childTexrender != nullptr || pointSampler != nullptr || tileTexrender != nullptr)
+        {
+            obs_enter_graphics();
+            gs_texrender_destroy(childTexrender);
+            gs_samplerstate_destroy(pointSampler);
+            gs_texrender_destroy(tileTexrender);
+            obs_leave_graphics();
+        }
+
+        obs_source_t* createdSource = GetSource();
+        if (createdSource != nullptr)
+        {
+            // Parked children were already removed from the parent's active children
+            if (!IsParked())
+            {
+                obs_source_remove_active_child(parent, createdSource);
+            }
+
+            obs_source_release(createdSource);
+        }
+
         obs_data_release(settings);
     }
 };
@@ -149,98 +625,640 @@ class ActiveMonitorSource
 {
 private:
     obs_source_t* source;
-    std::vector<MonitorSource*> monitorSources;
-    
-    bool showCursor;
+
+    // Everything about the children is indexed by child (the order the monitors were enumerated in) and kept in separate arrays by how often it's used
+    // The per-frame loops only touch the hot arrays, the enabled children are rebuilt by Update since that's the only place children are enabled, disabled, or reordered.
+    // None of these are resized after the constructor.
+    // Cold: the captures and their GPU resources, only touched when a child is drawn or its capture is parked or restarted
+    std::vector<MonitorSource> monitorSources;
+    // Cold: names and descriptions, only needed for settings and logging
+    std::vector<HydraCore::Monitor> childMonitors;
+    // Hot: the capture, its size, and how it's drawn
+    std::vector<ChildState> childStates;
+    // Hot: these never change, but are copied out of the monitors so looking them up doesn't drag the rest of the monitor into the cache
+    std::vector<HydraCore::MonitorHandle> childHandles;
+    std::vector<HydraCore::Rectangle> childRectangles;
+    // Hot: rebuilt by Update
+    std::vector<uint8_t> enabledChildren;
+    // Each enabled child's position from the left (and its slot in the overview atlas)
+    std::vector<uint32_t> childPhysicalIndices;
+    // The enabled children from left to right
+    std::vector<uint32_t> enabledChildIndices;
+
+    // The children never draw the cursor, it's drawn once over the composite so showing or hiding it doesn't restart the captures
+    // The setting comes from the UI thread, everything else belongs to the graphics thread.
+    std::atomic<bool> showCursor;
+    HydraCore::CursorOverlay cursorOverlay;
+    gs_texture_t* cursorTexture;
+    uint64_t cursorTextureShapeId;
+    // Set once an upload of cursorTextureShapeId has been tried, so a shape the GPU rejects isn't retried every frame
+    bool isCursorTextureShapeUploaded;
 
     uint32_t width;
     uint32_t height;
+    HydraCore::ScaleMode scaleMode;
 
     bool overviewMode;
     bool overviewOutlineEnabled;
     int overviewOutlineThickness;
     vec4 overviewOutlineColor;
 
-    uint32_t activeMonitorCount;
+    // The overview copies each tile into the atlas (at most once per frame) and draws the atlas in one go
+    OverviewAtlas overviewAtlas;
+    uint64_t atlasFrameTime;
+
+    enum TrackerKey
+    {
+        TRACKER_KEY_FOCUS,
+        TRACKER_KEY_CURSOR,
+    };
 
     HydraCore::ActiveMonitorTracker* tracker;
     HydraCore::EventSubscriptionHandle trackerEventSubscription;
-    HMONITOR activeMonitorHandle;
-    MonitorSource* activeMonitor;
-
-    HydraCore::LinearAnimation animation;
+    // Only exists while a tracking mode which uses the cursor is selected
+    HydraCore::CursorMonitorTracker* cursorTracker;
+    HydraCore::EventSubscriptionHandle cursorTrackerEventSubscription;
+    // Monitor changes are recorded by the trackers' threads and fed to the tracking policy during VideoTick
+    HydraCore::DeferredEvent<TrackerKey, HydraCore::ActiveMonitorChange, 2> activeMonitorChangedEvent;
+    HydraCore::MonitorTrackingPolicy trackingPolicy;
+    HydraCore::MonitorTrackingMode trackingMode;
+    uint64_t cursorDwellTime;
+    HydraCore::MonitorHandle activeMonitorHandle;
+    uint32_t activeChild;
+
+    HydraCore::TimelineAnimation animation;
     bool animationEnabled;
 
+    // Motion hides detail, so slides can be drawn at a fraction of the resolution and scaled up
+    // The settings come from the UI thread, everything else belongs to the graphics thread.
+    HydraCore::MotionQualityTracker motionQuality;
+    std::atomic<bool> motionQualityEnabled;
+    std::atomic<uint32_t> motionScalePercent;
+    std::atomic<bool> measureSlideGpuTime;
+    gs_texrender_t* motionTexrender;
+    GpuTimer* slideGpuTimer;
+    bool slideGpuTimerReduced;
+
+    // Which children are drawn where, recomputed every tick from the settings, the active monitor, and the animation
+    HydraCore::CompositeLayoutSettings layoutSettings;
+    HydraCore::CompositeLayout compositeLayout;
+
+    // The layout and the composite's draws are recorded once and replayed every frame until one of their inputs changes
+    // Update bumps the settings version (rather than the recording being compared against every setting) since it's the only place the settings change.
+    HydraCore::RenderCommandList renderCommands;
+    std::atomic<uint64_t> settingsVersion;
+
     gs_effect_t* solidEffect;
     gs_eparam_t* solidEffectColor;
     gs_technique_t* solidEffectTechnique;
 
-    void ActiveMonitorChanged()
+    // When we're drawn more than once per frame (IE: studio mode, multiview, or projectors) the composite is rendered into this once and the texture is drawn everywhere else
+    // With a single view the copy would only add work, so the cache is only used once a frame has been drawn more than once.
+    gs_texrender_t* compositeTexrender;
+    uint64_t compositeFrameTime;
+    uint64_t renderFrameTime;
+    uint32_t frameRenderCount;
+    uint32_t lastFrameRenderCount;
+
+    // Trades away work on monitors which aren't the active one while we're over our share of the frame (or OBS is dropping frames)
+    // The settings come from the UI thread, everything else belongs to the graphics thread.
+    HydraCore::FrameBudgetGovernor frameBudget;
+    std::atomic<bool> adaptiveQualityEnabled;
+    std::atomic<uint32_t> renderBudgetPercent;
+    uint32_t lastLaggedFrameCount;
+    uint32_t lastSkippedFrameCount;
+    // Counts ticks so throttled overview tiles can take turns being redrawn
+    uint64_t tickIndex;
+    std::vector<uint8_t> warmChildren;
+
+    // Statistics are accumulated on the graphics thread and published once per StatisticsWindow
+    SourceStatistics pendingStatistics;
+    uint64_t statisticsWindowStart;
+    std::mutex statisticsMutex;
+    SourceStatistics lastStatistics;
+    SourceStatistics lifetimeStatistics;
+
+    uint64_t topologyFingerprint;
+    uint64_t createdTimestamp;
+    bool firstFrameLogged;
+
+    // Child captures are created in the background so loading a collection doesn't block OBS
+    std::thread creationThread;
+    std::atomic<bool> stopCreation;
+
+    void ActiveMonitorChanged(HydraCore::MonitorHandle newMonitor, uint64_t timestamp)
+    {
+        activeMonitorHandle = newMonitor;
+
+        // It is intentional that activeChild is not changed in the event the handle is not found in the sources collection
+        // This makes it so the last known visible monitor is the one that is visible.
+        for (uint32_t child : enabledChildIndices)
+        {
+            if (childHandles[child] == activeMonitorHandle)
+            {
+                activeChild = child;
+            }
+        }
+
+        // Retargeting cuts the running transition short and blends into a new one, so it's skipped when nothing moved
+        // (IE: Update calls this after every settings edit, and the policy can report the monitor we're already on.)
+        float targetPosition = (float)(childPhysicalIndices[activeChild] * width);
+        if (animationEnabled && targetPosition != animation.GetTargetPosition())
+        {
+            animation.SetTargetPosition(targetPosition, timestamp);
+        }
+    }
+
+    // Decides what VideoRender draws, this only changes when we tick so it isn't repeated for every view we're rendered into
+    void UpdateLayout()
+    {
+        compositeLayout.Update(layoutSettings, enabledChildren, activeChild, animation.GetCurrentPosition(), animation.IsAnimating());
+    }
+
+    void UpdateChildTransform(ChildState& state)
+    {
+        // Until the child exists it's treated as a capture which hasn't produced a frame yet
+        uint32_t sourceWidth = state.Source != nullptr ? obs_source_get_width(state.Source) : 0;
+        uint32_t sourceHeight = state.Source != nullptr ? obs_source_get_height(state.Source) : 0;
+
+        if (!state.IsTransformDirty
+            && sourceWidth == state.SourceWidth && sourceHeight == state.SourceHeight
+            && width == state.TargetWidth && height == state.TargetHeight
+            && scaleMode == state.TransformScaleMode)
+        { return; }
+
+        state.Transform = HydraCore::ComputeRenderTransform(sourceWidth, sourceHeight, state.Crop, width, height, scaleMode);
+        state.SourceWidth = sourceWidth;
+        state.SourceHeight = sourceHeight;
+        state.TargetWidth = width;
+        state.TargetHeight = height;
+        state.TransformScaleMode = scaleMode;
+        state.IsTransformDirty = false;
+    }
+
+    // Stops the captures which the frame budget doesn't leave room for and restarts the ones which are needed again
+    void UpdateWarmChildren()
+    {
+        HydraCore::SelectWarmChildren(enabledChildren, compositeLayout, activeChild, frameBudget.GetCurrentLevel().WarmNeighborCount, warmChildren);
+
+        for (uint32_t child : enabledChildIndices)
+        {
+            monitorSources[child].SetIsParked(childStates[child], !warmChildren[child]);
+        }
+    }
+
+public:
+    ActiveMonitorSource(obs_data_t* settings, obs_source_t* source)
+        : cursorOverlay(HydraCore::DisplayPlatform::GetCurrent())
+    {
+        this->source = source;
+        createdTimestamp = HydraCore::GetTimestamp();
+        firstFrameLogged = false;
+
+        // Initialize active monitor tracker
+        tracker = HydraCore::ActiveMonitorTracker::GetInstance();
+        trackerEventSubscription = tracker->SubscribeActiveMonitorChangedDeferred(&activeMonitorChangedEvent, TRACKER_KEY_FOCUS);
+        cursorTracker = nullptr;
+
+        // Create all monitor sources that we might need
+        // Instead of dnymaically creating/destroying them, we just create them all at once.
+        // OBS does not seem to properly handle the monitor set changing anyway
+        // Additionally, not creating sources ahead of time causes some weird behavior in the preview window.
+        // I suspect this is because OBS does not reenumerate our child sources when we are in preview mode, but I did not investigate very far.
+        // (The captures themselves are created on a background thread at the end of the constructor and added with obs_source_add_active_child,
+        // which gives them our active/showing state the same way scenes do for new items.)
+        std::vector<HydraCore::Monitor> monitors = HydraCore::Monitor::GetAllMonitors(true);
+        topologyFingerprint = HydraCore::Monitor::GetTopologyFingerprint(monitors);
+
+        ChildState initialState = {};
+        initialState.IsTransformDirty = true;
+        initialState.TransformScaleMode = HydraCore::SCALE_MODE_STRETCH;
+        monitorSources = std::vector<MonitorSource>(monitors.size());
+        childStates.assign(monitors.size(), initialState);
+
+        for (size_t i = 0; i < monitors.size(); i++)
+        {
+            monitorSources[i].Initialize(monitors[i]);
+            childHandles.push_back(monitors[i].GetHandle());
+            childRectangles.push_back(monitors[i].GetRectangle());
+        }
+
+        childMonitors = std::move(monitors);
+        activeChild = 0;
+        activeMonitorHandle = tracker->GetActiveMonitorHandle();
+
+        // When a collection is loading, the focused window is usually OBS itself rather than what the user was last looking at
+        // so we start on the monitor which was active when we were saved. The tracker only reports focus moving to a different monitor,
+        // so it's told about the restored monitor too, otherwise focusing a window on the monitor it had would never switch us back.
+        HydraCore::Monitor* restoredMonitor = RestoreLastActiveMonitor(settings);
+        if (restoredMonitor != nullptr)
+        {
+            activeMonitorHandle = restoredMonitor->GetHandle();
+            tracker->RestoreActiveMonitor(activeMonitorHandle);
+        }
+
+        trackingPolicy.FocusChanged(activeMonitorHandle, createdTimestamp);
+
+        // Get solid effect for overview mode
+        solidEffect = obs_get_base_effect(OBS_EFFECT_SOLID);
+        solidEffectColor = gs_effect_get_param_by_name(solidEffect, "color");
+        solidEffectTechnique = gs_effect_get_technique(solidEffect, "Solid");
+
+        atlasFrameTime = 0;
+
+        settingsVersion = 0;
+
+        showCursor = false;
+        cursorTexture = nullptr;
+        cursorTextureShapeId = 0;
+        isCursorTextureShapeUploaded = false;
+
+        motionQualityEnabled = false;
+        motionScalePercent = 100;
+        measureSlideGpuTime = false;
+        motionTexrender = nullptr;
+        slideGpuTimer = nullptr;
+        slideGpuTimerReduced = false;
+
+        compositeTexrender = nullptr;
+        compositeFrameTime = 0;
+        renderFrameTime = 0;
+        frameRenderCount = 0;
+        lastFrameRenderCount = 0;
+
+        adaptiveQualityEnabled = false;
+        renderBudgetPercent = 0;
+        lastLaggedFrameCount = obs_get_lagged_frames();
+        lastSkippedFrameCount = video_output_get_skipped_frames(obs_get_video());
+        tickIndex = 0;
+
+        pendingStatistics = {};
+        statisticsWindowStart = HydraCore::GetTimestamp();
+        lastStatistics = {};
+        lifetimeStatistics = {};
+
+        // Perform initial update
+        Update(settings);
+
+        // Jump animation to active monitor
+        animation.JumpToPosition((float)(childPhysicalIndices[activeChild] * width));
+        UpdateLayout();
+
+        // Create the child captures, the monitor we're about to show comes first
+        stopCreation = false;
+        creationThread = std::thread(&ActiveMonitorSource::CreateChildren, this, GetCreationOrder());
+    }
+
+    ~ActiveMonitorSource()
+    {
+        stopCreation = true;
+        creationThread.join();
+
+        tracker->UnsubscribeActiveMonitorChanged(trackerEventSubscription);
+        DestroyCursorTracker();
+
+        LogScalePathGpuTime();
+        blog(LOG_INFO, "[obs-hydra] Statistics over %llu frames:\n%s", (unsigned long long)lifetimeStatistics.FrameCount, lifetimeStatistics.Format().c_str());
+        blog(LOG_INFO, "[obs-hydra] %s", FormatFilterStatistics().c_str());
+        blog(LOG_INFO, "[obs-hydra] %s", FormatLiveDragStatistics().c_str());
+
+        monitorSources.clear();
+
+        delete slideGpuTimer;
+
+        if (compositeTexrender != nullptr || motionTexrender != nullptr || cursorTexture != nullptr)
+        {
+            obs_enter_graphics();
+            gs_texrender_destroy(compositeTexrender);
+            gs_texrender_destroy(motionTexrender);
+            gs_texture_destroy(cursorTexture);
+            obs_leave_graphics();
+        }
+    }
+
+private:
+    // Enabled monitors come before disabled ones, and are ordered by how far they are from the active monitor on the desktop
+    // Monitors the same distance away are ordered by how far they are along the slide (their physical index) since that's the order they're shown in.
+    std::vector<uint32_t> GetCreationOrder()
+    {
+        struct CreationPriority
+        {
+            bool IsDisabled;
+            uint64_t Distance;
+            uint32_t PhysicalDistance;
+            uint32_t Child;
+        };
+
+        // Centers are doubled so they stay integers
+        HydraCore::Rectangle activeRectangle = childMonitors[activeChild].GetRectangle();
+        int64_t activeCenterX = 2 * (int64_t)activeRectangle.Left + activeRectangle.Width;
+        int64_t activeCenterY = 2 * (int64_t)activeRectangle.Top + activeRectangle.Height;
+        int64_t activePhysicalIndex = childPhysicalIndices[activeChild];
+
+        std::vector<CreationPriority> priorities;
+        for (uint32_t i = 0; i < (uint32_t)monitorSources.size(); i++)
+        {
+            HydraCore::Rectangle rectangle = childMonitors[i].GetRectangle();
+            int64_t distanceX = 2 * (int64_t)rectangle.Left + rectangle.Width - activeCenterX;
+            int64_t distanceY = 2 * (int64_t)rectangle.Top + rectangle.Height - activeCenterY;
+
+            CreationPriority priority;
+            priority.IsDisabled = !enabledChildren[i];
+            priority.Distance = (uint64_t)(distanceX * distanceX + distanceY * distanceY);
+            priority.PhysicalDistance = priority.IsDisabled ? 0 : (uint32_t)std::abs((int64_t)childPhysicalIndices[i] - activePhysicalIndex);
+            priority.Child = i;
+            priorities.push_back(priority);
+        }
+
+        std::stable_sort(priorities.begin(), priorities.end(), [](const CreationPriority& a, const CreationPriority& b)
+        {
+            if (a.IsDisabled != b.IsDisabled)
+            { return b.IsDisabled; }
+
+            if (a.Distance != b.Distance)
+            { return a.Distance < b.Distance; }
+
+            return a.PhysicalDistance < b.PhysicalDistance;
+        });
+
+        std::vector<uint32_t> ret;
+        for (CreationPriority& priority : priorities)
+        {
+            ret.push_back(priority.Child);
+        }
+
+        return ret;
+    }
+
+    void CreateChildren(std::vector<uint32_t> creationOrder)
+    {
+        uint64_t startTime = HydraCore::GetTimestamp();
+        size_t createdCount = 0;
+
+        // Children are created one at a time so the most important ones are up as soon as possible
+        for (uint32_t child : creationOrder)
+        {
+            if (stopCreation)
+            { return; }
+
+            std::string description = childMonitors[child].GetDescription();
+            uint64_t creationTime = monitorSources[child].CreateSource(source, description.c_str());
+            blog(LOG_INFO, "[obs-hydra] Created capture of %s in %.1f ms.", description.c_str(), (double)creationTime / 1'000'000.0);
+            createdCount++;
+        }
+
+        blog(LOG_INFO, "[obs-hydra] Created %zu captures for '%s' in %.1f ms.", createdCount, obs_source_get_name(source), (double)(HydraCore::GetTimestamp() - startTime) / 1'000'000.0);
+    }
+
+    HydraCore::Monitor* RestoreLastActiveMonitor(obs_data_t* settings)
+    {
+        if (!obs_data_has_user_value(settings, LAST_ACTIVE_MONITOR_PROPERTY))
+        { return nullptr; }
+
+        // Monitor-specific settings are keyed by the monitor's name, which isn't stable when the topology changes
+        if ((uint64_t)obs_data_get_int(settings, TOPOLOGY_FINGERPRINT_PROPERTY) != topologyFingerprint)
+        {
+            blog(LOG_INFO, "[obs-hydra] The display topology changed since '%s' was saved, per-display settings may apply to different displays.", obs_source_get_name(source));
+        }
+
+        // The interface ID is stable across topology changes, so we can still find the last active monitor if it's still connected
+        std::string lastActiveMonitor = obs_data_get_string(settings, LAST_ACTIVE_MONITOR_PROPERTY);
+        for (HydraCore::Monitor& monitor : childMonitors)
+        {
+            if (monitor.GetInterfaceId() == lastActiveMonitor)
+            {
+                return &monitor;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void Save(obs_data_t* settings)
+    {
+        obs_data_set_int(settings, TOPOLOGY_FINGERPRINT_PROPERTY, (long long)topologyFingerprint);
+        obs_data_set_string(settings, LAST_ACTIVE_MONITOR_PROPERTY, childMonitors[activeChild].GetInterfaceId().c_str());
+    }
+
+    void CreateCursorTracker(uint32_t sampleRate, uint32_t deadZone)
+    {
+        cursorTracker = new HydraCore::CursorMonitorTracker(HydraCore::DisplayPlatform::GetCurrent(), sampleRate, deadZone);
+        cursorTrackerEventSubscription = cursorTracker->SubscribeCursorMonitorChangedDeferred(&activeMonitorChangedEvent, TRACKER_KEY_CURSOR);
+
+        // The policy needs to know where the cursor starts, this goes through the deferred event since the policy belongs to the video thread
+        activeMonitorChangedEvent.Dispatch(TRACKER_KEY_CURSOR, { cursorTracker->GetInitialMonitorHandle(), HydraCore::GetTimestamp() });
+    }
+
+    void DestroyCursorTracker()
+    {
+        if (cursorTracker == nullptr)
+        {
+            return;
+        }
+
+        cursorTracker->UnsubscribeCursorMonitorChanged(cursorTrackerEventSubscription);
+
+        HydraCore::CursorSamplingStatistics statistics = cursorTracker->GetStatistics();
+        blog(LOG_INFO, "[obs-hydra] Cursor sampling: %.2f us CPU time per second (%llu samples, %.2f us per sample)", statistics.GetMicrosecondsPerSecond(), (unsigned long long)statistics.SampleCount, statistics.GetMicrosecondsPerSample());
+
+        delete cursorTracker;
+        cursorTracker = nullptr;
+    }
+
+    static bool TrackingModePropertyModified(obs_properties_t* properties, obs_property_t* property, obs_data_t* settings)
+    {
+        HydraCore::MonitorTrackingMode trackingMode = (HydraCore::MonitorTrackingMode)obs_data_get_int(settings, TRACKING_MODE_PROPERTY);
+        bool usesCursor = trackingMode != HydraCore::MONITOR_TRACKING_MODE_FOCUS;
+        obs_property_set_enabled(obs_properties_get(properties, CURSOR_SAMPLE_RATE_PROPERTY), usesCursor);
+        obs_property_set_enabled(obs_properties_get(properties, CURSOR_DEAD_ZONE_PROPERTY), usesCursor);
+        obs_property_set_enabled(obs_properties_get(properties, CURSOR_DWELL_TIME_PROPERTY), trackingMode == HydraCore::MONITOR_TRACKING_MODE_CURSOR_AFTER_DWELL);
+        return true;
+    }
+
+    void PublishStatistics(uint64_t frameTime)
+    {
+        if (frameTime - statisticsWindowStart < StatisticsWindow)
+        { return; }
+
+        statisticsWindowStart = frameTime;
+
+        for (size_t i = 0; i < monitorSources.size(); i++)
+        {
+            monitorSources[i].TakeStatistics(pendingStatistics, childStates[i], enabledChildren[i] != 0);
+        }
+
+        pendingStatistics.QualityLevel = frameBudget.GetLevel();
+        pendingStatistics.EstimatedTextureMemory += overviewAtlas.GetTextureMemory();
+
+        {
+            std::lock_guard<std::mutex> lock(statisticsMutex);
+            lastStatistics = pendingStatistics;
+            lifetimeStatistics.Accumulate(pendingStatistics);
+        }
+
+        UpdateFrameBudget(pendingStatistics);
+        pendingStatistics = {};
+    }
+
+    void UpdateFrameBudget(SourceStatistics& statistics)
+    {
+        // The counters are always followed so frames dropped before adaptive quality was turned on aren't blamed on the first window
+        video_t* video = obs_get_video();
+        uint32_t laggedFrameCount = obs_get_lagged_frames();
+        uint32_t skippedFrameCount = video_output_get_skipped_frames(video);
+
+        HydraCore::FrameBudgetSample sample;
+        sample.FrameCount = statistics.FrameCount;
+        sample.RenderMilliseconds = statistics.GetCpuMillisecondsPerFrame() + (statistics.ChildGpuTime.SampleCount > 0 ? statistics.GetGpuMillisecondsPerFrame() : 0.0);
+        sample.FrameMilliseconds = (double)video_output_get_frame_time(video) / 1'000'000.0;
+        sample.LaggedFrameCount = laggedFrameCount - lastLaggedFrameCount;
+        sample.SkippedFrameCount = skippedFrameCount - lastSkippedFrameCount;
+        lastLaggedFrameCount = laggedFrameCount;
+        lastSkippedFrameCount = skippedFrameCount;
+
+        // Frames dropped while we aren't being shown have nothing to do with us
+        if (!adaptiveQualityEnabled || !obs_source_showing(source))
+        { return; }
+
+        HydraCore::FrameBudgetSettings settings = HydraCore::GetDefaultFrameBudgetSettings();
+        settings.BudgetFraction = (double)renderBudgetPercent / 100.0;
+        frameBudget.SetSettings(settings);
+
+        HydraCore::FrameBudgetDecision decision = frameBudget.Update(sample);
+        if (decision != HydraCore::FRAME_BUDGET_HOLD)
+        {
+            LogQualityLevel(decision == HydraCore::FRAME_BUDGET_LOWER ? "Lowered" : "Raised", frameBudget.GetReason());
+        }
+    }
+
+    void LogQualityLevel(const char* change, const char* reason)
+    {
+        const HydraCore::FrameBudgetLevel& level = frameBudget.GetCurrentLevel();
+        char neighbors[64];
+        if (level.WarmNeighborCount == HydraCore::UnlimitedWarmNeighbors)
+        {
+            snprintf(neighbors, sizeof(neighbors), "every capture kept running");
+        }
+        else
+        {
+            snprintf(neighbors, sizeof(neighbors), "%u off-screen captures kept running", level.WarmNeighborCount);
+        }
+
+        blog
+        (
+            LOG_INFO, "[obs-hydra] %s the quality of '%s' to level %u of %u (overview tiles redrawn every %u frames, %s): %s.",
+            change, obs_source_get_name(source), frameBudget.GetLevel(), HydraCore::FrameBudgetLevelCount - 1, level.TileRefreshDivisor, neighbors, reason
+        );
+    }
+
+    void LogSlideReport(const HydraCore::SlideReport& report)
     {
-        activeMonitorHandle = tracker->GetActiveMonitorHandle();
+        pendingStatistics.SlideGpuSavedMilliseconds += report.SavedMilliseconds;
 
-        // It is intentional that activeMonitor is not changed in the event the handle is not found in the sources collection
-        // This makes it so the last known visible monitor is the one that is visible.
-        for (MonitorSource* monitorSource : monitorSources)
+        // Without GPU timing there's nothing worth reporting for a single slide
+        if (!measureSlideGpuTime)
+        { return; }
+
+        if (!report.WasReduced)
         {
-            if (monitorSource->GetMonitorHandle() == activeMonitorHandle && monitorSource->IsEnabled())
-            {
-                activeMonitor = monitorSource;
-            }
+            blog(LOG_INFO, "[obs-hydra] A slide on '%s' was drawn at full resolution for %llu frames, slides take %.3f ms/frame of GPU time at full resolution.", obs_source_get_name(source), (unsigned long long)report.FrameCount, report.FullMillisecondsPerFrame);
         }
-
-        if (animationEnabled)
+        else if (report.FullMillisecondsPerFrame > 0.0 && report.ReducedMillisecondsPerFrame > 0.0)
         {
-            animation.SetTargetPosition((float)(activeMonitor->GetPhysicalIndex() * width));
+            blog
+            (
+                LOG_INFO, "[obs-hydra] A slide on '%s' was drawn at %u%% resolution for %llu frames, saving about %.2f ms of GPU time (%.3f ms/frame against %.3f ms/frame at full resolution).",
+                obs_source_get_name(source), (uint32_t)motionScalePercent, (unsigned long long)report.FrameCount, report.SavedMilliseconds, report.ReducedMillisecondsPerFrame, report.FullMillisecondsPerFrame
+            );
+        }
+        else
+        {
+            blog(LOG_INFO, "[obs-hydra] A slide on '%s' was drawn at %u%% resolution for %llu frames, the GPU time it saved isn't known until slides have been timed at both resolutions.", obs_source_get_name(source), (uint32_t)motionScalePercent, (unsigned long long)report.FrameCount);
         }
     }
 
-public:
-    ActiveMonitorSource(obs_data_t* settings, obs_source_t* source)
+    SourceStatistics GetLastStatistics()
     {
-        this->source = source;
+        std::lock_guard<std::mutex> lock(statisticsMutex);
+        return lastStatistics;
+    }
 
-        // Initialize active monitor tracker
-        tracker = HydraCore::ActiveMonitorTracker::GetInstance();
-        trackerEventSubscription = tracker->SubscribeActiveMonitorChanged(this, &ActiveMonitorSource::ActiveMonitorChanged);
+    // The filter belongs to the shared tracker, so these cover every Hydra source
+    std::string FormatFilterStatistics()
+    {
+        HydraCore::WindowFilterStatistics statistics = tracker->GetFilterStatistics();
+        char ret[256];
+        snprintf
+        (
+            ret, sizeof(ret),
+            "Window filter: %llu focus events, %llu ignored, %.1f%% cache hits, %.2f us per event",
+            (unsigned long long)statistics.EventCount, (unsigned long long)statistics.IgnoredCount, statistics.GetCacheHitRate() * 100.0, statistics.GetNanosecondsPerEvent() / 1'000.0
+        );
+        return ret;
+    }
 
-        // Create all monitor sources that we might need
-        // Instead of dnymaically creating/destroying them, we just create them all at once.
-        // OBS does not seem to properly handle the monitor set changing anyway
-        // Additionally, not creating sources ahead of time causes some weird behavior in the preview window.
-        // I suspect this is because OBS does not reenumerate our child sources when we are in preview mode, but I did not investigate very far.
-        showCursor = obs_data_get_bool(settings, SHOW_CURSOR_PROPERTY);
+    std::string FormatLiveDragStatistics()
+    {
+        HydraCore::LiveDragStatistics statistics = tracker->GetLiveDragStatistics();
+        char ret[256];
+        snprintf
+        (
+            ret, sizeof(ret),
+            "Live dragging: %llu drags, %llu location events (%llu sampled), %.2f us CPU time per drag, %.2f us per event",
+            (unsigned long long)statistics.DragCount, (unsigned long long)statistics.EventCount, (unsigned long long)statistics.SampleCount,
+            statistics.GetMicrosecondsPerDrag(), statistics.GetNanosecondsPerEvent() / 1'000.0
+        );
+        return ret;
+    }
 
-        for (HydraCore::Monitor& monitor : HydraCore::Monitor::GetAllMonitors(true))
-        {
-            monitorSources.push_back(new MonitorSource(monitor, showCursor));
-        }
+    std::string FormatStatistics()
+    {
+        return GetLastStatistics().Format() + "\n" + FormatFilterStatistics() + "\n" + FormatLiveDragStatistics();
+    }
 
-        activeMonitor = monitorSources[0];
+    static bool RefreshStatisticsClicked(obs_properties_t* properties, obs_property_t* property, void* data)
+    {
+        ActiveMonitorSource* _this = (ActiveMonitorSource*)data;
+        SourceStatistics statistics = _this->GetLastStatistics();
+        std::string text = _this->FormatStatistics();
+        obs_property_set_description(obs_properties_get(properties, STATISTICS_PROPERTY), text.c_str());
+        blog(LOG_INFO, "[obs-hydra] Statistics over the last %llu frames:\n%s", (unsigned long long)statistics.FrameCount, text.c_str());
+        return true;
+    }
 
-        // Get solid effect for overview mode
-        solidEffect = obs_get_base_effect(OBS_EFFECT_SOLID);
-        solidEffectColor = gs_effect_get_param_by_name(solidEffect, "color");
-        solidEffectTechnique = gs_effect_get_technique(solidEffect, "Solid");
+    void LogScalePathGpuTime()
+    {
+        for (int i = 0; i < HydraCore::SCALE_PATH_COUNT; i++)
+        {
+            HydraCore::ScalePath path = (HydraCore::ScalePath)i;
+            GpuTimeStatistics total = {};
 
-        // Perform initial update
-        Update(settings);
+            for (MonitorSource& monitorSource : monitorSources)
+            {
+                GpuTimeStatistics& statistics = monitorSource.GetScalePathGpuTime(path);
+                total.SampleCount += statistics.SampleCount;
+                total.TotalMilliseconds += statistics.TotalMilliseconds;
+            }
 
-        // Jump animation to active monitor
-        animation.JumpToPosition((float)(activeMonitor->GetPhysicalIndex() * width));
+            if (total.SampleCount > 0)
+            {
+                blog(LOG_INFO, "[obs-hydra] %s scale path: %.3f ms GPU time on average over %llu draws", HydraCore::GetScalePathName(path), total.GetAverageMilliseconds(), (unsigned long long)total.SampleCount);
+            }
+        }
     }
 
-    ~ActiveMonitorSource()
+    static bool MotionQualityPropertyModified(obs_properties_t* properties, obs_property_t* property, obs_data_t* settings)
     {
-        tracker->UnsubscribeActiveMonitorChanged(trackerEventSubscription);
+        obs_property_set_enabled(obs_properties_get(properties, MOTION_SCALE_PROPERTY), obs_data_get_bool(settings, MOTION_QUALITY_PROPERTY));
+        return true;
+    }
 
-        for (MonitorSource* monitorSource : monitorSources)
-        {
-            delete monitorSource;
-        }
+    static bool AdaptiveQualityPropertyModified(obs_properties_t* properties, obs_property_t* property, obs_data_t* settings)
+    {
+        obs_property_set_enabled(obs_properties_get(properties, RENDER_BUDGET_PROPERTY), obs_data_get_bool(settings, ADAPTIVE_QUALITY_PROPERTY));
+        return true;
     }
 
-private:
     static bool UsePrimaryForSizePropertyModified(obs_properties_t* properties, obs_property_t* property, obs_data_t* settings)
     {
         bool enableSizeProperties = !obs_data_get_bool(settings, USE_PRIMARY_FOR_SIZE_PROPERTY);
@@ -262,13 +1280,40 @@ private:
         obs_properties_add_int(ret, WIDTH_PROPERTY, "Width", 1, 4096, 1);
         obs_properties_add_int(ret, HEIGHT_PROPERTY, "Height", 1, 4096, 1);
 
+        obs_property_t* scaleMode = obs_properties_add_list(ret, SCALE_MODE_PROPERTY, "Scale Mode", OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+        obs_property_list_add_int(scaleMode, "Stretch", HydraCore::SCALE_MODE_STRETCH);
+        obs_property_list_add_int(scaleMode, "Fit (Letterbox)", HydraCore::SCALE_MODE_FIT);
+        obs_property_list_add_int(scaleMode, "Fill", HydraCore::SCALE_MODE_FILL);
+
         // Monitor selectors
         std::vector<HydraCore::Monitor> monitors = HydraCore::Monitor::GetAllMonitors(true);
         for (HydraCore::Monitor& monitor : monitors)
         {
-            obs_properties_add_bool(ret, monitor.GetName().c_str(), monitor.GetDescription().c_str());
+            std::string name = monitor.GetName();
+            obs_properties_add_bool(ret, name.c_str(), monitor.GetDescription().c_str());
+            obs_properties_add_int(ret, (name + MONITOR_CROP_LEFT_PROPERTY_SUFFIX).c_str(), "Crop Left", 0, 16384, 1);
+            obs_properties_add_int(ret, (name + MONITOR_CROP_TOP_PROPERTY_SUFFIX).c_str(), "Crop Top", 0, 16384, 1);
+            obs_properties_add_int(ret, (name + MONITOR_CROP_RIGHT_PROPERTY_SUFFIX).c_str(), "Crop Right", 0, 16384, 1);
+            obs_properties_add_int(ret, (name + MONITOR_CROP_BOTTOM_PROPERTY_SUFFIX).c_str(), "Crop Bottom", 0, 16384, 1);
         }
 
+        // Tracking
+        obs_property_t* trackingMode = obs_properties_add_list(ret, TRACKING_MODE_PROPERTY, "Follow", OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+        obs_property_list_add_int(trackingMode, "Focused Window", HydraCore::MONITOR_TRACKING_MODE_FOCUS);
+        obs_property_list_add_int(trackingMode, "Cursor", HydraCore::MONITOR_TRACKING_MODE_CURSOR);
+        obs_property_list_add_int(trackingMode, "Focused Window (Cursor wins after a delay)", HydraCore::MONITOR_TRACKING_MODE_CURSOR_AFTER_DWELL);
+        obs_property_set_modified_callback(trackingMode, TrackingModePropertyModified);
+
+        obs_properties_add_int(ret, CURSOR_SAMPLE_RATE_PROPERTY, "Cursor Sample Rate (Hz)", 1, 240, 1);
+        obs_properties_add_int(ret, CURSOR_DEAD_ZONE_PROPERTY, "Cursor Edge Dead Zone (px)", 0, 1'000, 1);
+        obs_properties_add_int(ret, CURSOR_DWELL_TIME_PROPERTY, "Cursor Delay (ms)", 0, 10'000, 50);
+
+        // These apply to every Hydra source since they share the focus tracker
+        obs_properties_add_editable_list(ret, IGNORED_EXECUTABLES_PROPERTY, "Ignore Focus From Programs (IE: obs64.exe)", OBS_EDITABLE_LIST_TYPE_STRINGS, nullptr, nullptr);
+        obs_properties_add_editable_list(ret, IGNORED_WINDOW_CLASSES_PROPERTY, "Ignore Focus From Window Classes", OBS_EDITABLE_LIST_TYPE_STRINGS, nullptr, nullptr);
+        obs_properties_add_bool(ret, LIVE_DRAG_ENABLED_PROPERTY, "Follow Windows While Dragging");
+        obs_properties_add_int(ret, LIVE_DRAG_RATE_PROPERTY, "Window Drag Sample Rate (Hz)", 1, 240, 1);
+
         // Overview mode
         obs_properties_add_bool(ret, OVERVIEW_MODE_PROPERTY, "Overview Mode");
         obs_properties_add_bool(ret, OVERVIEW_OUTLINE_ENABLED_PROPERTY, "Overview Outline");
@@ -278,6 +1323,19 @@ private:
         // Animation
         obs_properties_add_bool(ret, ANIMATION_ENABLED_PROPERTY, "Enable Animation");
         obs_properties_add_float_slider(ret, ANIMATION_SPEED_PROPERTY, "Animation Speed", 0.0, 100'000.0, 1.0);
+        obs_property_t* motionQuality = obs_properties_add_bool(ret, MOTION_QUALITY_PROPERTY, "Reduce Resolution During Slides (Motion hides the detail)");
+        obs_property_set_modified_callback(motionQuality, MotionQualityPropertyModified);
+        obs_properties_add_int_slider(ret, MOTION_SCALE_PROPERTY, "Slide Resolution (%)", 25, 100, 5);
+
+        // Performance
+        obs_property_t* adaptiveQuality = obs_properties_add_bool(ret, ADAPTIVE_QUALITY_PROPERTY, "Adaptive Quality (Redraw overview less often and stop off-screen captures when over budget)");
+        obs_property_set_modified_callback(adaptiveQuality, AdaptiveQualityPropertyModified);
+        obs_properties_add_int_slider(ret, RENDER_BUDGET_PROPERTY, "Render Budget (% of frame time)", 1, 100, 1);
+
+        // Diagnostics
+        obs_properties_add_bool(ret, MEASURE_GPU_TIME_PROPERTY, "Measure GPU Time (Logged when the source is destroyed)");
+        obs_properties_add_text(ret, STATISTICS_PROPERTY, FormatStatistics().c_str(), OBS_TEXT_INFO);
+        obs_properties_add_button(ret, REFRESH_STATISTICS_PROPERTY, "Refresh Statistics", RefreshStatisticsClicked);
 
         return ret;
     }
@@ -292,12 +1350,25 @@ private:
 
         obs_data_set_default_int(settings, WIDTH_PROPERTY, primaryMonitor.GetWidth());
         obs_data_set_default_int(settings, HEIGHT_PROPERTY, primaryMonitor.GetHeight());
+        obs_data_set_default_int(settings, SCALE_MODE_PROPERTY, HydraCore::SCALE_MODE_STRETCH);
 
         for (HydraCore::Monitor& monitor : monitors)
         {
-            obs_data_set_default_bool(settings, monitor.GetName().c_str(), true);
+            std::string name = monitor.GetName();
+            obs_data_set_default_bool(settings, name.c_str(), true);
+            obs_data_set_default_int(settings, (name + MONITOR_CROP_LEFT_PROPERTY_SUFFIX).c_str(), 0);
+            obs_data_set_default_int(settings, (name + MONITOR_CROP_TOP_PROPERTY_SUFFIX).c_str(), 0);
+            obs_data_set_default_int(settings, (name + MONITOR_CROP_RIGHT_PROPERTY_SUFFIX).c_str(), 0);
+            obs_data_set_default_int(settings, (name + MONITOR_CROP_BOTTOM_PROPERTY_SUFFIX).c_str(), 0);
         }
 
+        obs_data_set_default_int(settings, TRACKING_MODE_PROPERTY, HydraCore::MONITOR_TRACKING_MODE_FOCUS);
+        obs_data_set_default_int(settings, CURSOR_SAMPLE_RATE_PROPERTY, 30);
+        obs_data_set_default_int(settings, CURSOR_DEAD_ZONE_PROPERTY, 16);
+        obs_data_set_default_int(settings, CURSOR_DWELL_TIME_PROPERTY, 500);
+        obs_data_set_default_bool(settings, LIVE_DRAG_ENABLED_PROPERTY, false);
+        obs_data_set_default_int(settings, LIVE_DRAG_RATE_PROPERTY, 20);
+
         obs_data_set_default_bool(settings, OVERVIEW_MODE_PROPERTY, false);
         obs_data_set_default_bool(settings, OVERVIEW_OUTLINE_ENABLED_PROPERTY, true);
         obs_data_set_default_int(settings, OVERVIEW_OUTLINE_THICKNESS_PROPERTY, 10);
@@ -305,26 +1376,25 @@ private:
 
         obs_data_set_default_bool(settings, ANIMATION_ENABLED_PROPERTY, true);
         obs_data_set_default_double(settings, ANIMATION_SPEED_PROPERTY, 1920.0 * 4.0);
+        obs_data_set_default_bool(settings, MOTION_QUALITY_PROPERTY, false);
+        obs_data_set_default_int(settings, MOTION_SCALE_PROPERTY, 50);
+
+        obs_data_set_default_bool(settings, ADAPTIVE_QUALITY_PROPERTY, false);
+        obs_data_set_default_int(settings, RENDER_BUDGET_PROPERTY, 25);
+
+        obs_data_set_default_bool(settings, MEASURE_GPU_TIME_PROPERTY, false);
     }
 
     void Update(obs_data_t* settings)
     {
-        // Update showCursor
-        bool newShowCursor = obs_data_get_bool(settings, SHOW_CURSOR_PROPERTY);
-        if (newShowCursor != showCursor)
-        {
-            showCursor = newShowCursor;
-
-            for (MonitorSource* monitorSource : monitorSources)
-            {
-                monitorSource->SetShowCursor(showCursor);
-            }
-        }
+        // Update showCursor, this only changes what we draw so the children are left alone
+        showCursor = obs_data_get_bool(settings, SHOW_CURSOR_PROPERTY);
 
         // Get the size
         if (obs_data_get_bool(settings, USE_PRIMARY_FOR_SIZE_PROPERTY))
         {
-            HydraCore::Monitor primaryMonitor = HydraCore::Monitor::GetPrimaryMonitor();
+            // The monitors enumerated when we were created are used rather than enumerating them again
+            HydraCore::Monitor primaryMonitor = HydraCore::Monitor::GetPrimaryMonitor(childMonitors);
             width = primaryMonitor.GetWidth();
             height = primaryMonitor.GetHeight();
         }
@@ -334,23 +1404,67 @@ private:
             height = (uint32_t)obs_data_get_int(settings, HEIGHT_PROPERTY);
         }
 
-        // Update which monitors are enabled
-        activeMonitorCount = 0;
-        for (MonitorSource* monitorSource : monitorSources)
+        scaleMode = (HydraCore::ScaleMode)obs_data_get_int(settings, SCALE_MODE_PROPERTY);
+
+        // Update which monitors are enabled, this rebuilds the hot arrays
+        enabledChildren.assign(childStates.size(), false);
+        childPhysicalIndices.assign(childStates.size(), 0);
+        enabledChildIndices.clear();
+        for (size_t i = 0; i < childStates.size(); i++)
         {
-            bool isEnabled = obs_data_get_bool(settings, monitorSource->GetMonitorName().c_str());
-            monitorSource->SetIsEnabled(isEnabled);
+            ChildState& state = childStates[i];
+            std::string name = childMonitors[i].GetName();
+            bool isEnabled = obs_data_get_bool(settings, name.c_str());
+            enabledChildren[i] = isEnabled;
+
+            HydraCore::Margins crop;
+            crop.Left = (uint32_t)obs_data_get_int(settings, (name + MONITOR_CROP_LEFT_PROPERTY_SUFFIX).c_str());
+            crop.Top = (uint32_t)obs_data_get_int(settings, (name + MONITOR_CROP_TOP_PROPERTY_SUFFIX).c_str());
+            crop.Right = (uint32_t)obs_data_get_int(settings, (name + MONITOR_CROP_RIGHT_PROPERTY_SUFFIX).c_str());
+            crop.Bottom = (uint32_t)obs_data_get_int(settings, (name + MONITOR_CROP_BOTTOM_PROPERTY_SUFFIX).c_str());
+            if (memcmp(&state.Crop, &crop, sizeof(crop)) != 0)
+            {
+                state.Crop = crop;
+                state.IsTransformDirty = true;
+            }
 
             if (isEnabled)
             {
-                monitorSource->SetPhysicalIndex(activeMonitorCount);
-                activeMonitorCount++;
+                childPhysicalIndices[i] = (uint32_t)enabledChildIndices.size();
+                enabledChildIndices.push_back((uint32_t)i);
             }
         }
 
         // Pretend that the active monitor changed in case the active monitor just became enabled
         // (Note that we don't bother changing off of the current monitor if it became disabled.)
-        ActiveMonitorChanged();
+        ActiveMonitorChanged(activeMonitorHandle, HydraCore::GetTimestamp());
+
+        // Update tracking, the cursor is only sampled when a mode which needs it is selected
+        trackingMode = (HydraCore::MonitorTrackingMode)obs_data_get_int(settings, TRACKING_MODE_PROPERTY);
+        cursorDwellTime = (uint64_t)obs_data_get_int(settings, CURSOR_DWELL_TIME_PROPERTY) * 1'000'000;
+        uint32_t cursorSampleRate = (uint32_t)obs_data_get_int(settings, CURSOR_SAMPLE_RATE_PROPERTY);
+        uint32_t cursorDeadZone = (uint32_t)obs_data_get_int(settings, CURSOR_DEAD_ZONE_PROPERTY);
+
+        tracker->SetIgnoredWindows(GetStringList(settings, IGNORED_EXECUTABLES_PROPERTY), GetStringList(settings, IGNORED_WINDOW_CLASSES_PROPERTY));
+
+        // Like the filter this is shared by every Hydra source, so the most recently updated one wins
+        uint64_t liveDragRate = (uint64_t)obs_data_get_int(settings, LIVE_DRAG_RATE_PROPERTY);
+        bool liveDragEnabled = obs_data_get_bool(settings, LIVE_DRAG_ENABLED_PROPERTY) && liveDragRate > 0;
+        tracker->SetLiveDragInterval(liveDragEnabled ? 1'000'000'000 / liveDragRate : 0);
+
+        if (trackingMode == HydraCore::MONITOR_TRACKING_MODE_FOCUS)
+        {
+            DestroyCursorTracker();
+        }
+        else if (cursorTracker == nullptr)
+        {
+            CreateCursorTracker(cursorSampleRate, cursorDeadZone);
+        }
+        else
+        {
+            cursorTracker->SetSampleRate(cursorSampleRate);
+            cursorTracker->SetDeadZone(cursorDeadZone);
+        }
 
         // Update overview mode
         overviewMode = obs_data_get_bool(settings, OVERVIEW_MODE_PROPERTY);
@@ -358,16 +1472,40 @@ private:
         overviewOutlineThickness = (int)obs_data_get_int(settings, OVERVIEW_OUTLINE_THICKNESS_PROPERTY);
         vec4_from_rgba(&overviewOutlineColor, (uint32_t)obs_data_get_int(settings, OVERVIEW_OUTLINE_COLOR_PROPERTY));
 
+        layoutSettings.Width = width;
+        layoutSettings.Height = height;
+        layoutSettings.OverviewMode = overviewMode;
+        layoutSettings.OutlineEnabled = overviewOutlineEnabled;
+        layoutSettings.OutlineThickness = (uint32_t)overviewOutlineThickness;
+
         // Update animation
         animationEnabled = obs_data_get_bool(settings, ANIMATION_ENABLED_PROPERTY);
         animation.SetVelocity((float)obs_data_get_double(settings, ANIMATION_SPEED_PROPERTY));
+
+        // Update adaptive quality, the governor itself is only touched from the graphics thread
+        adaptiveQualityEnabled = obs_data_get_bool(settings, ADAPTIVE_QUALITY_PROPERTY);
+        renderBudgetPercent = (uint32_t)obs_data_get_int(settings, RENDER_BUDGET_PROPERTY);
+
+        // Update motion quality, the texture and the timer are only touched from the graphics thread
+        motionQualityEnabled = obs_data_get_bool(settings, MOTION_QUALITY_PROPERTY);
+        motionScalePercent = (uint32_t)obs_data_get_int(settings, MOTION_SCALE_PROPERTY);
+
+        // Update diagnostics
+        bool measureGpuTime = obs_data_get_bool(settings, MEASURE_GPU_TIME_PROPERTY);
+        measureSlideGpuTime = measureGpuTime;
+        for (MonitorSource& monitorSource : monitorSources)
+        {
+            monitorSource.SetMeasureGpuTime(measureGpuTime);
+        }
+
+        settingsVersion++;
     }
 
     uint32_t GetWidth()
     {
         if (overviewMode)
         {
-            return width * activeMonitorCount;
+            return width * (uint32_t)enabledChildIndices.size();
         }
 
         return width;
@@ -378,119 +1516,486 @@ private:
         return height;
     }
 
-    void RenderSourceNormalized(obs_source_t* source)
+    // Replays the composite's recorded draws, returns how many draws were issued
+    uint32_t RenderTiles()
     {
-        gs_matrix_push();
+        uint32_t drawCount = 0;
+        uint32_t refreshDivisor = renderCommands.GetInputs().TileRefreshDivisor;
 
-        float sourceWidth = (float)obs_source_get_width(source);
-        float sourceHeight = (float)obs_source_get_height(source);
+        for (const HydraCore::RenderCommand& command : renderCommands.GetCommands())
+        {
+            switch (command.Type)
+            {
+                case HydraCore::RENDER_COMMAND_DRAW_TILE:
+                case HydraCore::RENDER_COMMAND_DRAW_THROTTLED_TILE:
+                {
+                    MonitorSource& monitorSource = monitorSources[command.Child];
+                    const ChildState& state = childStates[command.Child];
+                    gs_matrix_push();
+                    gs_matrix_translate3f(command.X, command.Y, 0.f);
+
+                    if (command.Type == HydraCore::RENDER_COMMAND_DRAW_THROTTLED_TILE)
+                    {
+                        monitorSource.RenderThrottled(state, HydraCore::IsTileRefreshFrame(tickIndex, command.Child, refreshDivisor));
+                    }
+                    else
+                    {
+                        monitorSource.ReleaseThrottledTile();
+                        monitorSource.Render(state);
+                    }
+
+                    gs_matrix_pop();
+                    drawCount++;
+                    break;
+                }
+                case HydraCore::RENDER_COMMAND_BEGIN_SOLID:
+                {
+                    vec4 color;
+                    vec4_set(&color, command.Color[0], command.Color[1], command.Color[2], command.Color[3]);
+                    gs_effect_set_vec4(solidEffectColor, &color);
+                    gs_technique_begin(solidEffectTechnique);
+                    gs_technique_begin_pass(solidEffectTechnique, 0);
+                    break;
+                }
+                case HydraCore::RENDER_COMMAND_DRAW_SOLID:
+                    gs_matrix_push();
+                    gs_matrix_translate3f(command.X, command.Y, 0.f);
+                    gs_draw_sprite(nullptr, 0, command.Width, command.Height);
+                    gs_matrix_pop();
+                    drawCount++;
+                    break;
+                case HydraCore::RENDER_COMMAND_END_SOLID:
+                    gs_technique_end_pass(solidEffectTechnique);
+                    gs_technique_end(solidEffectTechnique);
+                    break;
+            }
+        }
 
-        gs_matrix_scale3f((float)width / sourceWidth, (float)height / sourceHeight, 1.f);
+        return drawCount;
+    }
 
-        obs_source_video_render(source);
+    // True if rendering the child writes every pixel of its tile, in which case its atlas slot doesn't have to be cleared first
+    // (The placeholder always fills the tile, and slots are drawn with blending replaced by a copy.)
+    static bool CoversTile(const ChildState& state)
+    {
+        const HydraCore::RenderTransform& transform = state.Transform;
+        if (!transform.IsValid)
+        { return true; }
 
-        gs_matrix_pop();
+        return transform.X <= 0.f && transform.Y <= 0.f && transform.X + transform.Width >= (float)state.TargetWidth && transform.Y + transform.Height >= (float)state.TargetHeight;
     }
 
-    void RenderSourceNormalized(MonitorSource* source)
+    // Copies the tiles which are due to be redrawn into the atlas, returns false if the atlas can't be used
+    // slotDrawCount is set to the number of tiles drawn into the atlas.
+    bool UpdateOverviewAtlas(uint32_t& slotDrawCount)
     {
-        RenderSourceNormalized(source->GetSource());
+        slotDrawCount = 0;
+        if (!overviewAtlas.Prepare((uint32_t)enabledChildIndices.size(), width, height))
+        { return false; }
+
+        // The quads are built before any tile is drawn, so a failure here doesn't leave the tiles to be drawn a second time by RenderTiles
+        overviewAtlas.SetOutlineColor(overviewOutlineColor);
+        overviewAtlas.UpdateQuads(compositeLayout, childPhysicalIndices);
+        if (!overviewAtlas.IsDrawable())
+        { return false; }
+
+        // The atlas keeps every tile's last drawing, so only the tiles the recorded draws refresh this frame (and empty slots) are redrawn
+        uint64_t frameTime = obs_get_video_frame_time();
+        if (atlasFrameTime != frameTime)
+        {
+            atlasFrameTime = frameTime;
+            uint32_t refreshDivisor = renderCommands.GetInputs().TileRefreshDivisor;
+
+            for (const HydraCore::RenderCommand& command : renderCommands.GetCommands())
+            {
+                if (command.Type != HydraCore::RENDER_COMMAND_DRAW_TILE && command.Type != HydraCore::RENDER_COMMAND_DRAW_THROTTLED_TILE)
+                { continue; }
+
+                uint32_t slot = childPhysicalIndices[command.Child];
+                bool refresh = command.Type == HydraCore::RENDER_COMMAND_DRAW_TILE || HydraCore::IsTileRefreshFrame(tickIndex, command.Child, refreshDivisor);
+
+                if (!refresh && overviewAtlas.IsSlotFilled(slot))
+                {
+                    pendingStatistics.SkippedTileRefreshCount++;
+                }
+                else if (overviewAtlas.BeginSlot(slot, !CoversTile(childStates[command.Child])))
+                {
+                    MonitorSource& monitorSource = monitorSources[command.Child];
+                    monitorSource.ReleaseThrottledTile();
+                    monitorSource.Render(childStates[command.Child]);
+                    overviewAtlas.EndSlot();
+                    slotDrawCount++;
+                }
+            }
+        }
+
+        return true;
     }
 
     void RenderOverviewMode()
     {
-        gs_matrix_push();
+        profile_start(RenderOverviewModeProfilerName);
+
+        uint32_t slotDrawCount;
+        if (UpdateOverviewAtlas(slotDrawCount) && overviewAtlas.Draw())
+        {
+            pendingStatistics.OverviewDrawCount += slotDrawCount + 1;
+            profile_end(RenderOverviewModeProfilerName);
+            return;
+        }
+
+        // The atlas couldn't be created (IE: it would be larger than the GPU supports), so the tiles and the outline are drawn directly
+        // The failed atlas is kept as is so creating it isn't retried every frame.
+        pendingStatistics.OverviewDrawCount += RenderTiles();
+
+        profile_end(RenderOverviewModeProfilerName);
+    }
+
+    // Draws the tiles into a texture at a fraction of the resolution and scales it back up, returns false if the texture couldn't be drawn
+    bool RenderTilesReduced()
+    {
+        if (motionTexrender == nullptr)
+        {
+            motionTexrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+        }
+
+        uint32_t reducedWidth = std::max(width * motionScalePercent / 100, 1u);
+        uint32_t reducedHeight = std::max(height * motionScalePercent / 100, 1u);
+
+        gs_texrender_reset(motionTexrender);
+        if (!gs_texrender_begin(motionTexrender, reducedWidth, reducedHeight))
+        { return false; }
+
+        // The projection stays at full size so the tiles are laid out as usual, the smaller viewport is what lowers the resolution
+        vec4 clearColor;
+        vec4_zero(&clearColor);
+        gs_clear(GS_CLEAR_COLOR, &clearColor, 0.f, 0);
+        gs_ortho(0.f, (float)width, 0.f, (float)height, -100.f, 100.f);
+
+        gs_blend_state_push();
+        gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+        RenderTiles();
+        gs_blend_state_pop();
+
+        gs_texrender_end(motionTexrender);
+
+        gs_texture_t* texture = gs_texrender_get_texture(motionTexrender);
+        if (texture == nullptr)
+        { return false; }
 
-        for (MonitorSource* monitorSource : monitorSources)
+        DrawPremultipliedTexture(texture, width, height);
+        return true;
+    }
+
+    void RenderNormalMode()
+    {
+        profile_start(RenderNormalModeProfilerName);
+        overviewAtlas.Release();
+
+        if (!motionQualityEnabled && motionTexrender != nullptr)
+        {
+            gs_texrender_destroy(motionTexrender);
+            motionTexrender = nullptr;
+        }
+
+        // Slides are timed so that the time saved by drawing them at reduced resolution can be reported
+        bool isSlideTimed = false;
+        if (measureSlideGpuTime != (slideGpuTimer != nullptr))
+        {
+            delete slideGpuTimer;
+            slideGpuTimer = measureSlideGpuTime ? new GpuTimer() : nullptr;
+        }
+
+        if (slideGpuTimer != nullptr)
         {
-            if (!monitorSource->IsEnabled())
+            double milliseconds;
+            if (slideGpuTimer->Poll(&milliseconds))
             {
-                continue;
+                motionQuality.AddSample(slideGpuTimerReduced, milliseconds);
+            }
+
+            if (motionQuality.IsSliding() && slideGpuTimer->Begin())
+            {
+                isSlideTimed = true;
+                slideGpuTimerReduced = motionQuality.IsReduced();
             }
+        }
 
-            RenderSourceNormalized(monitorSource);
+        if (!motionQuality.IsReduced() || !RenderTilesReduced())
+        {
+            RenderTiles();
+        }
 
-            gs_matrix_translate3f((float)width, 0.f, 0.f);
+        if (isSlideTimed)
+        {
+            slideGpuTimer->End();
         }
 
-        gs_matrix_pop();
+        profile_end(RenderNormalModeProfilerName);
+    }
 
-        if (overviewOutlineEnabled)
+    // Draws the cursor over each tile showing its monitor, scaled and cropped like the capture underneath it
+    void RenderCursor()
+    {
+        const HydraCore::CursorShape& shape = cursorOverlay.GetShape();
+        if (!isCursorTextureShapeUploaded || cursorTextureShapeId != shape.Id)
         {
-            gs_matrix_push();
+            gs_texture_destroy(cursorTexture);
+            const uint8_t* pixels = shape.Pixels.data();
+            cursorTexture = gs_texture_create(shape.Width, shape.Height, GS_BGRA, 1, &pixels, 0);
+            cursorTextureShapeId = shape.Id;
+            isCursorTextureShapeUploaded = true;
 
-            gs_matrix_translate3f(animation.GetCurrentPosition(), 0.f, 0.f);
+            if (cursorTexture != nullptr)
+            {
+                pendingStatistics.CursorUploadCount++;
+            }
+        }
+
+        if (cursorTexture == nullptr)
+        { return; }
 
-            gs_effect_set_vec4(solidEffectColor, &overviewOutlineColor);
+        // Cursor images are premultiplied
+        gs_effect_t* defaultEffect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+        bool previousSrgb = gs_framebuffer_srgb_enabled();
+        gs_enable_framebuffer_srgb(true);
+        gs_effect_set_texture_srgb(gs_effect_get_param_by_name(defaultEffect, "image"), cursorTexture);
 
-            gs_technique_begin(solidEffectTechnique);
-            gs_technique_begin_pass(solidEffectTechnique, 0);
+        gs_blend_state_push();
+        gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
 
-            // Top
-            gs_draw_sprite(nullptr, 0, width, overviewOutlineThickness);
+        for (const HydraCore::CompositeTile& tile : compositeLayout.GetTiles())
+        {
+            HydraCore::CursorPlacement placement;
+            if (!HydraCore::PlaceCursor(cursorOverlay.GetState(), shape, childRectangles[tile.Child], childStates[tile.Child].Transform, tile, placement))
+            { continue; }
 
-            // Left
-            gs_draw_sprite(nullptr, 0, overviewOutlineThickness, height);
-            
-            // Right
             gs_matrix_push();
-            gs_matrix_translate3f((float)(width - overviewOutlineThickness), 0.f, 0.f);
-            gs_draw_sprite(nullptr, 0, overviewOutlineThickness, height);
+            gs_matrix_translate3f(placement.X, placement.Y, 0.f);
+            gs_matrix_scale3f(placement.Width / (float)placement.ImageWidth, placement.Height / (float)placement.ImageHeight, 1.f);
+
+            while (gs_effect_loop(defaultEffect, "Draw"))
+            {
+                gs_draw_sprite_subregion(cursorTexture, 0, placement.ImageX, placement.ImageY, placement.ImageWidth, placement.ImageHeight);
+            }
+
             gs_matrix_pop();
+            pendingStatistics.CursorDrawCount++;
+        }
 
-            // Bottom
-            gs_matrix_translate3f(0.f, (float)(height - overviewOutlineThickness), 0.f);
-            gs_draw_sprite(nullptr, 0, width, overviewOutlineThickness);
+        gs_blend_state_pop();
+        gs_enable_framebuffer_srgb(previousSrgb);
+    }
 
-            gs_technique_end_pass(solidEffectTechnique);
-            gs_technique_end(solidEffectTechnique);
+    void RenderComposite()
+    {
+        if (overviewMode)
+        {
+            RenderOverviewMode();
+        }
+        else
+        {
+            RenderNormalMode();
+        }
 
-            gs_matrix_pop();
+        if (showCursor && cursorOverlay.IsVisible())
+        {
+            RenderCursor();
         }
     }
 
-    void RenderNormalMode()
+    // Draws a texture which was cleared to transparent and had the composite copied into it, so it holds premultiplied alpha
+    void DrawPremultipliedTexture(gs_texture_t* texture, uint32_t drawWidth, uint32_t drawHeight)
     {
-        if (!animation.IsAnimating())
+        gs_effect_t* defaultEffect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+        bool previousSrgb = gs_framebuffer_srgb_enabled();
+        gs_enable_framebuffer_srgb(true);
+        gs_effect_set_texture_srgb(gs_effect_get_param_by_name(defaultEffect, "image"), texture);
+
+        gs_blend_state_push();
+        gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+
+        while (gs_effect_loop(defaultEffect, "Draw"))
         {
-            RenderSourceNormalized(activeMonitor);
-            return;
+            gs_draw_sprite(texture, 0, drawWidth, drawHeight);
+        }
+
+        gs_blend_state_pop();
+        gs_enable_framebuffer_srgb(previousSrgb);
+    }
+
+    void RenderCachedComposite(uint64_t frameTime)
+    {
+        if (compositeTexrender == nullptr)
+        {
+            compositeTexrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
         }
-        
-        gs_matrix_push();
 
-        gs_matrix_translate3f(-animation.GetCurrentPosition(), 0.f, 0.f);
+        uint32_t compositeWidth = GetWidth();
+        uint32_t compositeHeight = GetHeight();
 
-        for (MonitorSource* monitorSource : monitorSources)
+        if (compositeFrameTime == frameTime)
+        {
+            pendingStatistics.CompositeCacheHitCount++;
+        }
+        else
         {
-            if (!monitorSource->IsEnabled())
+            pendingStatistics.CompositeCacheMissCount++;
+            compositeFrameTime = frameTime;
+            gs_texrender_reset(compositeTexrender);
+
+            if (gs_texrender_begin(compositeTexrender, compositeWidth, compositeHeight))
             {
-                continue;
-            }
+                vec4 clearColor;
+                vec4_zero(&clearColor);
+                gs_clear(GS_CLEAR_COLOR, &clearColor, 0.f, 0);
+                gs_ortho(0.f, (float)compositeWidth, 0.f, (float)compositeHeight, -100.f, 100.f);
 
-            RenderSourceNormalized(monitorSource);
+                gs_blend_state_push();
+                gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+                RenderComposite();
+                gs_blend_state_pop();
 
-            gs_matrix_translate3f((float)width, 0.f, 0.f);
+                gs_texrender_end(compositeTexrender);
+            }
         }
 
-        gs_matrix_pop();
+        gs_texture_t* texture = gs_texrender_get_texture(compositeTexrender);
+        if (texture == nullptr)
+        { return; }
+
+        DrawPremultipliedTexture(texture, compositeWidth, compositeHeight);
     }
 
     void VideoRender(gs_effect_t* effect)
     {
-        if (overviewMode)
+        profile_start(VideoRenderProfilerName);
+        uint64_t startTime = HydraCore::GetTimestamp();
+
+        uint64_t frameTime = obs_get_video_frame_time();
+        if (frameTime != renderFrameTime)
         {
-            RenderOverviewMode();
+            renderFrameTime = frameTime;
+            lastFrameRenderCount = frameRenderCount;
+            frameRenderCount = 0;
+        }
+        frameRenderCount++;
+
+        if (lastFrameRenderCount > 1)
+        {
+            RenderCachedComposite(frameTime);
         }
         else
         {
-            RenderNormalMode();
+            RenderComposite();
         }
+
+        pendingStatistics.CpuNanoseconds += HydraCore::GetTimestamp() - startTime;
+        profile_end(VideoRenderProfilerName);
     }
 
     void VideoTick(float deltaTime)
     {
-        animation.Update(deltaTime);
+        profile_start(VideoTickProfilerName);
+        uint64_t startTime = HydraCore::GetTimestamp();
+
+        activeMonitorChangedEvent.Drain([this](TrackerKey key, const HydraCore::ActiveMonitorChange& change, uint32_t mergedCount)
+        {
+            if (mergedCount > 1)
+            {
+                blog(LOG_DEBUG, "[obs-hydra] Coalesced %u active monitor changes into one.", mergedCount);
+            }
+
+            if (key == TRACKER_KEY_FOCUS)
+            {
+                trackingPolicy.FocusChanged(change.Monitor, change.Timestamp);
+            }
+            else
+            {
+                trackingPolicy.CursorChanged(change.Monitor, change.Timestamp);
+            }
+        });
+
+        uint64_t frameTime = obs_get_video_frame_time();
+        trackingPolicy.SetMode(trackingMode, cursorDwellTime);
+
+        HydraCore::MonitorHandle newMonitor;
+        uint64_t changeTimestamp;
+        if (trackingPolicy.Update(frameTime, newMonitor, changeTimestamp))
+        {
+            ActiveMonitorChanged(newMonitor, changeTimestamp);
+        }
+
+        // The animation is evaluated at the frame's timestamp rather than stepped by deltaTime so that uneven ticks don't accumulate error
+        animation.UpdateToTime(frameTime);
+
+        // Between focus changes none of these change, so the last frame's layout and draws are replayed as they are
+        HydraCore::RenderCommandInputs renderInputs = {};
+        renderInputs.ActiveChild = activeChild;
+        renderInputs.Position = animation.GetCurrentPosition();
+        renderInputs.IsAnimating = animation.IsAnimating();
+        renderInputs.TileRefreshDivisor = overviewMode ? frameBudget.GetCurrentLevel().TileRefreshDivisor : 1;
+        renderInputs.SettingsVersion = settingsVersion;
+
+        if (renderCommands.NeedsRecording(renderInputs))
+        {
+            UpdateLayout();
+            renderCommands.Record(compositeLayout, renderInputs, overviewOutlineColor.ptr);
+            pendingStatistics.RenderCommandRecordCount++;
+        }
+
+        // Only normal mode slides the children, overview mode's animation just moves the outline
+        HydraCore::SlideReport slideReport;
+        if (motionQuality.Update(animation.IsAnimating() && !overviewMode, motionQualityEnabled && motionScalePercent < 100, slideReport))
+        {
+            LogSlideReport(slideReport);
+        }
+
+        if (motionQuality.IsReduced())
+        {
+            pendingStatistics.ReducedSlideFrameCount++;
+        }
+
+        // The cursor is sampled once per frame like everything else the composite depends on
+        if (showCursor)
+        {
+            cursorOverlay.Update();
+        }
+
+        tickIndex++;
+        if (!adaptiveQualityEnabled && frameBudget.GetLevel() > 0)
+        {
+            frameBudget.Reset();
+            LogQualityLevel("Restored", "adaptive quality was turned off");
+        }
+
+        // Captures created since the last tick are picked up here, after which the per-frame loops don't need their MonitorSource
+        for (size_t i = 0; i < childStates.size(); i++)
+        {
+            if (childStates[i].Source == nullptr)
+            {
+                childStates[i].Source = monitorSources[i].GetSource();
+            }
+        }
+
+        UpdateWarmChildren();
+
+        // Child sizes are only checked once per frame, not every time we're rendered
+        for (uint32_t child : enabledChildIndices)
+        {
+            UpdateChildTransform(childStates[child]);
+        }
+
+        if (!firstFrameLogged && childStates[activeChild].Transform.IsValid)
+        {
+            firstFrameLogged = true;
+            blog(LOG_INFO, "[obs-hydra] '%s' showed its first frame of %s %.1f ms after being created.", obs_source_get_name(source), childMonitors[activeChild].GetDescription().c_str(), (double)(HydraCore::GetTimestamp() - createdTimestamp) / 1'000'000.0);
+        }
+
+        pendingStatistics.FrameCount++;
+        pendingStatistics.CpuNanoseconds += HydraCore::GetTimestamp() - startTime;
+        PublishStatistics(frameTime);
+        profile_end(VideoTickProfilerName);
     }
 
     void EnumSources(obs_source_enum_proc_t enumCallback, void* param, bool activeOnly)
@@ -499,20 +2004,34 @@ private:
 #if false // For some reason this isn't working as expected. I think it's OBS's fault.
         if (activeOnly && !overviewMode && !animation.IsAnimating())
         {
-            enumCallback(source, activeMonitor->GetSource(), param);
+            enumCallback(source, monitorSources[activeChild].GetSource(), param);
             return;
         }
 #endif
 
-        for (MonitorSource* monitorSource : monitorSources)
+        for (size_t i = 0; i < monitorSources.size(); i++)
         {
             // Skip disabled monitors
-            if (activeOnly && !monitorSource->IsEnabled())
+            MonitorSource& monitorSource = monitorSources[i];
+            if (activeOnly && !enabledChildren[i])
+            {
+                continue;
+            }
+
+            // Skip monitors which haven't been created yet
+            obs_source_t* childSource = monitorSource.GetSource();
+            if (childSource == nullptr)
+            {
+                continue;
+            }
+
+            // Parked captures were removed from our active children, so they must not be activated along with us either
+            if (activeOnly && monitorSource.IsParked())
             {
                 continue;
             }
 
-            enumCallback(source, monitorSource->GetSource(), param);
+            enumCallback(source, childSource, param);
         }
     }
 
@@ -540,17 +2059,18 @@ public:
             //  However, from what I can find: All this really does (as of OBS 21.1.2) is enable audio.
             //  I imagine this functionality could be extended in the future (like actually allowing child sources) but for now I'm leaving it off.
             // Properties
-            ->WithGetDefaults(&GetDefaults)
-            ->WithGetProperties(&GetProperties)
-            ->WithUpdate(&Update)
+            ->WithGetDefaults(&ActiveMonitorSource::GetDefaults)
+            ->WithGetProperties(&ActiveMonitorSource::GetProperties)
+            ->WithUpdate(&ActiveMonitorSource::Update)
+            ->WithSave(&ActiveMonitorSource::Save)
             // Rendering
-            ->WithGetWidth(&GetWidth)
-            ->WithGetHeight(&GetHeight)
-            ->WithVideoRender(&VideoRender)
-            ->WithVideoTick(&VideoTick)
+            ->WithGetWidth(&ActiveMonitorSource::GetWidth)
+            ->WithGetHeight(&ActiveMonitorSource::GetHeight)
+            ->WithVideoRender(&ActiveMonitorSource::VideoRender)
+            ->WithVideoTick(&ActiveMonitorSource::VideoTick)
             // Source enumeration
-            ->WithEnumActiveSources(&EnumActiveSources)
-            ->WithEnumAllSources(&EnumAllSources)
+            ->WithEnumActiveSources(&ActiveMonitorSource::EnumActiveSources)
+            ->WithEnumAllSources(&ActiveMonitorSource::EnumAllSources)
             // Register
             ->Register();
     }
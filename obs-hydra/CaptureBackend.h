@@ -0,0 +1,38 @@
+/*---------------------------------------------------------------------
+Copyright (C) 2018  David Maas
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+---------------------------------------------------------------------*/
+#pragma once
+#include <Monitor.h>
+#include <obs.h>
+
+// Describes how to capture a single monitor using one of the capture sources built into OBS for the current platform
+class CaptureBackend
+{
+public:
+    // The ID of the source type which captures a monitor
+    virtual const char* GetSourceId() = 0;
+
+    // Fills in the settings of a new child source so that it captures the given monitor, without the cursor
+    virtual void InitializeSettings(obs_data_t* settings, HydraCore::Monitor& monitor) = 0;
+
+    virtual ~CaptureBackend()
+    {
+    }
+
+    // Implemented by the platform's backend (CaptureBackendWin32.cpp or CaptureBackendX11.cpp)
+    static CaptureBackend* GetInstance();
+};
@@ -0,0 +1,66 @@
+/*---------------------------------------------------------------------
+Copyright (C) 2018  David Maas
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+---------------------------------------------------------------------*/
+#include "CaptureBackend.h"
+
+// These correspond to the properties used by plugins\win-capture\duplicator-monitor-capture.c
+#define MONITOR_CAPTURE_SOURCE_ID "monitor_capture"
+#define MONITOR_CAPTURE_MONITOR_ID_LEGACY_PROPERTY "monitor"
+#define MONITOR_CAPTURE_MONITOR_ID_PROPERTY "monitor_id"
+#define MONITOR_CAPTURE_METHOD_PROPERTY "method"
+#define MONITOR_CAPTURE_CURSOR_PROPERTY "capture_cursor"
+#define MONITOR_CAPTURE_FORCE_SDR_PROPERTY "force_sdr"
+
+enum monitor_capture_method
+{
+    MONITOR_CAPTURE_METHOD_AUTO,
+    MONITOR_CAPTURE_METHOD_DXGI,
+    MONITOR_CAPTURE_METHOD_WGC,
+};
+
+class MonitorCaptureBackend : public CaptureBackend
+{
+public:
+    const char* GetSourceId() override
+    {
+        return MONITOR_CAPTURE_SOURCE_ID;
+    }
+
+    void InitializeSettings(obs_data_t* settings, HydraCore::Monitor& monitor) override
+    {
+        // https://github.com/obsproject/obs-studio/pull/7049 changed the monitor ID from using the monitor index to the monitor's DeviceID
+        if ((obs_get_version() >> 24) < 29)
+        {
+            obs_data_set_int(settings, MONITOR_CAPTURE_MONITOR_ID_LEGACY_PROPERTY, monitor.GetId());
+        }
+        else
+        {
+            obs_data_set_string(settings, MONITOR_CAPTURE_MONITOR_ID_PROPERTY, monitor.GetInterfaceId().c_str());
+        }
+
+        obs_data_set_int(settings, MONITOR_CAPTURE_METHOD_PROPERTY, MONITOR_CAPTURE_METHOD_DXGI);
+        // ActiveMonitorSource draws the cursor itself
+        obs_data_set_bool(settings, MONITOR_CAPTURE_CURSOR_PROPERTY, false);
+        obs_data_set_bool(settings, MONITOR_CAPTURE_FORCE_SDR_PROPERTY, true); //TODO: Investigate adding HDR support
+    }
+};
+
+CaptureBackend* CaptureBackend::GetInstance()
+{
+    static MonitorCaptureBackend instance;
+    return &instance;
+}
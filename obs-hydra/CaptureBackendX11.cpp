@@ -0,0 +1,51 @@
+/*---------------------------------------------------------------------
+Copyright (C) 2018  David Maas
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+---------------------------------------------------------------------*/
+#include "CaptureBackend.h"
+
+// These correspond to the properties used by plugins/linux-capture/xshm-input.c
+#define XSHM_INPUT_SOURCE_ID "xshm_input"
+#define XSHM_INPUT_SCREEN_PROPERTY "screen"
+#define XSHM_INPUT_CURSOR_PROPERTY "show_cursor"
+#define XSHM_INPUT_ADVANCED_PROPERTY "advanced"
+
+// xshm_input copies each frame out of a shared memory segment (MIT-SHM), so frames don't travel over the X connection
+// GetAllMonitorsX11 numbers monitors by their RandR CRTC index, which is what xshm_input's screen setting indexes, so the monitor ID is the screen index.
+class XshmCaptureBackend : public CaptureBackend
+{
+public:
+    const char* GetSourceId() override
+    {
+        return XSHM_INPUT_SOURCE_ID;
+    }
+
+    void InitializeSettings(obs_data_t* settings, HydraCore::Monitor& monitor) override
+    {
+        obs_data_set_int(settings, XSHM_INPUT_SCREEN_PROPERTY, monitor.GetId());
+        // ActiveMonitorSource draws the cursor itself
+        obs_data_set_bool(settings, XSHM_INPUT_CURSOR_PROPERTY, false);
+
+        // The advanced settings select a different X server, we always capture the one OBS is running on
+        obs_data_set_bool(settings, XSHM_INPUT_ADVANCED_PROPERTY, false);
+    }
+};
+
+CaptureBackend* CaptureBackend::GetInstance()
+{
+    static XshmCaptureBackend instance;
+    return &instance;
+}
@@ -0,0 +1,113 @@
+/*---------------------------------------------------------------------
+Copyright (C) 2018  David Maas
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+---------------------------------------------------------------------*/
+#pragma once
+#include <obs.h>
+
+struct GpuTimeStatistics
+{
+    uint64_t SampleCount;
+    double TotalMilliseconds;
+
+    inline void Add(double milliseconds)
+    {
+        SampleCount++;
+        TotalMilliseconds += milliseconds;
+    }
+
+    inline double GetAverageMilliseconds()
+    {
+        return SampleCount == 0 ? 0.0 : TotalMilliseconds / (double)SampleCount;
+    }
+};
+
+// Measures how much GPU time a block of rendering takes using timestamp queries
+// Results come back a few frames late, so only one measurement is in flight at a time and Begin returns false while we're waiting on it.
+// Everything other than the destructor must be called from the graphics thread.
+class GpuTimer
+{
+private:
+    gs_timer_range_t* range;
+    gs_timer_t* timer;
+    bool isInFlight;
+public:
+    GpuTimer()
+    {
+        range = nullptr;
+        timer = nullptr;
+        isInFlight = false;
+    }
+
+    bool Begin()
+    {
+        if (isInFlight)
+        { return false; }
+
+        if (timer == nullptr)
+        {
+            range = gs_timer_range_create();
+            timer = gs_timer_create();
+        }
+
+        if (range == nullptr || timer == nullptr)
+        { return false; }
+
+        gs_timer_range_begin(range);
+        gs_timer_begin(timer);
+        return true;
+    }
+
+    void End()
+    {
+        gs_timer_end(timer);
+        gs_timer_range_end(range);
+        isInFlight = true;
+    }
+
+    // Returns true once the in-flight measurement is available
+    bool Poll(double* milliseconds)
+    {
+        if (!isInFlight)
+        { return false; }
+
+        bool disjoint;
+        uint64_t frequency;
+        uint64_t ticks;
+        if (!gs_timer_range_get_data(range, &disjoint, &frequency) || !gs_timer_get_data(timer, &ticks))
+        { return false; }
+
+        isInFlight = false;
+
+        // Measurements are meaningless if the GPU's clock changed in the middle of them
+        if (disjoint || frequency == 0)
+        { return false; }
+
+        *milliseconds = (double)ticks * 1000.0 / (double)frequency;
+        return true;
+    }
+
+    ~GpuTimer()
+    {
+        if (range == nullptr && timer == nullptr)
+        { return; }
+
+        obs_enter_graphics();
+        gs_timer_destroy(timer);
+        gs_timer_range_destroy(range);
+        obs_leave_graphics();
+    }
+};
@@ -0,0 +1,390 @@
+/*---------------------------------------------------------------------
+Copyright (C) 2018  David Maas
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+---------------------------------------------------------------------*/
+#pragma once
+#include <CompositeLayout.h>
+#include <obs.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+// Holds a copy of every overview tile in one texture so the whole overview (outline included) is drawn with a single draw call.
+// The vertex buffer for that draw is only rebuilt when the layout changes, and a slot keeps its contents until it is redrawn,
+// so a tile which wasn't redrawn this frame (IE: one throttled by the frame budget) costs nothing extra to show.
+// A tile which is redrawn every frame costs the same one draw it would cost drawn directly, plus a clear when it doesn't cover its whole slot.
+// Everything other than the destructor must be called from the graphics thread.
+class OverviewAtlas
+{
+private:
+    // Slots are laid out in a grid rather than a row like the overview itself so large video walls stay within the maximum texture size
+    // They're separated by a gutter so the overview can be scaled down without neighbouring slots bleeding into each other.
+    static const uint32_t Gutter = 2;
+    // The outline is drawn from a patch of its color below the slots
+    static const uint32_t ColorPatchSize = 8;
+
+    gs_texture_t* texture;
+    // Set once Prepare has tried to create the texture for the current size, so a size the GPU can't handle isn't retried every frame
+    bool isPrepared;
+    uint32_t slotCount;
+    uint32_t tileWidth;
+    uint32_t tileHeight;
+    uint32_t columnCount;
+    uint32_t textureWidth;
+    uint32_t textureHeight;
+    std::vector<uint8_t> filledSlots;
+    vec4 patchColor;
+    bool isPatchFilled;
+
+    gs_vertbuffer_t* vertexBuffer;
+    uint32_t vertexCapacity;
+    uint32_t vertexCount;
+    // What the vertex buffer was last built from
+    std::vector<HydraCore::CompositeTile> quadTiles;
+    std::vector<uint32_t> quadSlots;
+    HydraCore::CompositeOutline quadOutline;
+    bool isQuadOutlineVisible;
+    bool areQuadsDirty;
+
+    // The render target which was bound before BeginSlot
+    // Render targets only have a color space from OBS 28 on, before that everything is sRGB.
+    gs_texture_t* previousTarget;
+    gs_zstencil_t* previousZstencil;
+#if LIBOBS_API_MAJOR_VER >= 28
+    gs_color_space previousColorSpace;
+#endif
+
+    void GetSlotOrigin(uint32_t slot, uint32_t& x, uint32_t& y)
+    {
+        x = (slot % columnCount) * (tileWidth + Gutter);
+        y = (slot / columnCount) * (tileHeight + Gutter);
+    }
+
+    // Redirects rendering to the given area of the atlas with a top-left origin
+    void BeginRegion(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        previousTarget = gs_get_render_target();
+        previousZstencil = gs_get_zstencil_target();
+#if LIBOBS_API_MAJOR_VER >= 28
+        previousColorSpace = gs_get_color_space();
+#endif
+
+        gs_viewport_push();
+        gs_projection_push();
+        gs_matrix_push();
+        gs_matrix_identity();
+
+        gs_set_render_target(texture, nullptr);
+        gs_set_viewport((int)x, (int)y, (int)width, (int)height);
+        gs_ortho(0.f, (float)width, 0.f, (float)height, -100.f, 100.f);
+        gs_blend_state_push();
+        gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+    }
+
+    void EndRegion()
+    {
+        gs_blend_state_pop();
+#if LIBOBS_API_MAJOR_VER >= 28
+        gs_set_render_target_with_color_space(previousTarget, previousZstencil, previousColorSpace);
+#else
+        gs_set_render_target(previousTarget, previousZstencil);
+#endif
+        gs_matrix_pop();
+        gs_projection_pop();
+        gs_viewport_pop();
+    }
+
+    // gs_clear would clear the whole atlas, so regions are filled with a sprite instead
+    void FillRegion(const vec4& color, uint32_t width, uint32_t height)
+    {
+        gs_effect_t* solidEffect = obs_get_base_effect(OBS_EFFECT_SOLID);
+        gs_effect_set_vec4(gs_effect_get_param_by_name(solidEffect, "color"), &color);
+
+        while (gs_effect_loop(solidEffect, "Solid"))
+        {
+            gs_draw_sprite(nullptr, 0, width, height);
+        }
+    }
+
+    void AddQuad(gs_vb_data* data, uint32_t& vertex, float x, float y, float width, float height, float u0, float v0, float u1, float v1)
+    {
+        // Two triangles, matching the winding OBS uses for sprites
+        const float positions[6][2] = { { x, y }, { x + width, y }, { x, y + height }, { x + width, y }, { x + width, y + height }, { x, y + height } };
+        const float coordinates[6][2] = { { u0, v0 }, { u1, v0 }, { u0, v1 }, { u1, v0 }, { u1, v1 }, { u0, v1 } };
+        vec2* uvs = (vec2*)data->tvarray[0].array;
+
+        for (int i = 0; i < 6; i++, vertex++)
+        {
+            vec3_set(&data->points[vertex], positions[i][0], positions[i][1], 0.f);
+            vec2_set(&uvs[vertex], coordinates[i][0], coordinates[i][1]);
+        }
+    }
+
+    bool QuadsMatch(const HydraCore::CompositeLayout& layout, const std::vector<uint32_t>& childSlots)
+    {
+        const std::vector<HydraCore::CompositeTile>& tiles = layout.GetTiles();
+        if (areQuadsDirty || tiles.size() != quadTiles.size() || layout.IsOutlineVisible() != isQuadOutlineVisible)
+        { return false; }
+
+        for (size_t i = 0; i < tiles.size(); i++)
+        {
+            if (tiles[i].Child != quadTiles[i].Child || tiles[i].X != quadTiles[i].X || tiles[i].Y != quadTiles[i].Y || childSlots[tiles[i].Child] != quadSlots[i])
+            { return false; }
+        }
+
+        return !isQuadOutlineVisible || memcmp(&layout.GetOutline(), &quadOutline, sizeof(quadOutline)) == 0;
+    }
+public:
+    OverviewAtlas()
+    {
+        texture = nullptr;
+        isPrepared = false;
+        slotCount = 0;
+        tileWidth = 0;
+        tileHeight = 0;
+        columnCount = 0;
+        textureWidth = 0;
+        textureHeight = 0;
+        vec4_zero(&patchColor);
+        isPatchFilled = false;
+
+        vertexBuffer = nullptr;
+        vertexCapacity = 0;
+        vertexCount = 0;
+        quadOutline = {};
+        isQuadOutlineVisible = false;
+        areQuadsDirty = true;
+
+        previousTarget = nullptr;
+        previousZstencil = nullptr;
+#if LIBOBS_API_MAJOR_VER >= 28
+        previousColorSpace = GS_CS_SRGB;
+#endif
+    }
+
+    // Makes room for slotCount tiles of the given size, every slot is empty again if the atlas had to be recreated
+    // Returns false if the texture couldn't be created (IE: it would be larger than the GPU supports.)
+    bool Prepare(uint32_t slotCount, uint32_t tileWidth, uint32_t tileHeight)
+    {
+        if (isPrepared && slotCount == this->slotCount && tileWidth == this->tileWidth && tileHeight == this->tileHeight)
+        { return texture != nullptr; }
+
+        Release();
+        isPrepared = true;
+        this->slotCount = slotCount;
+        this->tileWidth = tileWidth;
+        this->tileHeight = tileHeight;
+
+        if (slotCount == 0 || tileWidth == 0 || tileHeight == 0)
+        { return false; }
+
+        columnCount = 1;
+        while (columnCount * columnCount < slotCount)
+        {
+            columnCount++;
+        }
+
+        uint32_t rowCount = (slotCount + columnCount - 1) / columnCount;
+        textureWidth = columnCount * (tileWidth + Gutter);
+        textureHeight = rowCount * (tileHeight + Gutter) + ColorPatchSize;
+        texture = gs_texture_create(textureWidth, textureHeight, GS_RGBA, 1, nullptr, GS_RENDER_TARGET);
+        filledSlots.assign(slotCount, false);
+        return texture != nullptr;
+    }
+
+    bool IsSlotFilled(uint32_t slot)
+    {
+        return slot < filledSlots.size() && filledSlots[slot];
+    }
+
+    // True once UpdateQuads has built the vertex buffer, Draw can't fail after this
+    bool IsDrawable()
+    {
+        return texture != nullptr && vertexBuffer != nullptr;
+    }
+
+    // Redirects rendering into the slot, which is cleared to transparent first unless the caller is about to overwrite all of it
+    // Like a texrender, the caller draws at the top-left of a tile-sized area with blending replaced by a copy.
+    bool BeginSlot(uint32_t slot, bool clear)
+    {
+        if (texture == nullptr || slot >= slotCount)
+        { return false; }
+
+        uint32_t x;
+        uint32_t y;
+        GetSlotOrigin(slot, x, y);
+        BeginRegion(x, y, tileWidth, tileHeight);
+
+        if (clear)
+        {
+            vec4 clearColor;
+            vec4_zero(&clearColor);
+            FillRegion(clearColor, tileWidth, tileHeight);
+        }
+
+        filledSlots[slot] = true;
+        return true;
+    }
+
+    void EndSlot()
+    {
+        EndRegion();
+    }
+
+    void SetOutlineColor(const vec4& color)
+    {
+        if (texture == nullptr || (isPatchFilled && memcmp(&color, &patchColor, sizeof(color)) == 0))
+        { return; }
+
+        patchColor = color;
+        isPatchFilled = true;
+
+        // The atlas is drawn as premultiplied alpha
+        vec4 premultiplied;
+        vec4_set(&premultiplied, color.x * color.w, color.y * color.w, color.z * color.w, color.w);
+        BeginRegion(0, textureHeight - ColorPatchSize, ColorPatchSize, ColorPatchSize);
+        FillRegion(premultiplied, ColorPatchSize, ColorPatchSize);
+        EndRegion();
+    }
+
+    // childSlots maps each child given to the layout to its slot
+    void UpdateQuads(const HydraCore::CompositeLayout& layout, const std::vector<uint32_t>& childSlots)
+    {
+        if (texture == nullptr || QuadsMatch(layout, childSlots))
+        { return; }
+
+        const std::vector<HydraCore::CompositeTile>& tiles = layout.GetTiles();
+        quadTiles = tiles;
+        quadSlots.clear();
+        for (const HydraCore::CompositeTile& tile : tiles)
+        {
+            quadSlots.push_back(childSlots[tile.Child]);
+        }
+
+        isQuadOutlineVisible = layout.IsOutlineVisible();
+        quadOutline = layout.GetOutline();
+        areQuadsDirty = false;
+
+        vertexCount = (uint32_t)(tiles.size() + (isQuadOutlineVisible ? 4 : 0)) * 6;
+        if (vertexCount > vertexCapacity)
+        {
+            gs_vertexbuffer_destroy(vertexBuffer);
+            vertexCapacity = vertexCount;
+
+            gs_vb_data* data = gs_vbdata_create();
+            data->num = vertexCapacity;
+            data->points = (vec3*)bzalloc(sizeof(vec3) * vertexCapacity);
+            data->num_tex = 1;
+            data->tvarray = (gs_tvertarray*)bzalloc(sizeof(gs_tvertarray));
+            data->tvarray[0].width = 2;
+            data->tvarray[0].array = bzalloc(sizeof(vec2) * vertexCapacity);
+            vertexBuffer = gs_vertexbuffer_create(data, GS_DYNAMIC);
+        }
+
+        if (vertexBuffer == nullptr)
+        { return; }
+
+        gs_vb_data* data = gs_vertexbuffer_get_data(vertexBuffer);
+        uint32_t vertex = 0;
+        float textureWidthInverse = 1.f / (float)textureWidth;
+        float textureHeightInverse = 1.f / (float)textureHeight;
+
+        for (size_t i = 0; i < quadTiles.size(); i++)
+        {
+            uint32_t slotX;
+            uint32_t slotY;
+            GetSlotOrigin(quadSlots[i], slotX, slotY);
+            AddQuad
+            (
+                data, vertex, quadTiles[i].X, quadTiles[i].Y, (float)tileWidth, (float)tileHeight,
+                (float)slotX * textureWidthInverse, (float)slotY * textureHeightInverse, (float)(slotX + tileWidth) * textureWidthInverse, (float)(slotY + tileHeight) * textureHeightInverse
+            );
+        }
+
+        if (isQuadOutlineVisible)
+        {
+            // Every corner samples the middle of the color patch, so the bars come out as a flat color
+            float u = (float)(ColorPatchSize / 2) * textureWidthInverse;
+            float v = (float)(textureHeight - ColorPatchSize / 2) * textureHeightInverse;
+            const HydraCore::CompositeOutline& outline = quadOutline;
+            float thickness = (float)outline.Thickness;
+
+            AddQuad(data, vertex, outline.X, outline.Y, (float)outline.Width, thickness, u, v, u, v);
+            AddQuad(data, vertex, outline.X, outline.Y, thickness, (float)outline.Height, u, v, u, v);
+            AddQuad(data, vertex, outline.X + (float)outline.Width - thickness, outline.Y, thickness, (float)outline.Height, u, v, u, v);
+            AddQuad(data, vertex, outline.X, outline.Y + (float)outline.Height - thickness, (float)outline.Width, thickness, u, v, u, v);
+        }
+
+        gs_vertexbuffer_flush(vertexBuffer);
+    }
+
+    // Draws every tile and the outline, returns false if there was nothing to draw from
+    bool Draw()
+    {
+        if (!IsDrawable())
+        { return false; }
+
+        gs_effect_t* defaultEffect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+        bool previousSrgb = gs_framebuffer_srgb_enabled();
+        gs_enable_framebuffer_srgb(true);
+        gs_effect_set_texture_srgb(gs_effect_get_param_by_name(defaultEffect, "image"), texture);
+
+        gs_blend_state_push();
+        gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+
+        gs_load_vertexbuffer(vertexBuffer);
+        gs_load_indexbuffer(nullptr);
+        while (gs_effect_loop(defaultEffect, "Draw"))
+        {
+            gs_draw(GS_TRIS, 0, vertexCount);
+        }
+        gs_load_vertexbuffer(nullptr);
+
+        gs_blend_state_pop();
+        gs_enable_framebuffer_srgb(previousSrgb);
+        return true;
+    }
+
+    uint64_t GetTextureMemory()
+    {
+        return texture == nullptr ? 0 : (uint64_t)textureWidth * textureHeight * 4;
+    }
+
+    // Frees the texture and vertex buffer, must be called from the graphics thread
+    void Release()
+    {
+        gs_texture_destroy(texture);
+        gs_vertexbuffer_destroy(vertexBuffer);
+        texture = nullptr;
+        isPrepared = false;
+        vertexBuffer = nullptr;
+        vertexCapacity = 0;
+        vertexCount = 0;
+        filledSlots.clear();
+        isPatchFilled = false;
+        areQuadsDirty = true;
+    }
+
+    ~OverviewAtlas()
+    {
+        if (texture == nullptr && vertexBuffer == nullptr)
+        { return; }
+
+        obs_enter_graphics();
+        Release();
+        obs_leave_graphics();
+    }
+};
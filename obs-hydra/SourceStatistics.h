@@ -0,0 +1,126 @@
+/*---------------------------------------------------------------------
+Copyright (C) 2018  David Maas
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+---------------------------------------------------------------------*/
+#pragma once
+#include "GpuTimer.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+// Per-frame cost of an active monitor source, accumulated on the graphics thread over a window of frames
+struct SourceStatistics
+{
+    uint64_t FrameCount;
+    uint64_t CpuNanoseconds;
+    uint64_t ChildRenderCount;
+    // Only some child draws are timed since each child has one timer query in flight at a time
+    GpuTimeStatistics ChildGpuTime;
+    // Renders which drew the composite cached earlier in the same frame, and ones which had to compose it (only counted while the cache is in use)
+    uint64_t CompositeCacheHitCount;
+    uint64_t CompositeCacheMissCount;
+    // Overview tiles which showed their last drawing because the frame budget lowered how often they're redrawn
+    uint64_t SkippedTileRefreshCount;
+    // Draw calls for the overview's tiles and outline (the children's own draws aren't included)
+    uint64_t OverviewDrawCount;
+    // Frames of slides drawn at reduced resolution, and the GPU time that's estimated to have saved (see MotionQualityTracker)
+    uint64_t ReducedSlideFrameCount;
+    double SlideGpuSavedMilliseconds;
+    // Cursor sprites drawn over the composite (one per tile the cursor is over), and how often its image had to be uploaded
+    uint64_t CursorDrawCount;
+    uint64_t CursorUploadCount;
+    // Frames where the composite's draws had to be recorded again, they were replayed on every other frame
+    uint64_t RenderCommandRecordCount;
+    // These are gauges rather than counters, so they reflect the end of the window
+    uint32_t ActiveCaptureCount;
+    uint64_t EstimatedTextureMemory;
+    uint32_t QualityLevel;
+    // Captures stopped because the frame budget didn't leave room for them
+    uint32_t ParkedCaptureCount;
+
+    void Accumulate(const SourceStatistics& other)
+    {
+        FrameCount += other.FrameCount;
+        CpuNanoseconds += other.CpuNanoseconds;
+        ChildRenderCount += other.ChildRenderCount;
+        ChildGpuTime.SampleCount += other.ChildGpuTime.SampleCount;
+        ChildGpuTime.TotalMilliseconds += other.ChildGpuTime.TotalMilliseconds;
+        CompositeCacheHitCount += other.CompositeCacheHitCount;
+        CompositeCacheMissCount += other.CompositeCacheMissCount;
+        SkippedTileRefreshCount += other.SkippedTileRefreshCount;
+        OverviewDrawCount += other.OverviewDrawCount;
+        ReducedSlideFrameCount += other.ReducedSlideFrameCount;
+        SlideGpuSavedMilliseconds += other.SlideGpuSavedMilliseconds;
+        CursorDrawCount += other.CursorDrawCount;
+        CursorUploadCount += other.CursorUploadCount;
+        RenderCommandRecordCount += other.RenderCommandRecordCount;
+        ActiveCaptureCount = other.ActiveCaptureCount;
+        EstimatedTextureMemory = other.EstimatedTextureMemory;
+        QualityLevel = other.QualityLevel;
+        ParkedCaptureCount = other.ParkedCaptureCount;
+    }
+
+    double GetCpuMillisecondsPerFrame()
+    {
+        return FrameCount == 0 ? 0.0 : (double)CpuNanoseconds / (double)FrameCount / 1'000'000.0;
+    }
+
+    double GetOverviewDrawsPerFrame()
+    {
+        return FrameCount == 0 ? 0.0 : (double)OverviewDrawCount / (double)FrameCount;
+    }
+
+    double GetCursorDrawsPerFrame()
+    {
+        return FrameCount == 0 ? 0.0 : (double)CursorDrawCount / (double)FrameCount;
+    }
+
+    double GetChildrenRenderedPerFrame()
+    {
+        return FrameCount == 0 ? 0.0 : (double)ChildRenderCount / (double)FrameCount;
+    }
+
+    // Estimated from the average timed draw since not every draw is timed
+    double GetGpuMillisecondsPerFrame()
+    {
+        return ChildGpuTime.GetAverageMilliseconds() * GetChildrenRenderedPerFrame();
+    }
+
+    std::string Format()
+    {
+        char gpuTime[64];
+        if (ChildGpuTime.SampleCount > 0)
+        {
+            snprintf(gpuTime, sizeof(gpuTime), "%.3f ms/frame", GetGpuMillisecondsPerFrame());
+        }
+        else
+        {
+            snprintf(gpuTime, sizeof(gpuTime), "not measured");
+        }
+
+        char ret[768];
+        snprintf
+        (
+            ret, sizeof(ret),
+            "CPU time: %.3f ms/frame\nGPU time: %s\nChildren rendered: %.2f/frame\nOverview draw calls: %.2f/frame\nDraws recorded on %llu frames\nComposite cache: %llu hits, %llu misses\n"
+            "Quality level: %u (%llu tile redraws skipped, %u captures stopped)\nReduced-resolution slide frames: %llu (about %.1f ms of GPU time saved)\nCursor draws: %.2f/frame (%llu image uploads)\nActive captures: %u\nEstimated texture memory: %.1f MiB",
+            GetCpuMillisecondsPerFrame(), gpuTime, GetChildrenRenderedPerFrame(), GetOverviewDrawsPerFrame(), (unsigned long long)RenderCommandRecordCount, (unsigned long long)CompositeCacheHitCount, (unsigned long long)CompositeCacheMissCount,
+            QualityLevel, (unsigned long long)SkippedTileRefreshCount, ParkedCaptureCount, (unsigned long long)ReducedSlideFrameCount, SlideGpuSavedMilliseconds, GetCursorDrawsPerFrame(), (unsigned long long)CursorUploadCount, ActiveCaptureCount, (double)EstimatedTextureMemory / (1024.0 * 1024.0)
+        );
+        return ret;
+    }
+};
@@ -17,12 +17,37 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 ---------------------------------------------------------------------*/
 #include "ActiveMonitorSource.h"
 
+#include <ActiveMonitorTracker.h>
+#include <DisplayPlatform.h>
+#include <exception>
 #include <obs-module.h>
+#include <TrackerFeed.h>
 
 OBS_DECLARE_MODULE()
 
+// Lets overlays and other tools follow the same active monitor as Hydra without hooking focus changes themselves
+static HydraCore::TrackerFeed* trackerFeed = nullptr;
+
 bool obs_module_load()
 {
     RegisterActiveMonitorSource();
+
+    // The feed is a convenience for other programs, so Hydra works without it (IE: when a second OBS instance is already publishing)
+    try
+    {
+        trackerFeed = new HydraCore::TrackerFeed(HydraCore::DisplayPlatform::GetCurrent(), HydraCore::ActiveMonitorTracker::GetInstance());
+        blog(LOG_INFO, "[obs-hydra] Publishing the active monitor to '%s' and shared memory '%s'", trackerFeed->GetSocketPath().c_str(), TRACKER_FEED_NAME);
+    }
+    catch (const std::exception& exception)
+    {
+        blog(LOG_WARNING, "[obs-hydra] Failed to start the tracker feed: %s", exception.what());
+    }
+
     return true;
 }
+
+void obs_module_unload()
+{
+    delete trackerFeed;
+    trackerFeed = nullptr;
+}